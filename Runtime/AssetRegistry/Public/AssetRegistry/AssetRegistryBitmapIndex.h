@@ -0,0 +1,652 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Algo/BinarySearch.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/ARFilter.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "Containers/UnrealString.h"
+#include "CoreTypes.h"
+#include "HAL/PlatformMath.h"
+#include "Math/VectorRegister.h"
+#include "Templates/Function.h"
+#include "UObject/NameTypes.h"
+#include "UObject/TopLevelAssetPath.h"
+
+namespace UE::AssetRegistry
+{
+
+/**
+ * Compressed bitmap of 32-bit indices in the style of Roaring bitmaps.
+ * Values are split into 65536-wide chunks by their high 16 bits. A chunk holding at most ArrayContainerMax values
+ * stores them as a sorted uint16 array; a denser chunk stores a 65536-bit bitset. Set operations pick the cheapest
+ * algorithm per pair of chunks, and bitset-bitset operations run four words at a time through VectorRegister4Int.
+ */
+class FCompressedBitmap
+{
+public:
+	static constexpr int32 ArrayContainerMax = 4096;
+	static constexpr int32 BitsetWords = 65536 / 64;
+
+	void Add(uint32 Value)
+	{
+		FContainer& Container = FindOrAddContainer(HighBits(Value));
+		const uint16 Low = LowBits(Value);
+		if (Container.IsBitset())
+		{
+			uint64& Word = Container.Words[Low >> 6];
+			const uint64 Bit = uint64(1) << (Low & 63);
+			Container.Cardinality += (Word & Bit) ? 0 : 1;
+			Word |= Bit;
+			return;
+		}
+
+		const int32 Position = Algo::LowerBound(Container.Values, Low);
+		if (Position < Container.Values.Num() && Container.Values[Position] == Low)
+		{
+			return;
+		}
+		Container.Values.Insert(Low, Position);
+		++Container.Cardinality;
+		if (Container.Cardinality > ArrayContainerMax)
+		{
+			Container.ConvertToBitset();
+		}
+	}
+
+	void Remove(uint32 Value)
+	{
+		const int32 ContainerIndex = FindContainer(HighBits(Value));
+		if (ContainerIndex == INDEX_NONE)
+		{
+			return;
+		}
+
+		FContainer& Container = Containers[ContainerIndex];
+		const uint16 Low = LowBits(Value);
+		if (Container.IsBitset())
+		{
+			uint64& Word = Container.Words[Low >> 6];
+			const uint64 Bit = uint64(1) << (Low & 63);
+			Container.Cardinality -= (Word & Bit) ? 1 : 0;
+			Word &= ~Bit;
+			if (Container.Cardinality <= ArrayContainerMax)
+			{
+				Container.ConvertToArray();
+			}
+		}
+		else
+		{
+			const int32 Position = Algo::BinarySearch(Container.Values, Low);
+			if (Position != INDEX_NONE)
+			{
+				Container.Values.RemoveAt(Position, EAllowShrinking::No);
+				--Container.Cardinality;
+			}
+		}
+
+		if (Container.Cardinality == 0)
+		{
+			Containers.RemoveAt(ContainerIndex, EAllowShrinking::No);
+		}
+	}
+
+	bool Contains(uint32 Value) const
+	{
+		const int32 ContainerIndex = FindContainer(HighBits(Value));
+		return ContainerIndex != INDEX_NONE && Containers[ContainerIndex].Contains(LowBits(Value));
+	}
+
+	int32 Num() const
+	{
+		int32 Result = 0;
+		for (const FContainer& Container : Containers)
+		{
+			Result += Container.Cardinality;
+		}
+		return Result;
+	}
+
+	bool IsEmpty() const
+	{
+		return Containers.IsEmpty();
+	}
+
+	void Reset()
+	{
+		Containers.Reset();
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Result = Containers.GetAllocatedSize();
+		for (const FContainer& Container : Containers)
+		{
+			Result += Container.Values.GetAllocatedSize() + Container.Words.GetAllocatedSize();
+		}
+		return Result;
+	}
+
+	/** Returns the values present in both A and B */
+	static FCompressedBitmap And(const FCompressedBitmap& A, const FCompressedBitmap& B)
+	{
+		FCompressedBitmap Result;
+		int32 IndexA = 0;
+		int32 IndexB = 0;
+		while (IndexA < A.Containers.Num() && IndexB < B.Containers.Num())
+		{
+			const FContainer& ContainerA = A.Containers[IndexA];
+			const FContainer& ContainerB = B.Containers[IndexB];
+			if (ContainerA.Key < ContainerB.Key)
+			{
+				++IndexA;
+			}
+			else if (ContainerB.Key < ContainerA.Key)
+			{
+				++IndexB;
+			}
+			else
+			{
+				FContainer Intersection = FContainer::And(ContainerA, ContainerB);
+				if (Intersection.Cardinality > 0)
+				{
+					Result.Containers.Add(MoveTemp(Intersection));
+				}
+				++IndexA;
+				++IndexB;
+			}
+		}
+		return Result;
+	}
+
+	/** Returns the values present in A or B */
+	static FCompressedBitmap Or(const FCompressedBitmap& A, const FCompressedBitmap& B)
+	{
+		FCompressedBitmap Result;
+		Result.Containers.Reserve(FMath::Max(A.Containers.Num(), B.Containers.Num()));
+		int32 IndexA = 0;
+		int32 IndexB = 0;
+		while (IndexA < A.Containers.Num() || IndexB < B.Containers.Num())
+		{
+			if (IndexB == B.Containers.Num() || (IndexA < A.Containers.Num() && A.Containers[IndexA].Key < B.Containers[IndexB].Key))
+			{
+				Result.Containers.Add(A.Containers[IndexA++]);
+			}
+			else if (IndexA == A.Containers.Num() || B.Containers[IndexB].Key < A.Containers[IndexA].Key)
+			{
+				Result.Containers.Add(B.Containers[IndexB++]);
+			}
+			else
+			{
+				Result.Containers.Add(FContainer::Or(A.Containers[IndexA++], B.Containers[IndexB++]));
+			}
+		}
+		return Result;
+	}
+
+	/** Iterates the values in ascending order */
+	class FConstIterator
+	{
+	public:
+		explicit FConstIterator(const FCompressedBitmap& InBitmap)
+			: Bitmap(InBitmap)
+		{
+			SettleOnValue();
+		}
+
+		explicit operator bool() const
+		{
+			return ContainerIndex < Bitmap.Containers.Num();
+		}
+
+		uint32 operator*() const
+		{
+			const FContainer& Container = Bitmap.Containers[ContainerIndex];
+			const uint32 Low = Container.IsBitset() ? (uint32)Position : (uint32)Container.Values[Position];
+			return (uint32(Container.Key) << 16) | Low;
+		}
+
+		FConstIterator& operator++()
+		{
+			++Position;
+			SettleOnValue();
+			return *this;
+		}
+
+	private:
+		/** Advances Position/ContainerIndex to the next set value at or after the current position */
+		void SettleOnValue()
+		{
+			for (; ContainerIndex < Bitmap.Containers.Num(); ++ContainerIndex, Position = 0)
+			{
+				const FContainer& Container = Bitmap.Containers[ContainerIndex];
+				if (!Container.IsBitset())
+				{
+					if (Position < Container.Values.Num())
+					{
+						return;
+					}
+					continue;
+				}
+
+				for (int32 WordIndex = Position >> 6; WordIndex < BitsetWords; ++WordIndex)
+				{
+					uint64 Word = Container.Words[WordIndex];
+					if (WordIndex == (Position >> 6))
+					{
+						Word &= ~uint64(0) << (Position & 63);
+					}
+					if (Word)
+					{
+						Position = (WordIndex << 6) + (int32)FPlatformMath::CountTrailingZeros64(Word);
+						return;
+					}
+				}
+			}
+		}
+
+		const FCompressedBitmap& Bitmap;
+		int32 ContainerIndex = 0;
+		int32 Position = 0;
+	};
+
+	FConstIterator CreateConstIterator() const
+	{
+		return FConstIterator(*this);
+	}
+
+private:
+	struct FContainer
+	{
+		uint16 Key = 0;
+		int32 Cardinality = 0;
+		/** Sorted low bits, used while Cardinality <= ArrayContainerMax */
+		TArray<uint16> Values;
+		/** BitsetWords words, used while Cardinality > ArrayContainerMax */
+		TArray<uint64> Words;
+
+		bool IsBitset() const
+		{
+			return !Words.IsEmpty();
+		}
+
+		bool Contains(uint16 Low) const
+		{
+			return IsBitset()
+				? (Words[Low >> 6] & (uint64(1) << (Low & 63))) != 0
+				: Algo::BinarySearch(Values, Low) != INDEX_NONE;
+		}
+
+		void ConvertToBitset()
+		{
+			Words.SetNumZeroed(BitsetWords);
+			for (uint16 Low : Values)
+			{
+				Words[Low >> 6] |= uint64(1) << (Low & 63);
+			}
+			Values.Empty();
+		}
+
+		void ConvertToArray()
+		{
+			Values.Reset(Cardinality);
+			for (int32 WordIndex = 0; WordIndex < BitsetWords; ++WordIndex)
+			{
+				for (uint64 Word = Words[WordIndex]; Word; Word &= Word - 1)
+				{
+					Values.Add((uint16)((WordIndex << 6) + (int32)FPlatformMath::CountTrailingZeros64(Word)));
+				}
+			}
+			Words.Empty();
+		}
+
+		static int32 CountWords(const uint64* Words)
+		{
+			int32 Count = 0;
+			for (int32 WordIndex = 0; WordIndex < BitsetWords; ++WordIndex)
+			{
+				Count += FPlatformMath::CountBits(Words[WordIndex]);
+			}
+			return Count;
+		}
+
+		static FContainer And(const FContainer& A, const FContainer& B)
+		{
+			FContainer Result;
+			Result.Key = A.Key;
+			if (A.IsBitset() && B.IsBitset())
+			{
+				Result.Words.SetNumUninitialized(BitsetWords);
+				for (int32 WordIndex = 0; WordIndex < BitsetWords; WordIndex += 2)
+				{
+					VectorIntStore(VectorIntAnd(VectorIntLoad(&A.Words[WordIndex]), VectorIntLoad(&B.Words[WordIndex])), &Result.Words[WordIndex]);
+				}
+				Result.Cardinality = CountWords(Result.Words.GetData());
+				if (Result.Cardinality <= ArrayContainerMax)
+				{
+					Result.ConvertToArray();
+				}
+			}
+			else if (A.IsBitset() || B.IsBitset())
+			{
+				const FContainer& Sparse = A.IsBitset() ? B : A;
+				const FContainer& Dense = A.IsBitset() ? A : B;
+				for (uint16 Low : Sparse.Values)
+				{
+					if (Dense.Contains(Low))
+					{
+						Result.Values.Add(Low);
+					}
+				}
+				Result.Cardinality = Result.Values.Num();
+			}
+			else
+			{
+				int32 IndexA = 0;
+				int32 IndexB = 0;
+				while (IndexA < A.Values.Num() && IndexB < B.Values.Num())
+				{
+					const uint16 ValueA = A.Values[IndexA];
+					const uint16 ValueB = B.Values[IndexB];
+					IndexA += ValueA <= ValueB ? 1 : 0;
+					IndexB += ValueB <= ValueA ? 1 : 0;
+					if (ValueA == ValueB)
+					{
+						Result.Values.Add(ValueA);
+					}
+				}
+				Result.Cardinality = Result.Values.Num();
+			}
+			return Result;
+		}
+
+		static FContainer Or(const FContainer& A, const FContainer& B)
+		{
+			FContainer Result;
+			Result.Key = A.Key;
+			if (A.IsBitset() || B.IsBitset() || A.Cardinality + B.Cardinality > ArrayContainerMax)
+			{
+				Result.Words.SetNumZeroed(BitsetWords);
+				for (const FContainer* Source : { &A, &B })
+				{
+					if (Source->IsBitset())
+					{
+						for (int32 WordIndex = 0; WordIndex < BitsetWords; WordIndex += 2)
+						{
+							VectorIntStore(VectorIntOr(VectorIntLoad(&Result.Words[WordIndex]), VectorIntLoad(&Source->Words[WordIndex])), &Result.Words[WordIndex]);
+						}
+					}
+					else
+					{
+						for (uint16 Low : Source->Values)
+						{
+							Result.Words[Low >> 6] |= uint64(1) << (Low & 63);
+						}
+					}
+				}
+				Result.Cardinality = CountWords(Result.Words.GetData());
+				if (Result.Cardinality <= ArrayContainerMax)
+				{
+					Result.ConvertToArray();
+				}
+			}
+			else
+			{
+				Result.Values.Reserve(A.Cardinality + B.Cardinality);
+				int32 IndexA = 0;
+				int32 IndexB = 0;
+				while (IndexA < A.Values.Num() || IndexB < B.Values.Num())
+				{
+					if (IndexB == B.Values.Num() || (IndexA < A.Values.Num() && A.Values[IndexA] < B.Values[IndexB]))
+					{
+						Result.Values.Add(A.Values[IndexA++]);
+					}
+					else if (IndexA == A.Values.Num() || B.Values[IndexB] < A.Values[IndexA])
+					{
+						Result.Values.Add(B.Values[IndexB++]);
+					}
+					else
+					{
+						Result.Values.Add(A.Values[IndexA++]);
+						++IndexB;
+					}
+				}
+				Result.Cardinality = Result.Values.Num();
+			}
+			return Result;
+		}
+	};
+
+	static uint16 HighBits(uint32 Value)
+	{
+		return (uint16)(Value >> 16);
+	}
+
+	static uint16 LowBits(uint32 Value)
+	{
+		return (uint16)(Value & 0xFFFF);
+	}
+
+	int32 FindContainer(uint16 Key) const
+	{
+		return Algo::BinarySearchBy(Containers, Key, &FContainer::Key);
+	}
+
+	FContainer& FindOrAddContainer(uint16 Key)
+	{
+		const int32 Position = Algo::LowerBoundBy(Containers, Key, &FContainer::Key);
+		if (Position == Containers.Num() || Containers[Position].Key != Key)
+		{
+			FContainer& Container = Containers.InsertDefaulted_GetRef(Position);
+			Container.Key = Key;
+		}
+		return Containers[Position];
+	}
+
+	/** Sorted by Key */
+	TArray<FContainer> Containers;
+};
+
+/**
+ * Bitmap indices over the assets of an FAssetRegistryState, used to evaluate FARCompiledFilter queries as unions and
+ * intersections of compressed bitmaps instead of building and filtering TSets.
+ *
+ * Assets are identified by a dense index assigned on AddAsset. Indices of removed assets are not reused, so the index
+ * is best suited to registries that are mostly built once, such as cooked registries and cook-time discovery.
+ */
+class FAssetRegistryBitmapIndex
+{
+public:
+	/** Result of EvaluateFilter */
+	struct FQueryResult
+	{
+		/** Indices of the assets that may pass the filter */
+		FCompressedBitmap Matches;
+		/**
+		 * True if every asset in Matches passes the filter. False if some components (object paths, package flags,
+		 * tag values without a value index) were not covered by bitmaps and must be tested on each match.
+		 */
+		bool bExact = true;
+	};
+
+	/**
+	 * Requests a value index for a tag key, so TagsAndValues queries with a value for that key are answered by a
+	 * bitmap instead of a per-asset test. Must be called before the assets are added.
+	 */
+	void IndexTagValues(FName TagKey)
+	{
+		TagKeysWithValueIndex.Add(TagKey);
+	}
+
+	uint32 AddAsset(const FAssetData& AssetData)
+	{
+		const uint32 AssetIndex = (uint32)Assets.Add(&AssetData);
+		AssetToIndex.Add(&AssetData, AssetIndex);
+		ForEachBitmap(AssetData, [AssetIndex](FCompressedBitmap& Bitmap) { Bitmap.Add(AssetIndex); });
+		return AssetIndex;
+	}
+
+	void RemoveAsset(const FAssetData& AssetData)
+	{
+		uint32 AssetIndex;
+		if (AssetToIndex.RemoveAndCopyValue(&AssetData, AssetIndex))
+		{
+			ForEachBitmap(AssetData, [AssetIndex](FCompressedBitmap& Bitmap) { Bitmap.Remove(AssetIndex); });
+			Assets[AssetIndex] = nullptr;
+		}
+	}
+
+	void Reset()
+	{
+		Assets.Reset();
+		AssetToIndex.Reset();
+		ByPackageName.Reset();
+		ByPackagePath.Reset();
+		ByClass.Reset();
+		ByTagKey.Reset();
+		ByTagValue.Reset();
+	}
+
+	const FAssetData* GetAsset(uint32 AssetIndex) const
+	{
+		return Assets.IsValidIndex(AssetIndex) ? Assets[AssetIndex] : nullptr;
+	}
+
+	/**
+	 * Compiles Filter into an AND over its components, each component being the OR of the bitmaps of its keys.
+	 * Recursive paths and classes are already expanded in FARCompiledFilter, so exact keys are enough.
+	 */
+	FQueryResult EvaluateFilter(const FARCompiledFilter& Filter) const
+	{
+		FQueryResult Result;
+		bool bHasComponent = false;
+		auto AndComponent = [&Result, &bHasComponent](const FCompressedBitmap& Component)
+		{
+			Result.Matches = bHasComponent ? FCompressedBitmap::And(Result.Matches, Component) : Component;
+			bHasComponent = true;
+		};
+
+		if (!Filter.PackageNames.IsEmpty())
+		{
+			AndComponent(UnionOf(ByPackageName, Filter.PackageNames));
+		}
+		if (!Filter.PackagePaths.IsEmpty())
+		{
+			AndComponent(UnionOf(ByPackagePath, Filter.PackagePaths));
+		}
+		if (!Filter.ClassPaths.IsEmpty())
+		{
+			AndComponent(UnionOf(ByClass, Filter.ClassPaths));
+		}
+		if (!Filter.TagsAndValues.IsEmpty())
+		{
+			FCompressedBitmap TagComponent;
+			for (const TPair<FName, TOptional<FString>>& TagAndValue : Filter.TagsAndValues)
+			{
+				const FCompressedBitmap* Bitmap = nullptr;
+				if (!TagAndValue.Value.IsSet())
+				{
+					Bitmap = ByTagKey.Find(TagAndValue.Key);
+				}
+				else if (TagKeysWithValueIndex.Contains(TagAndValue.Key))
+				{
+					Bitmap = ByTagValue.Find(TPair<FName, FString>(TagAndValue.Key, TagAndValue.Value.GetValue()));
+				}
+				else
+				{
+					Bitmap = ByTagKey.Find(TagAndValue.Key);
+					Result.bExact = false;
+				}
+
+				if (Bitmap)
+				{
+					TagComponent = FCompressedBitmap::Or(TagComponent, *Bitmap);
+				}
+			}
+			AndComponent(TagComponent);
+		}
+
+		if (!bHasComponent)
+		{
+			for (uint32 AssetIndex = 0; AssetIndex < (uint32)Assets.Num(); ++AssetIndex)
+			{
+				if (Assets[AssetIndex])
+				{
+					Result.Matches.Add(AssetIndex);
+				}
+			}
+		}
+
+		if (!Filter.SoftObjectPaths.IsEmpty() || Filter.WithPackageFlags != 0 || Filter.WithoutPackageFlags != 0)
+		{
+			Result.bExact = false;
+		}
+		return Result;
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Result = Assets.GetAllocatedSize() + AssetToIndex.GetAllocatedSize() + TagKeysWithValueIndex.GetAllocatedSize();
+		auto AddMapSize = [&Result](const auto& Map)
+		{
+			Result += Map.GetAllocatedSize();
+			for (const auto& Pair : Map)
+			{
+				Result += Pair.Value.GetAllocatedSize();
+			}
+		};
+		AddMapSize(ByPackageName);
+		AddMapSize(ByPackagePath);
+		AddMapSize(ByClass);
+		AddMapSize(ByTagKey);
+		AddMapSize(ByTagValue);
+		return Result;
+	}
+
+private:
+	template <typename Func>
+	void ForEachBitmap(const FAssetData& AssetData, Func&& Fn)
+	{
+		Fn(ByPackageName.FindOrAdd(AssetData.PackageName));
+		Fn(ByPackagePath.FindOrAdd(AssetData.PackagePath));
+		Fn(ByClass.FindOrAdd(AssetData.AssetClassPath));
+		AssetData.TagsAndValues.ForEach([this, &Fn](TPair<FName, FAssetTagValueRef> Pair)
+		{
+			Fn(ByTagKey.FindOrAdd(Pair.Key));
+			if (TagKeysWithValueIndex.Contains(Pair.Key))
+			{
+				Fn(ByTagValue.FindOrAdd(TPair<FName, FString>(Pair.Key, Pair.Value.AsString())));
+			}
+		});
+	}
+
+	template <typename KeyType, typename SetType>
+	static FCompressedBitmap UnionOf(const TMap<KeyType, FCompressedBitmap>& Map, const SetType& Keys)
+	{
+		FCompressedBitmap Result;
+		for (const KeyType& Key : Keys)
+		{
+			if (const FCompressedBitmap* Bitmap = Map.Find(Key))
+			{
+				Result = FCompressedBitmap::Or(Result, *Bitmap);
+			}
+		}
+		return Result;
+	}
+
+	TArray<const FAssetData*> Assets;
+	TMap<const FAssetData*, uint32> AssetToIndex;
+	TSet<FName> TagKeysWithValueIndex;
+
+	TMap<FName, FCompressedBitmap> ByPackageName;
+	TMap<FName, FCompressedBitmap> ByPackagePath;
+	TMap<FTopLevelAssetPath, FCompressedBitmap> ByClass;
+	TMap<FName, FCompressedBitmap> ByTagKey;
+	/** FString keys compare case-insensitively, matching FAssetDataTagMapSharedView::ContainsKeyValue */
+	TMap<TPair<FName, FString>, FCompressedBitmap> ByTagValue;
+};
+
+} // namespace UE::AssetRegistry
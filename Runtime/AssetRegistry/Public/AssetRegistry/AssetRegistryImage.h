@@ -0,0 +1,414 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+#include "AssetRegistry/ARFilter.h"
+#include "Async/MappedFileHandle.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/StringView.h"
+#include "CoreTypes.h"
+#include "Hash/xxhash.h"
+#include "HAL/PlatformFileManager.h"
+#include "Memory/MemoryView.h"
+#include "Misc/Char.h"
+#include "Misc/StringBuilder.h"
+#include "Templates/AlignmentTemplates.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+#include "UObject/NameTypes.h"
+#include "UObject/TopLevelAssetPath.h"
+
+/**
+ * Flat, memory-mappable image of a cooked asset registry.
+ *
+ * The regular registry format is deserialized into TMap-based lookup tables (CachedAssetsByClass and friends), which
+ * costs startup time and memory proportional to the number of assets. The image instead stores every lookup table as a
+ * sorted array of 64-bit key hashes pointing at sorted runs of asset indices, so it can be queried in place after
+ * mapping the file. Each asset's serialized FAssetData is kept as an opaque payload, so only the assets that survive a
+ * query need to be deserialized.
+ *
+ * Layout, all offsets relative to the start of the image and 8-byte aligned:
+ *   FRegistryImageHeader
+ *   FRegistryImageKey[NumKeys[Index]]         one table per ERegistryImageIndex, sorted by Hash
+ *   uint32[NumAssetIndices]                   pool of asset index runs referenced by the key tables, each run ascending
+ *   FRegistryImageAssetRecord[NumAssets]      fixed-size per-asset record, used to filter without materializing
+ *   uint8[PayloadSize]                        serialized FAssetData payloads and the name batch they reference
+ */
+namespace UE::AssetRegistry
+{
+
+enum class ERegistryImageIndex : uint8
+{
+	PackageName,
+	PackagePath,
+	Class,
+	TagKey,
+
+	Count
+};
+
+struct FRegistryImageHeader
+{
+	static constexpr uint32 ExpectedMagic = 0x494D4152; // 'RAMI'
+	static constexpr uint32 CurrentVersion = 1;
+
+	uint32 Magic = ExpectedMagic;
+	uint32 Version = CurrentVersion;
+	uint32 NumAssets = 0;
+	uint32 NumKeys[(uint8)ERegistryImageIndex::Count] = {};
+	uint64 KeyTableOffsets[(uint8)ERegistryImageIndex::Count] = {};
+	uint64 AssetIndexPoolOffset = 0;
+	uint64 NumAssetIndices = 0;
+	uint64 AssetRecordsOffset = 0;
+	uint64 PayloadOffset = 0;
+	uint64 PayloadSize = 0;
+};
+
+/** Entry of a key table: all assets whose key hashes to Hash, as a run in the asset index pool. */
+struct FRegistryImageKey
+{
+	uint64 Hash;
+	uint32 FirstIndex;
+	uint32 NumIndices;
+};
+
+/** Fixed-size per-asset data that filters can test without materializing the FAssetData. */
+struct FRegistryImageAssetRecord
+{
+	uint64 PackageNameHash;
+	uint64 PackagePathHash;
+	uint64 ClassHash;
+	/** Offset of the serialized FAssetData relative to the payload section */
+	uint64 PayloadOffset;
+	uint32 PayloadSize;
+	uint32 PackageFlags;
+};
+
+/**
+ * Read-only view over a registry image held in memory (usually a mapped file).
+ * Keys are hashed case-insensitively to match FName comparison. Queries return candidates by hash; callers that need
+ * exact results recheck the materialized FAssetData, which only costs anything on the rare 64-bit hash collision.
+ */
+class FRegistryImage
+{
+public:
+	FRegistryImage() = default;
+
+	/**
+	 * Validates the header and section bounds of Image. The memory must outlive this view.
+	 * Contents of the sections are validated as they are accessed, so corrupt data makes queries fail rather than crash.
+	 *
+	 * @return	False if the image is not a valid registry image
+	 */
+	bool Initialize(FMemoryView InImage)
+	{
+		Header = nullptr;
+		if (InImage.GetSize() < sizeof(FRegistryImageHeader) || !IsAligned(InImage.GetData(), alignof(FRegistryImageHeader)))
+		{
+			return false;
+		}
+
+		const FRegistryImageHeader* InHeader = static_cast<const FRegistryImageHeader*>(InImage.GetData());
+		if (InHeader->Magic != FRegistryImageHeader::ExpectedMagic || InHeader->Version != FRegistryImageHeader::CurrentVersion)
+		{
+			return false;
+		}
+
+		// Section sizes are also bounded by MAX_int32, so they fit in an array view
+		const uint64 ImageSize = InImage.GetSize();
+		auto IsSectionValid = [ImageSize](uint64 Offset, uint64 Num, uint64 ElementSize)
+		{
+			return Offset % 8 == 0 && Offset <= ImageSize && Num <= (ImageSize - Offset) / ElementSize && (ElementSize == 1 || Num <= (uint64)MAX_int32);
+		};
+		if (InHeader->NumAssets > (uint32)MAX_int32)
+		{
+			return false;
+		}
+		for (uint8 Index = 0; Index < (uint8)ERegistryImageIndex::Count; ++Index)
+		{
+			if (!IsSectionValid(InHeader->KeyTableOffsets[Index], InHeader->NumKeys[Index], sizeof(FRegistryImageKey)))
+			{
+				return false;
+			}
+		}
+		if (!IsSectionValid(InHeader->AssetIndexPoolOffset, InHeader->NumAssetIndices, sizeof(uint32))
+			|| !IsSectionValid(InHeader->AssetRecordsOffset, InHeader->NumAssets, sizeof(FRegistryImageAssetRecord))
+			|| !IsSectionValid(InHeader->PayloadOffset, InHeader->PayloadSize, 1))
+		{
+			return false;
+		}
+
+		Image = InImage;
+		Header = InHeader;
+		return true;
+	}
+
+	bool IsValid() const
+	{
+		return Header != nullptr;
+	}
+
+	int32 GetNumAssets() const
+	{
+		return Header ? (int32)Header->NumAssets : 0;
+	}
+
+	/** Returns the record of an asset, or nullptr if AssetIndex (e.g. read from a corrupt index run) is out of range. */
+	const FRegistryImageAssetRecord* FindAssetRecord(uint32 AssetIndex) const
+	{
+		if (!Header || AssetIndex >= Header->NumAssets)
+		{
+			return nullptr;
+		}
+		return &GetSection<FRegistryImageAssetRecord>(Header->AssetRecordsOffset, Header->NumAssets)[AssetIndex];
+	}
+
+	/**
+	 * Gets the serialized FAssetData of an asset, to be read with the name batch stored in the payload section.
+	 *
+	 * @return	False if the asset doesn't exist or its payload lies outside of the payload section
+	 */
+	bool TryGetAssetPayload(uint32 AssetIndex, FMemoryView& OutPayload) const
+	{
+		const FRegistryImageAssetRecord* Record = FindAssetRecord(AssetIndex);
+		if (!Record || Record->PayloadOffset > Header->PayloadSize || Record->PayloadSize > Header->PayloadSize - Record->PayloadOffset)
+		{
+			return false;
+		}
+		OutPayload = Image.Mid(Header->PayloadOffset + Record->PayloadOffset, Record->PayloadSize);
+		return true;
+	}
+
+	/**
+	 * Returns the ascending indices of all assets with the given key, found by binary search of the key table.
+	 * Returns an empty view if there are none, or if the key's run lies outside of the asset index pool.
+	 */
+	TConstArrayView<uint32> FindAssets(ERegistryImageIndex Index, uint64 KeyHash) const
+	{
+		if (!Header)
+		{
+			return TConstArrayView<uint32>();
+		}
+
+		TConstArrayView<FRegistryImageKey> Keys = GetSection<FRegistryImageKey>(Header->KeyTableOffsets[(uint8)Index], Header->NumKeys[(uint8)Index]);
+		const int32 KeyIndex = Algo::BinarySearchBy(Keys, KeyHash, &FRegistryImageKey::Hash);
+		if (KeyIndex == INDEX_NONE)
+		{
+			return TConstArrayView<uint32>();
+		}
+
+		const FRegistryImageKey& Key = Keys[KeyIndex];
+		if ((uint64)Key.FirstIndex + Key.NumIndices > Header->NumAssetIndices)
+		{
+			return TConstArrayView<uint32>();
+		}
+		return GetSection<uint32>(Header->AssetIndexPoolOffset, Header->NumAssetIndices).Slice(Key.FirstIndex, Key.NumIndices);
+	}
+
+	/**
+	 * Calls Callback with the ascending index of every asset that may pass Filter, using only the key tables and
+	 * asset records. Each filter component is the union of its keys' runs, and the components are intersected.
+	 * Soft object paths are matched by their package name, and tag values are not tested since they require the
+	 * deserialized tag map, so callers that need exact results recheck the candidates. Stops when Callback returns false.
+	 */
+	void EnumerateCandidates(const FARCompiledFilter& Filter, TFunctionRef<bool(uint32 AssetIndex)> Callback) const
+	{
+		if (!Header)
+		{
+			return;
+		}
+
+		TArray<uint32> Candidates;
+		bool bHasComponent = false;
+		auto AddComponent = [this, &Candidates, &bHasComponent](ERegistryImageIndex Index, auto&& ForEachKeyHash)
+		{
+			TArray<TConstArrayView<uint32>, TInlineAllocator<8>> Runs;
+			ForEachKeyHash([this, Index, &Runs](uint64 KeyHash) { Runs.Add(FindAssets(Index, KeyHash)); });
+
+			TArray<uint32> ComponentIndices;
+			UnionRuns(Runs, ComponentIndices);
+			if (bHasComponent)
+			{
+				IntersectRuns(Candidates, ComponentIndices);
+			}
+			else
+			{
+				Candidates = MoveTemp(ComponentIndices);
+				bHasComponent = true;
+			}
+		};
+
+		if (Filter.PackageNames.Num() > 0)
+		{
+			AddComponent(ERegistryImageIndex::PackageName, [&Filter](auto&& Add) { for (FName Name : Filter.PackageNames) { Add(HashKey(Name)); } });
+		}
+		if (Filter.SoftObjectPaths.Num() > 0)
+		{
+			AddComponent(ERegistryImageIndex::PackageName, [&Filter](auto&& Add) { for (const FSoftObjectPath& Path : Filter.SoftObjectPaths) { Add(HashKey(Path.GetLongPackageFName())); } });
+		}
+		if (Filter.PackagePaths.Num() > 0)
+		{
+			AddComponent(ERegistryImageIndex::PackagePath, [&Filter](auto&& Add) { for (FName Path : Filter.PackagePaths) { Add(HashKey(Path)); } });
+		}
+		if (Filter.ClassPaths.Num() > 0)
+		{
+			AddComponent(ERegistryImageIndex::Class, [&Filter](auto&& Add) { for (const FTopLevelAssetPath& ClassPath : Filter.ClassPaths) { Add(HashKey(ClassPath)); } });
+		}
+		if (Filter.TagsAndValues.Num() > 0)
+		{
+			AddComponent(ERegistryImageIndex::TagKey, [&Filter](auto&& Add) { for (const TPair<FName, TOptional<FString>>& Pair : Filter.TagsAndValues) { Add(HashKey(Pair.Key)); } });
+		}
+
+		auto Visit = [this, &Filter, &Callback](uint32 AssetIndex)
+		{
+			const FRegistryImageAssetRecord* Record = FindAssetRecord(AssetIndex);
+			if (!Record
+				|| (Record->PackageFlags & Filter.WithoutPackageFlags) != 0
+				|| (Record->PackageFlags & Filter.WithPackageFlags) != Filter.WithPackageFlags)
+			{
+				return true;
+			}
+			return Callback(AssetIndex);
+		};
+
+		if (bHasComponent)
+		{
+			for (uint32 AssetIndex : Candidates)
+			{
+				if (!Visit(AssetIndex))
+				{
+					return;
+				}
+			}
+		}
+		else
+		{
+			for (uint32 AssetIndex = 0; AssetIndex < Header->NumAssets; ++AssetIndex)
+			{
+				if (!Visit(AssetIndex))
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	/** Case-insensitive 64-bit hash used for every key table. */
+	static uint64 HashKey(FStringView Key)
+	{
+		TStringBuilder<256> Lower;
+		for (TCHAR Char : Key)
+		{
+			Lower.AppendChar(FChar::ToLower(Char));
+		}
+		return FXxHash64::HashBuffer(Lower.GetData(), Lower.Len() * sizeof(TCHAR)).Hash;
+	}
+
+	static uint64 HashKey(FName Key)
+	{
+		TStringBuilder<256> Builder;
+		Key.AppendString(Builder);
+		return HashKey(Builder.ToView());
+	}
+
+	static uint64 HashKey(const FTopLevelAssetPath& Key)
+	{
+		TStringBuilder<256> Builder;
+		Key.AppendString(Builder);
+		return HashKey(Builder.ToView());
+	}
+
+	/** Appends the ascending union of sorted runs to OutIndices, which must be empty. */
+	static void UnionRuns(TConstArrayView<TConstArrayView<uint32>> Runs, TArray<uint32>& OutIndices)
+	{
+		check(OutIndices.IsEmpty());
+		for (TConstArrayView<uint32> Run : Runs)
+		{
+			OutIndices.Append(Run);
+		}
+		if (Runs.Num() > 1)
+		{
+			Algo::Sort(OutIndices);
+			OutIndices.SetNum(Algo::Unique(OutIndices), EAllowShrinking::No);
+		}
+	}
+
+	/** Keeps in InOutIndices only the indices also present in Other. Both must be ascending. */
+	static void IntersectRuns(TArray<uint32>& InOutIndices, TConstArrayView<uint32> Other)
+	{
+		int32 Write = 0;
+		int32 OtherIndex = 0;
+		for (int32 Read = 0; Read < InOutIndices.Num() && OtherIndex < Other.Num(); ++Read)
+		{
+			const uint32 Value = InOutIndices[Read];
+			while (OtherIndex < Other.Num() && Other[OtherIndex] < Value)
+			{
+				++OtherIndex;
+			}
+			if (OtherIndex < Other.Num() && Other[OtherIndex] == Value)
+			{
+				InOutIndices[Write++] = Value;
+			}
+		}
+		InOutIndices.SetNum(Write, EAllowShrinking::No);
+	}
+
+private:
+	/** Offset and Num must have been validated by Initialize */
+	template <typename T>
+	TConstArrayView<T> GetSection(uint64 Offset, uint64 Num) const
+	{
+		checkSlow(Num <= (uint64)MAX_int32 && Offset + Num * sizeof(T) <= Image.GetSize());
+		return TConstArrayView<T>(reinterpret_cast<const T*>(static_cast<const uint8*>(Image.GetData()) + Offset), (int32)Num);
+	}
+
+	FMemoryView Image;
+	const FRegistryImageHeader* Header = nullptr;
+};
+
+/** Registry image backed by a memory-mapped file. Pages are faulted in only as queries touch them. */
+class FMappedRegistryImage
+{
+public:
+	static TUniquePtr<FMappedRegistryImage> Open(const TCHAR* Filename)
+	{
+		TUniquePtr<FMappedRegistryImage> Result(new FMappedRegistryImage());
+		Result->Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(Filename));
+		if (!Result->Handle)
+		{
+			return nullptr;
+		}
+		Result->Region.Reset(Result->Handle->MapRegion());
+		if (!Result->Region
+			|| !Result->Image.Initialize(FMemoryView(Result->Region->GetMappedPtr(), Result->Region->GetMappedSize())))
+		{
+			return nullptr;
+		}
+		return Result;
+	}
+
+	~FMappedRegistryImage()
+	{
+		// The region must be released before the handle that owns the mapping
+		Region.Reset();
+		Handle.Reset();
+	}
+
+	const FRegistryImage& Get() const
+	{
+		return Image;
+	}
+
+private:
+	FMappedRegistryImage() = default;
+
+	TUniquePtr<IMappedFileHandle> Handle;
+	TUniquePtr<IMappedFileRegion> Region;
+	FRegistryImage Image;
+};
+
+} // namespace UE::AssetRegistry
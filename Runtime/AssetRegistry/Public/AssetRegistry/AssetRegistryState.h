@@ -2,8 +2,21 @@
 
 #pragma once
 
+/**
+ * UE_ASSETREGISTRY_BITMAP_INDEX: If non-zero, the state also maintains an FAssetRegistryBitmapIndex over its assets
+ * and EnumerateAssets evaluates FARCompiledFilter as unions and intersections of compressed bitmaps rather than by
+ * gathering TSets from the Cached* maps. Costs roughly one bit per asset per indexed key in dense ranges and two bytes
+ * per asset per key in sparse ranges.
+ */
+#ifndef UE_ASSETREGISTRY_BITMAP_INDEX
+#define UE_ASSETREGISTRY_BITMAP_INDEX 0
+#endif
+
 #include "AssetRegistry/AssetData.h"
 #include "AssetRegistry/AssetDataMap.h"
+#if UE_ASSETREGISTRY_BITMAP_INDEX
+#include "AssetRegistry/AssetRegistryBitmapIndex.h"
+#endif
 #include "AssetRegistry/IAssetRegistry.h"
 #include "Containers/Array.h"
 #include "Containers/ArrayView.h"
@@ -722,6 +735,11 @@ private:
 	TMap<FName, TSet<FTopLevelAssetPath> > CachedClassesByTag;
 #endif
 
+#if UE_ASSETREGISTRY_BITMAP_INDEX
+	/** Bitmap indices over CachedAssets, kept in sync with the Cached* maps and used to evaluate compiled filters */
+	UE::AssetRegistry::FAssetRegistryBitmapIndex BitmapIndex;
+#endif
+
 	/** A map of object names to dependency data */
 	TMap<FAssetIdentifier, FDependsNode*> CachedDependsNodes;
 
@@ -1068,4 +1068,5 @@ protected:
 	std::atomic<int32> RefCount = 0;
 	
 	friend struct FInstancedPropertyBag;
+	friend class FPropertyBagCollection;
 };
\ No newline at end of file
@@ -0,0 +1,315 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "StructUtils/PropertyBag.h"
+#include "Templates/IsEnum.h"
+#include "Templates/ValueOrError.h"
+#include "UObject/ObjectPtr.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/UnrealType.h"
+
+namespace UE::StructUtils::Private
+{
+	/** How a typed column access uses the values, which decides whether a derived or a base class pointer type is accepted. */
+	enum class EPropertyBagColumnAccess : uint8
+	{
+		Read,
+		Write,
+	};
+
+	template <typename ObjectType>
+	bool IsColumnObjectClassCompatible(const FPropertyBagPropertyDesc& Desc, const EPropertyBagColumnAccess Access)
+	{
+		static_assert(TIsDerivedFrom<ObjectType, UObject>::Value, "Should only call this with object types");
+
+		const UClass* ColumnClass = Cast<const UClass>(Desc.ValueTypeObject);
+		if (Desc.ValueType != EPropertyBagPropertyType::Object || ColumnClass == nullptr)
+		{
+			return false;
+		}
+		// Every value read from the column must be an ObjectType, every value written must be a column class
+		return Access == EPropertyBagColumnAccess::Read
+			? ColumnClass->IsChildOf(ObjectType::StaticClass())
+			: ObjectType::StaticClass()->IsChildOf(ColumnClass);
+	}
+
+	/** @return true if T is the C++ type stored by a property bag property described by Desc. */
+	template <typename T>
+	bool IsColumnType(const FPropertyBagPropertyDesc& Desc, const EPropertyBagColumnAccess Access)
+	{
+		if (!Desc.ContainerTypes.IsEmpty())
+		{
+			return false;
+		}
+
+		if constexpr (std::is_same_v<T, bool>) { return Desc.ValueType == EPropertyBagPropertyType::Bool; }
+		else if constexpr (std::is_same_v<T, uint8>) { return Desc.ValueType == EPropertyBagPropertyType::Byte; }
+		else if constexpr (std::is_same_v<T, int32>) { return Desc.ValueType == EPropertyBagPropertyType::Int32; }
+		else if constexpr (std::is_same_v<T, uint32>) { return Desc.ValueType == EPropertyBagPropertyType::UInt32; }
+		else if constexpr (std::is_same_v<T, int64>) { return Desc.ValueType == EPropertyBagPropertyType::Int64; }
+		else if constexpr (std::is_same_v<T, uint64>) { return Desc.ValueType == EPropertyBagPropertyType::UInt64; }
+		else if constexpr (std::is_same_v<T, float>) { return Desc.ValueType == EPropertyBagPropertyType::Float; }
+		else if constexpr (std::is_same_v<T, double>) { return Desc.ValueType == EPropertyBagPropertyType::Double; }
+		else if constexpr (std::is_same_v<T, FName>) { return Desc.ValueType == EPropertyBagPropertyType::Name; }
+		else if constexpr (std::is_same_v<T, FString>) { return Desc.ValueType == EPropertyBagPropertyType::String; }
+		else if constexpr (std::is_same_v<T, FText>) { return Desc.ValueType == EPropertyBagPropertyType::Text; }
+		else if constexpr (std::is_same_v<T, FSoftObjectPtr>)
+		{
+			return Desc.ValueType == EPropertyBagPropertyType::SoftObject || Desc.ValueType == EPropertyBagPropertyType::SoftClass;
+		}
+		else if constexpr (std::is_same_v<T, UClass*> || std::is_same_v<T, TObjectPtr<UClass>>)
+		{
+			return Desc.ValueType == EPropertyBagPropertyType::Class;
+		}
+		else if constexpr (TIsEnum<T>::Value)
+		{
+			return Desc.ValueType == EPropertyBagPropertyType::Enum && Desc.ValueTypeObject == StaticEnum<T>();
+		}
+		else if constexpr (std::is_pointer_v<T>)
+		{
+			return IsColumnObjectClassCompatible<std::remove_cv_t<std::remove_pointer_t<T>>>(Desc, Access);
+		}
+		else if constexpr (TIsTObjectPtr_V<T>)
+		{
+			return IsColumnObjectClassCompatible<typename T::ElementType>(Desc, Access);
+		}
+		else
+		{
+			return Desc.ValueType == EPropertyBagPropertyType::Struct && Desc.ValueTypeObject == TBaseStructure<T>::Get();
+		}
+	}
+} // UE::StructUtils::Private
+
+/**
+ * Collection of property bag instances that all share the same UPropertyBag layout.
+ *
+ * Where an array of FInstancedPropertyBag allocates every instance separately and repeats the layout pointer in each,
+ * the collection stores one layout and keeps the values in structure-of-arrays form: one contiguous column per property,
+ * indexed by instance. Iterating a single parameter across all instances then walks contiguous memory, and columns of
+ * plain old data are copied in bulk.
+ *
+ *		FPropertyBagCollection Collection(Bag.GetPropertyBagStruct());
+ *		for (int32 Index = 0; Index < NumAgents; Index++)
+ *		{
+ *			Collection.AddFromBag(Bag);
+ *		}
+ *
+ *		const int32 SpeedColumn = Collection.FindColumnByName(SpeedName);
+ *		for (float& Speed : Collection.GetMutableColumn<float>(SpeedColumn))
+ *		{
+ *			Speed *= 0.5f;
+ *		}
+ *
+ * Note: Column views are not valid after instances are added or removed.
+ */
+class COREUOBJECT_API FPropertyBagCollection
+{
+public:
+	FPropertyBagCollection() = default;
+	explicit FPropertyBagCollection(const UPropertyBag* InBagStruct);
+	FPropertyBagCollection(const FPropertyBagCollection& Other);
+	FPropertyBagCollection(FPropertyBagCollection&& Other);
+	~FPropertyBagCollection();
+
+	FPropertyBagCollection& operator=(const FPropertyBagCollection& Other);
+	FPropertyBagCollection& operator=(FPropertyBagCollection&& Other);
+
+	/** Removes all instances and sets the layout shared by all future instances. */
+	void Initialize(const UPropertyBag* InBagStruct);
+
+	/** Removes all instances, keeping the layout and the allocated columns. */
+	void Reset();
+
+	/** Grows every column so that at least InCapacity instances fit without reallocation. */
+	void Reserve(const int32 InCapacity);
+
+	/** @return pointer to the property bag struct shared by all instances. */
+	const UPropertyBag* GetPropertyBagStruct() const { return BagStruct; }
+
+	/** @return number of instances in the collection. */
+	int32 Num() const { return NumInstances; }
+
+	bool IsValidIndex(const int32 Index) const { return Index >= 0 && Index < NumInstances; }
+
+	/** Adds an instance initialized to the default values of the layout. @return index of the new instance. */
+	int32 Add();
+
+	/**
+	 * Adds an instance and copies the values of Bag into it.
+	 * @return index of the new instance, or INDEX_NONE if Bag does not use the layout of this collection.
+	 */
+	int32 AddFromBag(const FInstancedPropertyBag& Bag);
+
+	/** Removes an instance by moving the last instance into its slot. */
+	void RemoveAtSwap(const int32 Index);
+
+	/** Copies the values of an instance to Bag, initializing Bag with the layout of this collection first. */
+	void CopyToBag(const int32 Index, FInstancedPropertyBag& OutBag) const;
+
+	/** Copies all values of instance SourceIndex over instance TargetIndex. */
+	void CopyInstance(const int32 SourceIndex, const int32 TargetIndex);
+
+	/** @return column index of the property with specified ID, or INDEX_NONE if not found. */
+	int32 FindColumnByID(const FGuid ID) const
+	{
+		return Columns.IndexOfByPredicate([&ID](const FColumn& Column) { return Column.Desc->ID == ID; });
+	}
+
+	/** @return column index of the property with specified name, or INDEX_NONE if not found. */
+	int32 FindColumnByName(const FName Name) const
+	{
+		return Columns.IndexOfByPredicate([Name](const FColumn& Column) { return Column.Desc->Name == Name; });
+	}
+
+	/** @return number of columns, one per property of the layout. */
+	int32 GetNumColumns() const { return Columns.Num(); }
+
+	/** @return descriptor of the property stored in the column. */
+	const FPropertyBagPropertyDesc& GetColumnDesc(const int32 ColumnIndex) const { return *Columns[ColumnIndex].Desc; }
+
+	/** @return view of a column's values for all instances. T must match the property's element type. */
+	template <typename T>
+	TConstArrayView<T> GetColumn(const int32 ColumnIndex) const
+	{
+		const FColumn& Column = GetCheckedColumn<T>(ColumnIndex, UE::StructUtils::Private::EPropertyBagColumnAccess::Read);
+		return TConstArrayView<T>(reinterpret_cast<const T*>(Column.Data), NumInstances);
+	}
+
+	/** @return mutable view of a column's values for all instances. T must match the property's element type. */
+	template <typename T>
+	TArrayView<T> GetMutableColumn(const int32 ColumnIndex)
+	{
+		const FColumn& Column = GetCheckedColumn<T>(ColumnIndex, UE::StructUtils::Private::EPropertyBagColumnAccess::Write);
+		return TArrayView<T>(reinterpret_cast<T*>(Column.Data), NumInstances);
+	}
+
+	/**
+	 * Copies the values of property ID for instances [StartIndex, StartIndex + OutValues.Num()) to OutValues.
+	 * Plain old data is copied with a single memcpy.
+	 */
+	template <typename T>
+	EPropertyBagResult GetValues(const FGuid ID, TArrayView<T> OutValues, const int32 StartIndex = 0) const
+	{
+		const int32 ColumnIndex = FindColumnByID(ID);
+		const EPropertyBagResult Result = ValidateRange<T>(ColumnIndex, StartIndex, OutValues.Num(), UE::StructUtils::Private::EPropertyBagColumnAccess::Read);
+		if (Result == EPropertyBagResult::Success)
+		{
+			CopyRange(Columns[ColumnIndex], OutValues.GetData(), Columns[ColumnIndex].Data + (SIZE_T)StartIndex * sizeof(T), OutValues.Num());
+		}
+		return Result;
+	}
+
+	/**
+	 * Sets the values of property ID for instances [StartIndex, StartIndex + Values.Num()) from Values.
+	 * Plain old data is copied with a single memcpy.
+	 */
+	template <typename T>
+	EPropertyBagResult SetValues(const FGuid ID, TConstArrayView<T> Values, const int32 StartIndex = 0)
+	{
+		const int32 ColumnIndex = FindColumnByID(ID);
+		const EPropertyBagResult Result = ValidateRange<T>(ColumnIndex, StartIndex, Values.Num(), UE::StructUtils::Private::EPropertyBagColumnAccess::Write);
+		if (Result == EPropertyBagResult::Success)
+		{
+			CopyRange(Columns[ColumnIndex], Columns[ColumnIndex].Data + (SIZE_T)StartIndex * sizeof(T), Values.GetData(), Values.Num());
+		}
+		return Result;
+	}
+
+	/** @return value of property ID for a single instance. */
+	template <typename T>
+	TValueOrError<T, EPropertyBagResult> GetValue(const FGuid ID, const int32 Index) const
+	{
+		const int32 ColumnIndex = FindColumnByID(ID);
+		const EPropertyBagResult Result = ValidateRange<T>(ColumnIndex, Index, 1, UE::StructUtils::Private::EPropertyBagColumnAccess::Read);
+		if (Result != EPropertyBagResult::Success)
+		{
+			return MakeError(Result);
+		}
+		return MakeValue(reinterpret_cast<const T*>(Columns[ColumnIndex].Data)[Index]);
+	}
+
+	/** Sets the value of property ID for a single instance. */
+	template <typename T>
+	EPropertyBagResult SetValue(const FGuid ID, const int32 Index, const T& InValue)
+	{
+		return SetValues<T>(ID, MakeArrayView(&InValue, 1), Index);
+	}
+
+	/** Copies every column of Other into this collection, which must use the same layout. Plain old data columns are copied with one memcpy. */
+	EPropertyBagResult CopyFrom(const FPropertyBagCollection& Other);
+
+	void AddStructReferencedObjects(FReferenceCollector& Collector);
+	SIZE_T GetAllocatedSize() const;
+
+protected:
+	struct FColumn
+	{
+		const FPropertyBagPropertyDesc* Desc = nullptr;
+		/** Property describing one element; its offset inside the bag struct is ignored. */
+		const FProperty* Property = nullptr;
+		uint8* Data = nullptr;
+		int32 ElementSize = 0;
+		int32 Alignment = 0;
+		bool bIsPlainOldData = false;
+	};
+
+	/** Column types are checked against the property descriptor like the typed accessors of FInstancedPropertyBag; a matching size alone is not enough. */
+	template <typename T>
+	static bool IsColumnType(const FColumn& Column, const UE::StructUtils::Private::EPropertyBagColumnAccess Access)
+	{
+		return Column.ElementSize == sizeof(T)
+			&& Column.Alignment <= alignof(T)
+			&& UE::StructUtils::Private::IsColumnType<T>(*Column.Desc, Access);
+	}
+
+	template <typename T>
+	const FColumn& GetCheckedColumn(const int32 ColumnIndex, const UE::StructUtils::Private::EPropertyBagColumnAccess Access) const
+	{
+		const FColumn& Column = Columns[ColumnIndex];
+		checkf(IsColumnType<T>(Column, Access), TEXT("Type does not match property '%s'."), *Column.Desc->Name.ToString());
+		return Column;
+	}
+
+	template <typename T>
+	EPropertyBagResult ValidateRange(const int32 ColumnIndex, const int32 StartIndex, const int32 Count, const UE::StructUtils::Private::EPropertyBagColumnAccess Access) const
+	{
+		if (ColumnIndex == INDEX_NONE)
+		{
+			return EPropertyBagResult::PropertyNotFound;
+		}
+		if (!IsColumnType<T>(Columns[ColumnIndex], Access))
+		{
+			return EPropertyBagResult::TypeMismatch;
+		}
+		if (StartIndex < 0 || Count < 0 || StartIndex + Count > NumInstances)
+		{
+			return EPropertyBagResult::OutOfBounds;
+		}
+		return EPropertyBagResult::Success;
+	}
+
+	static void CopyRange(const FColumn& Column, void* Dest, const void* Src, const int32 Count)
+	{
+		if (Column.bIsPlainOldData)
+		{
+			FMemory::Memcpy(Dest, Src, (SIZE_T)Column.ElementSize * Count);
+		}
+		else
+		{
+			for (int32 Index = 0; Index < Count; Index++)
+			{
+				const SIZE_T Offset = (SIZE_T)Index * Column.ElementSize;
+				Column.Property->CopySingleValue(static_cast<uint8*>(Dest) + Offset, static_cast<const uint8*>(Src) + Offset);
+			}
+		}
+	}
+
+	void Grow(const int32 NewCapacity);
+	void DestroyAll();
+
+	TObjectPtr<const UPropertyBag> BagStruct = nullptr;
+	TArray<FColumn> Columns;
+	int32 NumInstances = 0;
+	int32 Capacity = 0;
+};
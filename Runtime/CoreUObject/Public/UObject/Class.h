@@ -111,6 +111,7 @@ struct FRandomStream;
 struct FUObjectSerializeContext;
 template <typename FuncType> class TFunctionRef;
 enum class EPropertyObjectReferenceType : uint32;
+namespace UE { class FTaggedPropertyLoadPlan; }
 
 COREUOBJECT_API DECLARE_LOG_CATEGORY_EXTERN(LogClass, Log, All);
 COREUOBJECT_API DECLARE_LOG_CATEGORY_EXTERN(LogScriptSerialization, Log, All);
@@ -439,6 +440,8 @@ public:
 
 	/** Cached schema for optimized unversioned and filtereditoronly property serialization, owned by this. */
 	mutable const struct FUnversionedStructSchema* UnversionedGameSchema = nullptr;
+	/** Cached plan for loading tagged properties saved with the current layout, owned by this. Reset whenever the struct is relinked. */
+	mutable const UE::FTaggedPropertyLoadPlan* TaggedPropertyLoadPlan = nullptr;
 #if WITH_EDITORONLY_DATA
 	/** Cached schema for optimized unversioned property serialization, with editor data, owned by this. */
 	mutable const struct FUnversionedStructSchema* UnversionedEditorSchema = nullptr;
@@ -552,6 +555,12 @@ public:
 	/** Serializes list of properties, using property tags to handle mismatches */
 	COREUOBJECT_API virtual void SerializeTaggedProperties(FStructuredArchive::FSlot Slot, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults, const UObject* BreakRecursionIfFullyLoad = nullptr) const;
 
+	/**
+	 * Returns the cached tagged property load plan for this struct, building it on first use.
+	 * Tags loaded in plan order skip lookup by name, and numeric values matching the live layout are read in place.
+	 */
+	COREUOBJECT_API const UE::FTaggedPropertyLoadPlan& GetTaggedPropertyLoadPlan() const;
+
 	/**
 	 * Preloads all fields that belong to this struct
 	 * @param Ar Archive used for loading this struct
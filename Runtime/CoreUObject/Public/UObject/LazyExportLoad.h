@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "UObject/ObjectHandleDefines.h"
+
+class UObject;
+
+#if UE_WITH_LAZY_EXPORT_LOAD
+
+namespace UE::CoreUObject::Private
+{
+	/**
+	 * Serializes Object through its linker if it is a lazy export placeholder that has not been loaded yet, i.e. if it has
+	 * EInternalObjectFlags::LazyExportPending (@see LOAD_LazyExports). Returns Object.
+	 * Handle resolve and find by name go through this first. Object iterators skip placeholders instead of loading them.
+	 */
+	COREUOBJECT_API UObject* LoadLazyExportIfPending(UObject* Object);
+
+	/** Typed version of LoadLazyExportIfPending for the find templates. */
+	template <typename T>
+	FORCEINLINE T* LoadLazyExportIfPendingTyped(T* Object)
+	{
+		return (T*)LoadLazyExportIfPending((UObject*)Object);
+	}
+}
+
+#define UE_LOAD_LAZY_EXPORT_IF_PENDING(Object) UE::CoreUObject::Private::LoadLazyExportIfPendingTyped(Object)
+
+#else
+
+#define UE_LOAD_LAZY_EXPORT_IF_PENDING(Object) (Object)
+
+#endif
@@ -403,6 +403,36 @@ public:
 	 */
 	COREUOBJECT_API bool HasAnyObjectsPendingLoad() const;
 
+	/**
+	 * Checks if the export was created as a placeholder whose data has not been serialized yet.
+	 * Only happens for linkers created with LOAD_LazyExports.
+	 */
+	bool IsLazyExportPending(int32 ExportIndex) const
+	{
+		return PendingLazyExports.IsValidIndex(ExportIndex) && PendingLazyExports[ExportIndex];
+	}
+
+	/**
+	 * Serializes a pending lazy export placeholder, its outer chain and its preload dependencies.
+	 * Placeholders carry EInternalObjectFlags::LazyExportPending until this clears it. Called the first time the export is
+	 * resolved through a handle or found by name. Does nothing if the export is not pending.
+	 * Object iterators skip pending placeholders instead of loading them.
+	 */
+	COREUOBJECT_API void LoadLazyExport(int32 ExportIndex);
+
+	/**
+	 * Serializes every pending lazy export placeholder of this linker.
+	 * For game thread code that needs all of the package's exports, e.g. before iterating over them.
+	 */
+	void LoadAllLazyExports()
+	{
+		check(IsInGameThread());
+		for (TConstSetBitIterator<> It(PendingLazyExports); It; ++It)
+		{
+			LoadLazyExport(It.GetIndex());
+		}
+	}
+
 	/** 
 	 * Add a new redirect from old game name to new game name for ImportMap 
 	 */
@@ -488,6 +518,9 @@ private:
 	/** Id of the thread that created this linker. This is to guard against using this linker on other threads than the one it was created on **/
 	int32					OwnerThread;
 
+	/** Per export, set while the export is a lazy placeholder that still needs to be serialized (@see LOAD_LazyExports).	*/
+	TBitArray<>				PendingLazyExports;
+
 	/**
 	 * Helper struct to keep track of background file reads
 	 */
@@ -870,6 +903,13 @@ private:
 	 */
 	UObject* CreateExportAndPreload(int32 ExportIndex, bool bForcePreload = false);
 
+	/**
+	 * Checks if an export may be created as a lazy placeholder when loading with LOAD_LazyExports.
+	 * Classes, structs, class default objects, archetypes, the package's assets and exports that other exports
+	 * list as preload dependencies are always loaded eagerly, since they are accessed without going through a handle.
+	 */
+	bool CanLoadExportLazily(int32 ExportIndex) const;
+
 	/**
 	 * Utility function for easily retrieving the specified export's UClass.
 	 * 
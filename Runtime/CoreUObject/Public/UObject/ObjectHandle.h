@@ -9,6 +9,7 @@
 #include "HAL/Platform.h"
 #include "Misc/AssertionMacros.h"
 #include "Templates/TypeHash.h"
+#include "UObject/LazyExportLoad.h"
 #include "UObject/NameTypes.h"
 #include "UObject/ObjectHandleTracking.h"
 #include "UObject/ObjectMacros.h"
@@ -276,6 +277,9 @@ namespace UE::CoreUObject::Private
 			FPackedObjectRef PackedObjectRef = ReadObjectHandlePackedObjectRefNoCheck(LocalHandle);
 			FObjectRef ObjectRef = MakeObjectRef(PackedObjectRef);
 			UObject* ResolvedObject = ObjectRef.Resolve();
+#if UE_WITH_LAZY_EXPORT_LOAD
+			ResolvedObject = LoadLazyExportIfPending(ResolvedObject);
+#endif
 #if UE_WITH_OBJECT_HANDLE_TYPE_SAFETY
 			if (IsObjectHandleTypeSafe(LocalHandle))
 #endif
@@ -297,6 +301,9 @@ namespace UE::CoreUObject::Private
 		FPackedObjectRef PackedObjectRef = ReadObjectHandlePackedObjectRefNoCheck(LocalHandle);
 		FObjectRef ObjectRef = MakeObjectRef(PackedObjectRef);
 		UObject* ResolvedObject = ObjectRef.Resolve();
+#if UE_WITH_LAZY_EXPORT_LOAD
+		ResolvedObject = LoadLazyExportIfPending(ResolvedObject);
+#endif
 #if UE_WITH_OBJECT_HANDLE_TYPE_SAFETY
 		if (IsObjectHandleTypeSafe(LocalHandle))
 #endif
@@ -18,4 +18,11 @@
 
 #ifndef UE_WITH_OBJECT_HANDLE_TYPE_SAFETY
 	#define UE_WITH_OBJECT_HANDLE_TYPE_SAFETY WITH_EDITORONLY_DATA
+#endif
+
+
+// Lazy export loading hands out unresolved handles to export placeholders, so it requires late resolve.
+// Late resolve is editor only, so lazy export loading is never available in cooked builds.
+#ifndef UE_WITH_LAZY_EXPORT_LOAD
+	#define UE_WITH_LAZY_EXPORT_LOAD UE_WITH_OBJECT_HANDLE_LATE_RESOLVE
 #endif
\ No newline at end of file
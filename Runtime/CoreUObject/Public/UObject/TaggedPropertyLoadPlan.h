@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Serialization/Archive.h"
+#include "UObject/Class.h"
+#include "UObject/NameTypes.h"
+#include "UObject/PropertyTag.h"
+#include "UObject/PropertyTypeName.h"
+#include "UObject/UnrealType.h"
+
+namespace UE
+{
+
+/**
+ * One expected tag in a tagged property load plan.
+ * Steps are stored in the same order SerializeVersionedTaggedProperties writes them (PropertyLink order, then array index).
+ */
+struct FTaggedPropertyLoadStep
+{
+	/** Live property the tag resolves to */
+	FProperty* Property = nullptr;
+	/** Name the tag must carry to match this step */
+	FName Name;
+	/** Full type name the tag must carry to match this step */
+	FPropertyTypeName TypeName;
+	/** Static array index the tag must carry to match this step */
+	int32 ArrayIndex = 0;
+	/** Byte offset of the element from the start of the container */
+	int32 Offset = 0;
+	/** Serialized size of the element when it can be read with a raw copy, 0 when it must go through SerializeItem */
+	int32 RawSize = 0;
+};
+
+/**
+ * Cached, per-struct description of the tag stream produced by saving a struct with the current live layout.
+ *
+ * Loading a tag against the plan is a name and type comparison with the step at the cursor instead of a lookup by name.
+ * Numeric properties whose tag matches exactly are read straight into the destination memory.
+ * Any tag that does not match the plan (renamed, retyped, removed or redirected property) returns INDEX_NONE
+ * and the caller falls back to the regular tag resolution path for it. Every tag is checked against its own step,
+ * so data saved with an older layout is handled tag by tag rather than rejected as a whole.
+ */
+class FTaggedPropertyLoadPlan
+{
+public:
+	/** Number of steps the cursor may skip forward to find a tag, covering properties omitted because they matched defaults */
+	static constexpr int32 MaxLookahead = 16;
+
+	FTaggedPropertyLoadPlan() = default;
+
+	/** Builds the plan from the linked property chain of Struct. Struct must already be linked. */
+	explicit FTaggedPropertyLoadPlan(const UStruct* Struct)
+	{
+		check(Struct);
+
+		for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+		{
+			if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated))
+			{
+				continue;
+			}
+
+			FPropertyTypeNameBuilder TypeBuilder;
+			Property->SaveTypeName(TypeBuilder);
+			const FPropertyTypeName TypeName = TypeBuilder.Build();
+			const int32 RawSize = CanReadRaw(Property) ? Property->GetElementSize() : 0;
+
+			for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ++ArrayIndex)
+			{
+				FTaggedPropertyLoadStep& Step = Steps.AddDefaulted_GetRef();
+				Step.Property = Property;
+				Step.Name = Property->GetFName();
+				Step.TypeName = TypeName;
+				Step.ArrayIndex = ArrayIndex;
+				Step.Offset = Property->GetOffset_ForInternal() + Property->GetElementSize() * ArrayIndex;
+				Step.RawSize = RawSize;
+			}
+		}
+		Steps.Shrink();
+	}
+
+	TConstArrayView<FTaggedPropertyLoadStep> GetSteps() const
+	{
+		return Steps;
+	}
+
+	/**
+	 * Finds the step matching Tag, starting at Cursor and looking at most MaxLookahead steps ahead.
+	 * On success, advances Cursor past the matched step.
+	 *
+	 * @return Index of the matching step, or INDEX_NONE when the tag must go through the regular resolution path.
+	 */
+	int32 MatchTag(const FPropertyTag& Tag, int32& Cursor) const
+	{
+		const int32 End = FMath::Min(Steps.Num(), Cursor + MaxLookahead);
+		for (int32 Index = Cursor; Index < End; ++Index)
+		{
+			const FTaggedPropertyLoadStep& Step = Steps[Index];
+			if (Step.Name == Tag.Name && Step.ArrayIndex == Tag.ArrayIndex && Step.TypeName == Tag.GetType())
+			{
+				Cursor = Index + 1;
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Reads the value of a tag matched by MatchTag straight into Data when the step allows it.
+	 *
+	 * @return true if the value was consumed, false if it must be read with FPropertyTag::SerializeTaggedProperty.
+	 */
+	static bool TryLoadRaw(FArchive& Ar, const FTaggedPropertyLoadStep& Step, const FPropertyTag& Tag, uint8* Data)
+	{
+		if (Step.RawSize == 0 || Step.RawSize != Tag.Size || Ar.IsTextFormat() || Ar.IsByteSwapping())
+		{
+			return false;
+		}
+		Ar.Serialize(Data + Step.Offset, Step.RawSize);
+		return true;
+	}
+
+private:
+	/** Numeric values are written as their raw bytes. Enum-backed bytes are written as names and bools live in the tag. */
+	static bool CanReadRaw(const FProperty* Property)
+	{
+		const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+		return NumericProperty
+			&& !NumericProperty->GetIntPropertyEnum()
+			&& Property->HasAllPropertyFlags(CPF_IsPlainOldData);
+	}
+
+	TArray<FTaggedPropertyLoadStep> Steps;
+};
+
+} // namespace UE
@@ -38,6 +38,7 @@
 #include "Templates/UnrealTemplate.h"
 #include "Templates/IsTObjectPtr.h"
 #include "Traits/IsCharEncodingCompatibleWith.h"
+#include "UObject/LazyExportLoad.h"
 #include "UObject/NameTypes.h"
 #include "UObject/ObjectMacros.h"
 #include "UObject/PrimaryAssetId.h"
@@ -1898,7 +1899,7 @@ UE_DEPRECATED(5.1, "Support for searching for objects in ANY_PACKAGE has been de
 inline T* FindObjectFast( UObject* Outer, FName Name, bool ExactClass, bool AnyPackage, EObjectFlags ExclusiveFlags=RF_NoFlags )
 {
 	PRAGMA_DISABLE_DEPRECATION_WARNINGS
-	return (T*)StaticFindObjectFast( T::StaticClass(), Outer, Name, ExactClass, AnyPackage, ExclusiveFlags );
+	return UE_LOAD_LAZY_EXPORT_IF_PENDING((T*)StaticFindObjectFast( T::StaticClass(), Outer, Name, ExactClass, AnyPackage, ExclusiveFlags ));
 	PRAGMA_ENABLE_DEPRECATION_WARNINGS
 }
 
@@ -1909,7 +1910,7 @@ inline T* FindObjectFast( UObject* Outer, FName Name, bool ExactClass, bool AnyP
 template< class T >
 inline T* FindObjectFast(UObject* Outer, FName Name, bool ExactClass = false, EObjectFlags ExclusiveFlags = RF_NoFlags)
 {
-	return (T*)StaticFindObjectFast(T::StaticClass(), Outer, Name, ExactClass, ExclusiveFlags);
+	return UE_LOAD_LAZY_EXPORT_IF_PENDING((T*)StaticFindObjectFast(T::StaticClass(), Outer, Name, ExactClass, ExclusiveFlags));
 }
 
 /**
@@ -1919,7 +1920,7 @@ inline T* FindObjectFast(UObject* Outer, FName Name, bool ExactClass = false, EO
 template< class T > 
 inline T* FindObject( UObject* Outer, const TCHAR* Name, bool ExactClass=false )
 {
-	return (T*)StaticFindObject( T::StaticClass(), Outer, Name, ExactClass );
+	return UE_LOAD_LAZY_EXPORT_IF_PENDING((T*)StaticFindObject( T::StaticClass(), Outer, Name, ExactClass ));
 }
 
 /**
@@ -1929,7 +1930,7 @@ inline T* FindObject( UObject* Outer, const TCHAR* Name, bool ExactClass=false )
 template< class T >
 inline T* FindObject(FTopLevelAssetPath InPath, bool ExactClass = false)
 {
-	return (T*)StaticFindObject(T::StaticClass(), InPath, ExactClass);
+	return UE_LOAD_LAZY_EXPORT_IF_PENDING((T*)StaticFindObject(T::StaticClass(), InPath, ExactClass));
 }
 
 /**
@@ -1939,7 +1940,7 @@ inline T* FindObject(FTopLevelAssetPath InPath, bool ExactClass = false)
 template< class T > 
 inline T* FindObjectChecked( UObject* Outer, const TCHAR* Name, bool ExactClass=false )
 {
-	return (T*)StaticFindObjectChecked( T::StaticClass(), Outer, Name, ExactClass );
+	return UE_LOAD_LAZY_EXPORT_IF_PENDING((T*)StaticFindObjectChecked( T::StaticClass(), Outer, Name, ExactClass ));
 }
 
 /**
@@ -1949,7 +1950,7 @@ inline T* FindObjectChecked( UObject* Outer, const TCHAR* Name, bool ExactClass=
 template< class T > 
 inline T* FindObjectSafe( UObject* Outer, const TCHAR* Name, bool ExactClass=false )
 {
-	return (T*)StaticFindObjectSafe( T::StaticClass(), Outer, Name, ExactClass );
+	return UE_LOAD_LAZY_EXPORT_IF_PENDING((T*)StaticFindObjectSafe( T::StaticClass(), Outer, Name, ExactClass ));
 }
 
 /**
@@ -1959,7 +1960,7 @@ inline T* FindObjectSafe( UObject* Outer, const TCHAR* Name, bool ExactClass=fal
 template< class T >
 inline T* FindObjectSafe(FTopLevelAssetPath InPath, bool ExactClass = false)
 {
-	return (T*)StaticFindObjectSafe(T::StaticClass(), InPath, ExactClass);
+	return UE_LOAD_LAZY_EXPORT_IF_PENDING((T*)StaticFindObjectSafe(T::StaticClass(), InPath, ExactClass));
 }
 
 /**
@@ -1969,7 +1970,7 @@ inline T* FindObjectSafe(FTopLevelAssetPath InPath, bool ExactClass = false)
 template< class T >
 inline T* FindFirstObject(const TCHAR* Name, EFindFirstObjectOptions Options = EFindFirstObjectOptions::None, ELogVerbosity::Type AmbiguousMessageVerbosity = ELogVerbosity::NoLogging, const TCHAR* CurrentOperation = nullptr)
 {
-	return (T*)StaticFindFirstObject(T::StaticClass(), Name, Options, AmbiguousMessageVerbosity, CurrentOperation);
+	return UE_LOAD_LAZY_EXPORT_IF_PENDING((T*)StaticFindFirstObject(T::StaticClass(), Name, Options, AmbiguousMessageVerbosity, CurrentOperation));
 }
 
 /**
@@ -1979,7 +1980,7 @@ inline T* FindFirstObject(const TCHAR* Name, EFindFirstObjectOptions Options = E
 template< class T >
 inline T* FindFirstObjectSafe(const TCHAR* Name, EFindFirstObjectOptions Options = EFindFirstObjectOptions::None, ELogVerbosity::Type AmbiguousMessageVerbosity = ELogVerbosity::NoLogging, const TCHAR* CurrentOperation = nullptr)
 {
-	return (T*)StaticFindFirstObjectSafe(T::StaticClass(), Name, Options, AmbiguousMessageVerbosity, CurrentOperation);
+	return UE_LOAD_LAZY_EXPORT_IF_PENDING((T*)StaticFindFirstObjectSafe(T::StaticClass(), Name, Options, AmbiguousMessageVerbosity, CurrentOperation));
 }
 
 /** 
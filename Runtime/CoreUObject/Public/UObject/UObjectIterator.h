@@ -58,7 +58,8 @@ enum class EObjectIteratorThreadSafetyOptions : uint8
 
 inline EInternalObjectFlags GetObjectIteratorDefaultInternalExclusionFlags(EInternalObjectFlags InternalExclusionFlags)
 {
-	return InternalExclusionFlags | EInternalObjectFlags::Unreachable | EInternalObjectFlags::PendingConstruction | UE::GetAsyncLoadingInternalFlagsExclusion();
+	// Lazy export placeholders are skipped rather than loaded, iteration may run off the game thread, during GC or with the object array locked
+	return InternalExclusionFlags | EInternalObjectFlags::Unreachable | EInternalObjectFlags::PendingConstruction | EInternalObjectFlags::LazyExportPending | UE::GetAsyncLoadingInternalFlagsExclusion();
 }
 
 /**
@@ -0,0 +1,460 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/NetPacketNotify.h"
+#include "Net/Core/Misc/ResizableCircularQueue.h"
+
+/** Limits shared by all congestion controllers, in bytes per second. */
+struct FNetCongestionControlConfig
+{
+	/** Lower bound for the send rate, so a connection can always recover from a bad estimate. */
+	int32 MinRate = 2000;
+
+	/** Upper bound for the send rate, typically MaxClientRate or MaxInternetClientRate. */
+	int32 MaxRate = 100000;
+
+	/** Send rate until the first estimate is available, typically ConfiguredInternetSpeed. */
+	int32 InitialRate = 10000;
+};
+
+/**
+ * Per connection congestion controller.
+ *
+ * The connection reports every packet it sends along with its sequence number, and forwards the delivery notifications
+ * produced by FNetPacketNotify::Update. GetSendBudgetBits() then replaces the fixed CurrentNetSpeed when draining QueuedBits,
+ * so the per tick budget that replication prioritization works against follows what the path can actually carry.
+ * See FNetConnectionCongestionControl.
+ */
+class INetCongestionController
+{
+public:
+	using SequenceNumberT = FNetPacketNotify::SequenceNumberT;
+
+	virtual ~INetCongestionController() = default;
+
+	/** Forgets all state, e.g. when the connection is (re)opened. */
+	virtual void Reset(const FNetCongestionControlConfig& InConfig) = 0;
+
+	/**
+	 * Called for every packet sent with a sequence number, in sequence order.
+	 *
+	 * @param bAppLimited	True if the connection had nothing more to send this tick, so the packet doesn't reflect the available bandwidth.
+	 */
+	virtual void OnPacketSent(SequenceNumberT Seq, int32 SizeInBytes, double TimeSeconds, bool bAppLimited) = 0;
+
+	/** Called from the FNetPacketNotify::Update functor, in sequence order. */
+	virtual void OnPacketNotify(SequenceNumberT Seq, bool bDelivered, double TimeSeconds) = 0;
+
+	/** Returns the current send rate in bytes per second. */
+	virtual int32 GetSendRate() const = 0;
+
+	/** Returns the number of bits that may be sent over DeltaTime at the current send rate. */
+	int64 GetSendBudgetBits(float DeltaTime) const
+	{
+		return static_cast<int64>(double(GetSendRate()) * DeltaTime * 8.0);
+	}
+};
+
+/** Sends at the configured initial rate regardless of feedback, which is how connections behave without a congestion controller. */
+class FNetFixedRateCongestionController : public INetCongestionController
+{
+public:
+	virtual void Reset(const FNetCongestionControlConfig& InConfig) override
+	{
+		Rate = FMath::Clamp(InConfig.InitialRate, InConfig.MinRate, InConfig.MaxRate);
+	}
+
+	virtual void OnPacketSent(SequenceNumberT Seq, int32 SizeInBytes, double TimeSeconds, bool bAppLimited) override {}
+	virtual void OnPacketNotify(SequenceNumberT Seq, bool bDelivered, double TimeSeconds) override {}
+	virtual int32 GetSendRate() const override { return Rate; }
+
+private:
+	int32 Rate = 0;
+};
+
+/**
+ * Model based congestion controller in the style of BBR.
+ *
+ * Every delivered packet yields a delivery rate sample and a round trip sample. The bottleneck bandwidth is the maximum
+ * delivery rate over the last BandwidthWindowRounds round trips and the send rate is that estimate times a gain:
+ * high while starting up to find the bandwidth quickly, then cycling slightly above and below 1 to probe for more
+ * bandwidth and drain any queue that built up. As the controller only sets a rate and has no congestion window, the cruising
+ * phases also back off while the smoothed round trip time is more than QueueDelayThreshold above the minimum, so a standing
+ * queue at the bottleneck drains instead of adding latency. Rounds that lose more than LossThreshold of their packets back
+ * the estimate off, so sustained loss on a path that shares its bottleneck still lowers the rate.
+ *
+ * Samples from app limited packets are only used if they raise the estimate, since game traffic rarely fills the pipe.
+ */
+class FNetBBRCongestionController : public INetCongestionController
+{
+public:
+	static constexpr int32 BandwidthWindowRounds = 10;
+	static constexpr double MinRttWindowSeconds = 10.0;
+	static constexpr double StartupGain = 2.885;
+	static constexpr double LossThreshold = 0.02;
+	static constexpr double LossBackoff = 0.85;
+	static constexpr double QueueDelayThreshold = 0.25;
+	static constexpr double QueueDrainGain = 0.9;
+
+	enum class EMode : uint8
+	{
+		Startup,
+		Drain,
+		ProbeBandwidth,
+	};
+
+	virtual void Reset(const FNetCongestionControlConfig& InConfig) override
+	{
+		Config = InConfig;
+		SentPackets.Reset();
+		FMemory::Memzero(BandwidthFilter);
+		Mode = EMode::Startup;
+		PacingGain = StartupGain;
+		Delivered = 0;
+		DeliveredTime = 0.0;
+		NextRoundDelivered = 0;
+		RoundCount = 0;
+		RoundDelivered = 0;
+		RoundLost = 0;
+		FullBandwidth = 0.0;
+		FullBandwidthRounds = 0;
+		MinRtt = 0.0;
+		MinRttStamp = 0.0;
+		SmoothedRtt = 0.0;
+		CycleIndex = 0;
+		CycleStamp = 0.0;
+	}
+
+	virtual void OnPacketSent(SequenceNumberT Seq, int32 SizeInBytes, double TimeSeconds, bool bAppLimited) override
+	{
+		if (SentPackets.IsEmpty())
+		{
+			// Nothing in flight, so the delivery rate interval starts now rather than at the last ack
+			DeliveredTime = TimeSeconds;
+		}
+
+		FSentPacket& Packet = SentPackets.Enqueue_GetRef();
+		Packet.Seq = Seq;
+		Packet.SizeInBytes = SizeInBytes;
+		Packet.SentTime = TimeSeconds;
+		Packet.DeliveredAtSend = Delivered;
+		Packet.DeliveredTimeAtSend = DeliveredTime;
+		Packet.bAppLimited = bAppLimited;
+	}
+
+	virtual void OnPacketNotify(SequenceNumberT Seq, bool bDelivered, double TimeSeconds) override
+	{
+		// Notifications arrive in sequence order, anything before Seq that wasn't notified is gone
+		while (!SentPackets.IsEmpty() && SequenceNumberT::Diff(SentPackets.Peek().Seq, Seq) < 0)
+		{
+			OnPacketLost(SentPackets.Peek());
+			SentPackets.Pop();
+		}
+
+		if (SentPackets.IsEmpty() || SentPackets.Peek().Seq != Seq)
+		{
+			return;
+		}
+
+		const FSentPacket Packet = SentPackets.Peek();
+		SentPackets.Pop();
+
+		if (bDelivered)
+		{
+			OnPacketDelivered(Packet, TimeSeconds);
+		}
+		else
+		{
+			OnPacketLost(Packet);
+		}
+	}
+
+	virtual int32 GetSendRate() const override
+	{
+		const double Bandwidth = GetBandwidthEstimate();
+		if (Bandwidth <= 0.0)
+		{
+			return FMath::Clamp(Config.InitialRate, Config.MinRate, Config.MaxRate);
+		}
+
+		double Gain = PacingGain;
+		if (Mode == EMode::ProbeBandwidth && Gain == 1.0 && SmoothedRtt > MinRtt * (1.0 + QueueDelayThreshold))
+		{
+			Gain = QueueDrainGain;
+		}
+
+		return FMath::Clamp(static_cast<int32>(FMath::Min(Gain * Bandwidth, double(MAX_int32))), Config.MinRate, Config.MaxRate);
+	}
+
+	/** Returns the estimated bottleneck bandwidth in bytes per second, or 0 if there is no estimate yet. */
+	double GetBandwidthEstimate() const
+	{
+		double MaxBandwidth = 0.0;
+		for (const double Bandwidth : BandwidthFilter)
+		{
+			MaxBandwidth = FMath::Max(MaxBandwidth, Bandwidth);
+		}
+		return MaxBandwidth;
+	}
+
+	/** Returns the minimum round trip time seen over the last MinRttWindowSeconds, or 0 if there is no sample yet. */
+	double GetMinRtt() const { return MinRtt; }
+
+	EMode GetMode() const { return Mode; }
+
+private:
+	struct FSentPacket
+	{
+		SequenceNumberT Seq;
+		int32 SizeInBytes = 0;
+		double SentTime = 0.0;
+		int64 DeliveredAtSend = 0;
+		double DeliveredTimeAtSend = 0.0;
+		bool bAppLimited = false;
+	};
+
+	void OnPacketDelivered(const FSentPacket& Packet, double TimeSeconds)
+	{
+		Delivered += Packet.SizeInBytes;
+		DeliveredTime = TimeSeconds;
+		++RoundDelivered;
+
+		const double Rtt = TimeSeconds - Packet.SentTime;
+		if (Rtt > 0.0 && (MinRtt <= 0.0 || Rtt <= MinRtt || TimeSeconds - MinRttStamp > MinRttWindowSeconds))
+		{
+			MinRtt = Rtt;
+			MinRttStamp = TimeSeconds;
+		}
+		if (Rtt > 0.0)
+		{
+			SmoothedRtt = (SmoothedRtt <= 0.0) ? Rtt : SmoothedRtt + (Rtt - SmoothedRtt) * 0.125;
+		}
+
+		// A round trip ends when a packet sent after the previous round ended is delivered
+		const bool bRoundStart = Packet.DeliveredAtSend >= NextRoundDelivered;
+		if (bRoundStart)
+		{
+			NextRoundDelivered = Delivered;
+			StartRound();
+		}
+
+		const double Interval = FMath::Max(TimeSeconds - Packet.DeliveredTimeAtSend, Rtt);
+		if (Interval > 0.0)
+		{
+			const double Bandwidth = double(Delivered - Packet.DeliveredAtSend) / Interval;
+			double& RoundBandwidth = BandwidthFilter[RoundCount % BandwidthWindowRounds];
+			if (!Packet.bAppLimited || Bandwidth > GetBandwidthEstimate())
+			{
+				RoundBandwidth = FMath::Max(RoundBandwidth, Bandwidth);
+			}
+		}
+
+		if (bRoundStart)
+		{
+			UpdateMode(TimeSeconds);
+		}
+
+		if (Mode == EMode::ProbeBandwidth && MinRtt > 0.0 && TimeSeconds - CycleStamp > MinRtt)
+		{
+			AdvanceCycle(TimeSeconds);
+		}
+	}
+
+	void OnPacketLost(const FSentPacket& Packet)
+	{
+		++RoundLost;
+	}
+
+	void StartRound()
+	{
+		const int32 RoundPackets = RoundDelivered + RoundLost;
+		const bool bLossy = RoundPackets > 0 && double(RoundLost) > LossThreshold * double(RoundPackets);
+
+		++RoundCount;
+		const double PreviousEstimate = GetBandwidthEstimate();
+		BandwidthFilter[RoundCount % BandwidthWindowRounds] = 0.0;
+
+		if (bLossy)
+		{
+			// Don't let older, loss free rounds keep the rate up
+			for (double& Bandwidth : BandwidthFilter)
+			{
+				Bandwidth = FMath::Min(Bandwidth, PreviousEstimate * LossBackoff);
+			}
+			BandwidthFilter[RoundCount % BandwidthWindowRounds] = PreviousEstimate * LossBackoff;
+
+			if (Mode == EMode::Startup)
+			{
+				EnterDrain();
+			}
+		}
+
+		RoundDelivered = 0;
+		RoundLost = 0;
+	}
+
+	void UpdateMode(double TimeSeconds)
+	{
+		if (Mode == EMode::Startup)
+		{
+			// Startup ends once the estimate stops growing by 25% per round for three rounds
+			const double Bandwidth = GetBandwidthEstimate();
+			if (Bandwidth >= FullBandwidth * 1.25)
+			{
+				FullBandwidth = Bandwidth;
+				FullBandwidthRounds = 0;
+			}
+			else if (++FullBandwidthRounds >= 3)
+			{
+				EnterDrain();
+			}
+		}
+		else if (Mode == EMode::Drain)
+		{
+			// One round at the drain gain empties the queue built during startup
+			Mode = EMode::ProbeBandwidth;
+			CycleIndex = 0;
+			CycleStamp = TimeSeconds;
+			PacingGain = ProbeGains[CycleIndex];
+		}
+	}
+
+	void EnterDrain()
+	{
+		Mode = EMode::Drain;
+		PacingGain = 1.0 / StartupGain;
+	}
+
+	void AdvanceCycle(double TimeSeconds)
+	{
+		CycleIndex = (CycleIndex + 1) % UE_ARRAY_COUNT(ProbeGains);
+		CycleStamp = TimeSeconds;
+		PacingGain = ProbeGains[CycleIndex];
+	}
+
+	static constexpr double ProbeGains[8] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+	FNetCongestionControlConfig Config;
+
+	/** Packets waiting for a notification, in sequence order */
+	TResizableCircularQueue<FSentPacket> SentPackets;
+
+	/** Maximum delivery rate per round, for the last BandwidthWindowRounds rounds */
+	double BandwidthFilter[BandwidthWindowRounds] = {};
+
+	EMode Mode = EMode::Startup;
+	double PacingGain = StartupGain;
+
+	int64 Delivered = 0;
+	double DeliveredTime = 0.0;
+
+	int64 NextRoundDelivered = 0;
+	int32 RoundCount = 0;
+	int32 RoundDelivered = 0;
+	int32 RoundLost = 0;
+
+	double FullBandwidth = 0.0;
+	int32 FullBandwidthRounds = 0;
+
+	double MinRtt = 0.0;
+	double MinRttStamp = 0.0;
+	double SmoothedRtt = 0.0;
+
+	int32 CycleIndex = 0;
+	double CycleStamp = 0.0;
+};
+
+/** The congestion controllers a connection can use, selected with net.CongestionControl. */
+enum class ENetCongestionControlType : uint8
+{
+	/** Drains QueuedBits at the fixed CurrentNetSpeed, the behavior without congestion control. */
+	FixedRate,
+
+	/** FNetBBRCongestionController */
+	BBR,
+};
+
+/** Value of net.CongestionControl, see ENetCongestionControlType. Read when a connection is opened. */
+extern ENGINE_API int32 GNetCongestionControlType;
+
+/**
+ * The congestion control state of a UNetConnection, so the connection only needs to forward its sends and notifications.
+ *
+ * The connection calls OnPacketSent for every packet it sends with a sequence number, OnPacketNotify from its
+ * FNetPacketNotify::Update functor, and DrainQueuedBits in place of draining QueuedBits by CurrentNetSpeed.
+ */
+class FNetConnectionCongestionControl
+{
+public:
+	using SequenceNumberT = INetCongestionController::SequenceNumberT;
+
+	/** Creates the controller selected by net.CongestionControl. Called when the connection is opened. */
+	void Init(const FNetCongestionControlConfig& Config)
+	{
+		Init(Config, static_cast<ENetCongestionControlType>(GNetCongestionControlType));
+	}
+
+	void Init(const FNetCongestionControlConfig& Config, ENetCongestionControlType Type)
+	{
+		switch (Type)
+		{
+		case ENetCongestionControlType::BBR:
+			Controller = MakeUnique<FNetBBRCongestionController>();
+			break;
+		default:
+			Controller = MakeUnique<FNetFixedRateCongestionController>();
+			break;
+		}
+
+		Controller->Reset(Config);
+	}
+
+	bool IsInitialized() const
+	{
+		return Controller.IsValid();
+	}
+
+	/** @see INetCongestionController::OnPacketSent */
+	void OnPacketSent(SequenceNumberT Seq, int32 SizeInBytes, double TimeSeconds, bool bAppLimited)
+	{
+		if (Controller.IsValid())
+		{
+			Controller->OnPacketSent(Seq, SizeInBytes, TimeSeconds, bAppLimited);
+		}
+	}
+
+	/** @see INetCongestionController::OnPacketNotify */
+	void OnPacketNotify(SequenceNumberT Seq, bool bDelivered, double TimeSeconds)
+	{
+		if (Controller.IsValid())
+		{
+			Controller->OnPacketNotify(Seq, bDelivered, TimeSeconds);
+		}
+	}
+
+	/**
+	 * Drains QueuedBits by the send budget for DeltaTime, allowing the connection to fall up to two ticks of budget behind
+	 * like the fixed rate drain does.
+	 *
+	 * @return	The send rate used, in bytes per second, for the connection to report as its CurrentNetSpeed
+	 */
+	int32 DrainQueuedBits(int32& QueuedBits, float DeltaTime) const
+	{
+		check(Controller.IsValid());
+
+		const int64 BudgetBits = Controller->GetSendBudgetBits(DeltaTime);
+		const int64 AllowedLag = 2 * BudgetBits;
+		QueuedBits = static_cast<int32>(FMath::Clamp(int64(QueuedBits) - BudgetBits, -AllowedLag, int64(MAX_int32)));
+		return Controller->GetSendRate();
+	}
+
+	const INetCongestionController* GetController() const
+	{
+		return Controller.Get();
+	}
+
+private:
+	TUniquePtr<INetCongestionController> Controller;
+};
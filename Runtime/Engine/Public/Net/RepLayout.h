@@ -1533,6 +1533,83 @@ public:
 	{
 		return PushModelProperties.IsValidIndex(Index) ? PushModelProperties[Index] : false;
 	}
+
+	/**
+	 * Builds the changelist of a layout with ERepLayoutFlags::FullPushProperties straight from its Push Model dirty state,
+	 * without comparing against the shadow state. Only valid if every change to those properties is marked dirty.
+	 *
+	 * Only the set bits of DirtyParentWords are visited, so the cost scales with the number of dirty properties.
+	 * Every command of a dirty parent is considered changed, which means a dirty struct sends all of its members.
+	 * Parents whose changelist can't be known without comparing (Custom Delta or nested Dynamic Arrays) are added
+	 * to OutParentsToCompare instead and still need the regular comparison.
+	 *
+	 * @param DirtyParentWords		Push Model dirty state of the object, one bit per parent.
+	 * @param OutChanged			Receives the handles of the trusted dirty parents, in ascending order and without the terminating 0.
+	 * @param OutParentsToCompare	Receives the indices of dirty parents that must still be compared.
+	 */
+	void BuildTrustedPushModelChangelist(TConstArrayView<uint32> DirtyParentWords, TArray<uint16>& OutChanged, TArray<int32>& OutParentsToCompare) const
+	{
+		for (int32 WordIndex = 0; WordIndex < DirtyParentWords.Num(); ++WordIndex)
+		{
+			for (uint32 Word = DirtyParentWords[WordIndex]; Word != 0; Word &= Word - 1)
+			{
+				const int32 ParentIndex = WordIndex * 32 + static_cast<int32>(FMath::CountTrailingZeros(Word));
+				if (!Parents.IsValidIndex(ParentIndex))
+				{
+					return;
+				}
+
+				const FRepParentCmd& Parent = Parents[ParentIndex];
+				if (!EnumHasAnyFlags(Parent.Flags, ERepParentFlags::IsLifetime))
+				{
+					continue;
+				}
+
+				if (EnumHasAnyFlags(Parent.Flags, ERepParentFlags::IsCustomDelta | ERepParentFlags::HasDynamicArrayProperties))
+				{
+					OutParentsToCompare.Add(ParentIndex);
+					continue;
+				}
+
+				for (int32 CmdIndex = Parent.CmdStart; CmdIndex < Parent.CmdEnd; ++CmdIndex)
+				{
+					const FRepLayoutCmd& Cmd = Cmds[CmdIndex];
+					if (Cmd.Type != ERepLayoutCmdType::Return)
+					{
+						OutChanged.Add(Cmd.RelativeHandle);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Validation for BuildTrustedPushModelChangelist: given the parents that a full comparison found changed, finds the
+	 * Push Model parents that changed without being marked dirty. Those changes would be lost if the dirty state were trusted.
+	 *
+	 * @param DirtyParentWords	Push Model dirty state of the object when the comparison was made, one bit per parent.
+	 * @param ChangedParents	Parents the full comparison found changed.
+	 * @param OutMissedParents	Receives the indices of the parents that are missing a MARK_PROPERTY_DIRTY.
+	 */
+	void FindMissedPushModelDirties(TConstArrayView<uint32> DirtyParentWords, const TBitArray<>& ChangedParents, TArray<int32>& OutMissedParents) const
+	{
+		for (TConstSetBitIterator<> It(ChangedParents); It; ++It)
+		{
+			const int32 ParentIndex = It.GetIndex();
+			const int32 WordIndex = ParentIndex / 32;
+			const bool bIsDirty = DirtyParentWords.IsValidIndex(WordIndex) && (DirtyParentWords[WordIndex] & (1U << (ParentIndex & 31))) != 0;
+			if (!bIsDirty && IsPushModelProperty(ParentIndex))
+			{
+				OutMissedParents.Add(ParentIndex);
+			}
+		}
+	}
+
+	/** Returns the name of a parent property, for reporting missed dirties. */
+	FName GetParentPropertyName(int32 ParentIndex) const
+	{
+		return Parents.IsValidIndex(ParentIndex) ? Parents[ParentIndex].CachedPropertyName : NAME_None;
+	}
 #endif
 
 	const uint16 GetCustomDeltaIndexFromPropertyRepIndex(const uint16 PropertyRepIndex) const;
@@ -4,8 +4,10 @@
 
 #include "Chaos/SpatialAccelerationFwd.h"
 #include "Engine/EngineTypes.h"
+#include "Engine/HitResult.h"
 #include "CollisionQueryParams.h"
 #include "WorldCollision.h"
+#include "SQBatchQuery.h"
 
 /** Generic interface for physics APIs in the engine. Some common functionality is defined here, but APIs can override behavior as needed. See FGenericPlatformMisc for a similar pattern */
 
@@ -19,6 +21,43 @@ struct FGenericPhysicsInterface
 	/** Trace a ray against the world and return the first blocking hit */
 	static ENGINE_API bool RaycastSingle(const UWorld* World, struct FHitResult& OutHit, const FVector Start, const FVector End, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, const FCollisionResponseParams& ResponseParams, const FCollisionObjectQueryParams& ObjectParams = FCollisionObjectQueryParams::DefaultObjectQueryParam);
 
+	/**
+	*  Trace a batch of rays against the world and return the first blocking hit of each, in the order the rays were given.
+	*  Every ray behaves exactly like a RaycastSingle call with the same parameters. The rays are traced in spatially
+	*  coherent order (see ChaosInterface::SortQueriesByLocality) so that consecutive rays revisit the same parts of the
+	*  acceleration structure. Rays run one after another since each one takes the scene lock and builds its own filter.
+	*  @return the number of rays with a blocking hit
+	*/
+	static int32 RaycastSingleBatch(const UWorld* World, TArrayView<FHitResult> OutHits, TConstArrayView<FVector> Starts, TConstArrayView<FVector> Ends, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, const FCollisionResponseParams& ResponseParams, const FCollisionObjectQueryParams& ObjectParams = FCollisionObjectQueryParams::DefaultObjectQueryParam)
+	{
+		check((OutHits.Num() == Starts.Num()) && (Ends.Num() == Starts.Num()));
+
+		TArray<FVector> Dirs;
+		TArray<float> DeltaMagnitudes;
+		Dirs.SetNumUninitialized(Starts.Num());
+		DeltaMagnitudes.SetNumUninitialized(Starts.Num());
+		for (int32 QueryIndex = 0; QueryIndex < Starts.Num(); ++QueryIndex)
+		{
+			const FVector Delta = Ends[QueryIndex] - Starts[QueryIndex];
+			DeltaMagnitudes[QueryIndex] = float(Delta.Size());
+			Dirs[QueryIndex] = Delta.GetSafeNormal();
+		}
+
+		TArray<int32> Order;
+		ChaosInterface::SortQueriesByLocality(Starts, Dirs, DeltaMagnitudes, Order);
+
+		int32 NumBlockingHits = 0;
+		for (const int32 QueryIndex : Order)
+		{
+			OutHits[QueryIndex] = FHitResult();
+			if (RaycastSingle(World, OutHits[QueryIndex], Starts[QueryIndex], Ends[QueryIndex], TraceChannel, Params, ResponseParams, ObjectParams))
+			{
+				++NumBlockingHits;
+			}
+		}
+		return NumBlockingHits;
+	}
+
 	/**
 	*  Trace a ray against the world and return touching hits and then first blocking hit
 	*  Results are sorted, so a blocking hit (if found) will be the last element of the array
@@ -0,0 +1,147 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Net/NetCongestionControl.h"
+
+namespace UE::Net
+{
+
+/** The path simulated by FNetCongestionControlSimulation */
+struct FNetCongestionControlSimulationParams
+{
+	/** Rate at which the bottleneck link forwards packets, in bytes per second */
+	double BottleneckRate = 80000.0;
+
+	/** Round trip time without any queueing, in seconds */
+	double BaseRtt = 0.08;
+
+	/** Packets that would wait longer than this in the bottleneck queue are dropped (drop tail), in seconds */
+	double MaxQueueDelay = 0.2;
+
+	int32 PacketSizeInBytes = 1200;
+	double TickRate = 60.0;
+	double Duration = 30.0;
+
+	/** Results only cover packets sent after this, so that the startup phase doesn't count, in seconds */
+	double MeasureAfter = 10.0;
+};
+
+struct FNetCongestionControlSimulationResult
+{
+	/** Final send rate of the controller, in bytes per second */
+	int32 SendRate = 0;
+
+	/** Average and maximum time packets spent in the bottleneck queue, in seconds */
+	double AverageQueueDelay = 0.0;
+	double MaxQueueDelay = 0.0;
+
+	/** Fraction of packets dropped by the bottleneck */
+	double LossRate = 0.0;
+
+	/** Bytes per second that made it through the bottleneck, as a fraction of its rate */
+	double Utilization = 0.0;
+};
+
+/**
+ * Deterministic simulation of a connection that always has data to send, going through a single bottleneck link.
+ *
+ * The connection is modeled the way UNetConnection uses FNetConnectionCongestionControl: every tick QueuedBits is drained
+ * by DrainQueuedBits and packets are sent while QueuedBits isn't positive. Delivery notifications arrive in sequence
+ * order one base round trip after the packet left the bottleneck, or after it was dropped.
+ *
+ * Used by the congestion control tests to check that a controller fills the bottleneck without building a standing queue.
+ */
+class FNetCongestionControlSimulation
+{
+public:
+	static FNetCongestionControlSimulationResult Run(ENetCongestionControlType Type, const FNetCongestionControlConfig& Config, const FNetCongestionControlSimulationParams& Params)
+	{
+		using SequenceNumberT = FNetConnectionCongestionControl::SequenceNumberT;
+
+		struct FPendingNotify
+		{
+			double Time = 0.0;
+			SequenceNumberT Seq;
+			bool bDelivered = false;
+		};
+
+		FNetConnectionCongestionControl CongestionControl;
+		CongestionControl.Init(Config, Type);
+
+		TResizableCircularQueue<FPendingNotify> PendingNotifies;
+		SequenceNumberT Seq;
+		int32 QueuedBits = 0;
+		double LinkFreeTime = 0.0;
+		double LastNotifyTime = 0.0;
+
+		int64 MeasuredPackets = 0;
+		int64 MeasuredLost = 0;
+		double TotalQueueDelay = 0.0;
+
+		FNetCongestionControlSimulationResult Result;
+
+		const double DeltaTime = 1.0 / Params.TickRate;
+		const int32 TickCount = static_cast<int32>(Params.Duration * Params.TickRate);
+		for (int32 TickIt = 0; TickIt < TickCount; ++TickIt)
+		{
+			const double Time = TickIt * DeltaTime;
+
+			while (!PendingNotifies.IsEmpty() && PendingNotifies.Peek().Time <= Time)
+			{
+				const FPendingNotify& Notify = PendingNotifies.Peek();
+				CongestionControl.OnPacketNotify(Notify.Seq, Notify.bDelivered, Notify.Time);
+				PendingNotifies.Pop();
+			}
+
+			Result.SendRate = CongestionControl.DrainQueuedBits(QueuedBits, static_cast<float>(DeltaTime));
+
+			while (QueuedBits <= 0)
+			{
+				QueuedBits += Params.PacketSizeInBytes * 8;
+				CongestionControl.OnPacketSent(Seq, Params.PacketSizeInBytes, Time, false);
+
+				const double QueueStart = FMath::Max(Time, LinkFreeTime);
+				const double QueueDelay = QueueStart - Time;
+				const bool bDropped = QueueDelay > Params.MaxQueueDelay;
+				if (!bDropped)
+				{
+					LinkFreeTime = QueueStart + Params.PacketSizeInBytes / Params.BottleneckRate;
+				}
+
+				if (Time >= Params.MeasureAfter)
+				{
+					++MeasuredPackets;
+					MeasuredLost += bDropped ? 1 : 0;
+					TotalQueueDelay += bDropped ? 0.0 : QueueDelay;
+					Result.MaxQueueDelay = bDropped ? Result.MaxQueueDelay : FMath::Max(Result.MaxQueueDelay, QueueDelay);
+				}
+
+				// Notifications can't overtake each other
+				LastNotifyTime = FMath::Max(LastNotifyTime, (bDropped ? Time : LinkFreeTime) + Params.BaseRtt);
+				PendingNotifies.Enqueue(FPendingNotify{LastNotifyTime, Seq, !bDropped});
+				++Seq;
+			}
+		}
+
+		const int64 MeasuredDelivered = MeasuredPackets - MeasuredLost;
+		if (MeasuredPackets > 0)
+		{
+			Result.LossRate = double(MeasuredLost) / double(MeasuredPackets);
+		}
+		if (MeasuredDelivered > 0)
+		{
+			Result.AverageQueueDelay = TotalQueueDelay / double(MeasuredDelivered);
+		}
+
+		const double MeasuredDuration = Params.Duration - Params.MeasureAfter;
+		if (MeasuredDuration > 0.0)
+		{
+			Result.Utilization = double(MeasuredDelivered * Params.PacketSizeInBytes) / (MeasuredDuration * Params.BottleneckRate);
+		}
+
+		return Result;
+	}
+};
+
+}
@@ -5,6 +5,7 @@
 #include "Chaos/Collision/CollisionContext.h"
 #include "Chaos/Collision/CollisionFilter.h"
 #include "Chaos/Collision/StatsData.h"
+#include "Chaos/Collision/SweepAndPrune.h"
 #include "Chaos/ISpatialAccelerationCollection.h"
 #include "Chaos/ParticleHandleFwd.h"
 #include "Chaos/ParticleHandle.h"
@@ -295,6 +296,18 @@ namespace Chaos
 		};
 	}
 
+	/**
+	 * How FSpatialAccelerationBroadPhase finds overlapping particle pairs
+	 */
+	enum class EBroadPhaseType : uint8
+	{
+		// Query the spatial acceleration structure for every awake dynamic and moving kinematic each tick
+		SpatialAcceleration,
+
+		// Keep a persistent sweep-and-prune over all particles and only update the particles that moved (see FPersistentSweepAndPrune)
+		PersistentSweepAndPrune,
+	};
+
 	/**
 	 * A broad phase that iterates over particle and uses a spatial acceleration structure to output
 	 * potentially overlapping SpatialAccelerationHandles.
@@ -309,6 +322,8 @@ namespace Chaos
 			, SpatialAcceleration(nullptr)
 			, NumActiveBroadphaseContexts(0)
 			, bNeedsResim(false)
+			, BroadPhaseType(EBroadPhaseType::SpatialAcceleration)
+			, bSweepAndPruneNeedsFullSync(true)
 		{
 		}
 
@@ -317,6 +332,55 @@ namespace Chaos
 			SpatialAcceleration = InSpatialAcceleration;
 		}
 
+		/**
+		 * Select how overlapping pairs are found. The persistent sweep-and-prune is dropped when switching away from it
+		 * and rebuilt from scratch on the first tick after switching to it.
+		 */
+		void SetBroadPhaseType(const EBroadPhaseType InBroadPhaseType)
+		{
+			if (InBroadPhaseType != BroadPhaseType)
+			{
+				BroadPhaseType = InBroadPhaseType;
+				SweepAndPrune = Private::FPersistentSweepAndPrune();
+				SweepAndPruneProxies.Reset();
+				SweepAndPruneUnbounded.Reset();
+				SweepAndPruneDirtyParticles.Reset();
+				SweepAndPruneRemovedParticles.Reset();
+				PersistentPairs.Reset();
+				PersistentPairIndices.Reset();
+				bSweepAndPruneNeedsFullSync = true;
+			}
+		}
+
+		/**
+		 * Notify the persistent sweep-and-prune that a particle was added, enabled or had its bounds changed outside of
+		 * the simulation (e.g., teleported). Awake dynamics and moving kinematics are picked up every tick anyway.
+		 */
+		void MarkParticleDirty(FGeometryParticleHandle* Particle)
+		{
+			if (BroadPhaseType == EBroadPhaseType::PersistentSweepAndPrune)
+			{
+				SweepAndPruneDirtyParticles.Add(Particle);
+			}
+		}
+
+		/**
+		 * Notify the persistent sweep-and-prune that a particle was disabled or destroyed. The particle is not dereferenced.
+		 */
+		void RemoveParticle(FGeometryParticleHandle* Particle)
+		{
+			if (BroadPhaseType == EBroadPhaseType::PersistentSweepAndPrune)
+			{
+				SweepAndPruneDirtyParticles.Remove(Particle);
+				SweepAndPruneRemovedParticles.Add(Particle);
+			}
+		}
+
+		EBroadPhaseType GetBroadPhaseType() const
+		{
+			return BroadPhaseType;
+		}
+
 		/**
 		 * Generate all overlapping pairs and spawn a midphase object to handle collisions for each of them
 		 */
@@ -326,15 +390,18 @@ namespace Chaos
 			const FCollisionDetectorSettings& Settings,
 			IResimCacheBase* ResimCache)
 		{
+			bNeedsResim = ResimCache && ResimCache->IsResimming();
+
+			// The persistent pairs are only valid for the forward simulation. Resim only visits desynced particles
+			// and uses the spatial acceleration.
+			const bool bUsePersistentPairs = (BroadPhaseType == EBroadPhaseType::PersistentSweepAndPrune) && !bNeedsResim;
 
-			if (!ensure(SpatialAcceleration))
+			if (!bUsePersistentPairs && !ensure(SpatialAcceleration))
 			{
 				// Must call SetSpatialAcceleration
 				return;
 			}
 
-			bNeedsResim = ResimCache && ResimCache->IsResimming();
-
 			// Reset stats
 			NumBroadPhasePairs = 0;
 			NumMidPhases = 0;
@@ -342,7 +409,11 @@ namespace Chaos
 			{
 				SCOPE_CYCLE_COUNTER(STAT_Collisions_SpatialBroadPhase);
 
-				if (const auto AABBTree = SpatialAcceleration->template As<TAABBTree<FAccelerationStructureHandle, TAABBTreeLeafArray<FAccelerationStructureHandle>>>())
+				if (bUsePersistentPairs)
+				{
+					ProducePersistentOverlaps(Allocator, Settings);
+				}
+				else if (const auto AABBTree = SpatialAcceleration->template As<TAABBTree<FAccelerationStructureHandle, TAABBTreeLeafArray<FAccelerationStructureHandle>>>())
 				{
 					ProduceOverlaps(Dt, *AABBTree, Allocator, Settings, ResimCache);
 				}
@@ -543,6 +614,239 @@ namespace Chaos
 
 	private:
 
+		// Bring the persistent sweep-and-prune up to date and distribute its pairs over the broadphase contexts
+		void ProducePersistentOverlaps(Private::FCollisionConstraintAllocator* Allocator, const FCollisionDetectorSettings& Settings)
+		{
+			CSV_SCOPED_TIMING_STAT(PhysicsVerbose, DetectCollisions_SweepAndPrune);
+
+			SyncSweepAndPruneProxies();
+			SweepAndPrune.UpdatePairs(!bDisableCollisionParallelFor);
+			UpdatePersistentPairs();
+
+			// Gather the pairs that have at least one awake dynamic or moving kinematic. Pairs of sleeping and static
+			// particles are kept in the sweep-and-prune but do not need a midphase.
+			PersistentOverlaps.Reset();
+			for (const FPersistentPair& Pair : PersistentPairs)
+			{
+				AddPersistentOverlap(Pair.Particle0, Pair.Particle1);
+			}
+
+			// Particles without bounds overlap everything that moves, and each other
+			for (int32 UnboundedIndex = 0; UnboundedIndex < SweepAndPruneUnbounded.Num(); ++UnboundedIndex)
+			{
+				FGeometryParticleHandle* UnboundedParticle = SweepAndPruneUnbounded[UnboundedIndex];
+				for (auto& Particle : Particles.GetActiveDynamicMovingKinematicParticlesView())
+				{
+					if (Particle.Handle()->HasBounds())
+					{
+						AddPersistentOverlap(Particle.Handle(), UnboundedParticle);
+					}
+				}
+				for (int32 OtherIndex = UnboundedIndex + 1; OtherIndex < SweepAndPruneUnbounded.Num(); ++OtherIndex)
+				{
+					AddPersistentOverlap(UnboundedParticle, SweepAndPruneUnbounded[OtherIndex]);
+				}
+			}
+
+			// Split the overlaps into contexts so that midphase assignment and the narrowphase still run in parallel
+			const int32 MinOverlapsPerContext = 64;
+			const int32 MaxContexts = bDisableCollisionParallelFor ? 1 : FMath::Max(1, MaxNumWorkers);
+			const int32 NumContexts = FMath::Clamp(FMath::DivideAndRoundUp(PersistentOverlaps.Num(), MinOverlapsPerContext), 1, MaxContexts);
+			const int32 NumOverlapsPerContext = FMath::DivideAndRoundUp(PersistentOverlaps.Num(), NumContexts);
+
+			for (Private::FBroadPhaseContext& BroadphaseContext : BroadphaseContexts)
+			{
+				BroadphaseContext.Reset();
+			}
+			if (BroadphaseContexts.Num() < NumContexts)
+			{
+				BroadphaseContexts.SetNum(NumContexts);
+			}
+			NumActiveBroadphaseContexts = NumContexts;
+			Allocator->SetMaxContexts(NumContexts);
+
+			for (int32 ContextIndex = 0; ContextIndex < NumContexts; ++ContextIndex)
+			{
+				Private::FBroadPhaseContext& BroadphaseContext = BroadphaseContexts[ContextIndex];
+				BroadphaseContext.CollisionContext.SetSettings(Settings);
+				BroadphaseContext.CollisionContext.SetAllocator(Allocator->GetContextAllocator(ContextIndex));
+
+				const int32 BeginIndex = FMath::Min(ContextIndex * NumOverlapsPerContext, PersistentOverlaps.Num());
+				const int32 EndIndex = FMath::Min(BeginIndex + NumOverlapsPerContext, PersistentOverlaps.Num());
+				BroadphaseContext.Overlaps.Append(PersistentOverlaps.GetData() + BeginIndex, EndIndex - BeginIndex);
+			}
+		}
+
+		// Apply the sweep-and-prune's removed and added pairs to the persistent pair list. A removed pair is no longer
+		// emitted, so its midphase is not refreshed and gets destroyed by the allocator's pruning at the end of this
+		// tick. An added pair gets its midphase created by the context that processes it.
+		void UpdatePersistentPairs()
+		{
+			for (const Private::FPersistentSweepAndPrune::FPairKey Key : SweepAndPrune.GetRemovedPairs())
+			{
+				int32 PairIndex = INDEX_NONE;
+				if (PersistentPairIndices.RemoveAndCopyValue(Key, PairIndex))
+				{
+					PersistentPairs.RemoveAtSwap(PairIndex, EAllowShrinking::No);
+					if (PairIndex < PersistentPairs.Num())
+					{
+						PersistentPairIndices[PersistentPairs[PairIndex].Key] = PairIndex;
+					}
+				}
+			}
+
+			for (const Private::FPersistentSweepAndPrune::FPairKey Key : SweepAndPrune.GetAddedPairs())
+			{
+				PersistentPairIndices.Add(Key, PersistentPairs.Num());
+				PersistentPairs.Add(
+				{
+					static_cast<FGeometryParticleHandle*>(SweepAndPrune.GetUserData(Private::FPersistentSweepAndPrune::GetPairProxyA(Key))),
+					static_cast<FGeometryParticleHandle*>(SweepAndPrune.GetUserData(Private::FPersistentSweepAndPrune::GetPairProxyB(Key))),
+					Key
+				});
+			}
+		}
+
+		// Add, update or remove the proxy of a particle that is known to be enabled
+		void UpdateSweepAndPruneProxy(FGeometryParticleHandle* ParticleHandle)
+		{
+			FSweepAndPruneProxy& Proxy = SweepAndPruneProxies.FindOrAdd(ParticleHandle);
+			if (ParticleHandle->HasBounds())
+			{
+				if (Proxy.ProxyId == INDEX_NONE)
+				{
+					Proxy.ProxyId = SweepAndPrune.AddProxy(ParticleHandle->WorldSpaceInflatedBounds(), ParticleHandle);
+					if (Proxy.bUnbounded)
+					{
+						SweepAndPruneUnbounded.RemoveSingleSwap(ParticleHandle, EAllowShrinking::No);
+						Proxy.bUnbounded = false;
+					}
+				}
+				else
+				{
+					SweepAndPrune.UpdateProxy(Proxy.ProxyId, ParticleHandle->WorldSpaceInflatedBounds());
+				}
+			}
+			else
+			{
+				if (Proxy.ProxyId != INDEX_NONE)
+				{
+					SweepAndPrune.RemoveProxy(Proxy.ProxyId);
+					Proxy.ProxyId = INDEX_NONE;
+				}
+				if (!Proxy.bUnbounded)
+				{
+					SweepAndPruneUnbounded.Add(ParticleHandle);
+					Proxy.bUnbounded = true;
+				}
+			}
+		}
+
+		void RemoveSweepAndPruneProxy(const FGeometryParticleHandle* ParticleHandle)
+		{
+			FSweepAndPruneProxy Proxy;
+			if (SweepAndPruneProxies.RemoveAndCopyValue(ParticleHandle, Proxy))
+			{
+				if (Proxy.ProxyId != INDEX_NONE)
+				{
+					SweepAndPrune.RemoveProxy(Proxy.ProxyId);
+				}
+				if (Proxy.bUnbounded)
+				{
+					// Keep the order of the remaining unbounded particles independent of the order of removal
+					SweepAndPruneUnbounded.RemoveSingle(const_cast<FGeometryParticleHandle*>(ParticleHandle));
+				}
+			}
+		}
+
+		// Feed the particles that may have moved into the sweep-and-prune: removed and dirty particles reported by the
+		// evolution, plus awake dynamics and moving kinematics. Proxies whose bounds stay within their fattened bounds
+		// do not touch the sweep-and-prune. Only the first tick after enabling the persistent mode visits every particle.
+		void SyncSweepAndPruneProxies()
+		{
+			if (bSweepAndPruneNeedsFullSync)
+			{
+				bSweepAndPruneNeedsFullSync = false;
+				SweepAndPruneDirtyParticles.Reset();
+				SweepAndPruneRemovedParticles.Reset();
+				for (auto& Particle : Particles.GetNonDisabledView())
+				{
+					UpdateSweepAndPruneProxy(Particle.Handle());
+				}
+				return;
+			}
+
+			// The sets are keyed by pointer, so sort them before feeding the sweep-and-prune to keep proxy ids and pair order
+			// deterministic. Removed particles may be destroyed already and are sorted by proxy id instead of particle id.
+			SweepAndPruneRemovedParticles.Sort([this](const FGeometryParticleHandle& A, const FGeometryParticleHandle& B)
+			{
+				const FSweepAndPruneProxy* ProxyA = SweepAndPruneProxies.Find(&A);
+				const FSweepAndPruneProxy* ProxyB = SweepAndPruneProxies.Find(&B);
+				return (ProxyA ? ProxyA->ProxyId : INDEX_NONE) < (ProxyB ? ProxyB->ProxyId : INDEX_NONE);
+			});
+			SweepAndPruneDirtyParticles.Sort([](const FGeometryParticleHandle& A, const FGeometryParticleHandle& B)
+			{
+				return A.UniqueIdx() < B.UniqueIdx();
+			});
+
+			// Removals first: a particle disabled and enabled again in the same tick is both removed and dirty
+			for (const FGeometryParticleHandle* ParticleHandle : SweepAndPruneRemovedParticles)
+			{
+				RemoveSweepAndPruneProxy(ParticleHandle);
+			}
+			SweepAndPruneRemovedParticles.Reset();
+
+			for (FGeometryParticleHandle* ParticleHandle : SweepAndPruneDirtyParticles)
+			{
+				UpdateSweepAndPruneProxy(ParticleHandle);
+			}
+			SweepAndPruneDirtyParticles.Reset();
+
+			for (auto& Particle : Particles.GetActiveDynamicMovingKinematicParticlesView())
+			{
+				UpdateSweepAndPruneProxy(Particle.Handle());
+			}
+		}
+
+		// Rank particles by how much they drive collision detection: awake dynamic, moving kinematic, sleeping dynamic, other
+		static int32 GetPersistentOverlapRank(const FGeometryParticleHandle* Particle)
+		{
+			if (const FPBDRigidParticleHandle* Rigid = Particle->CastToRigidParticle())
+			{
+				if (Rigid->IsDynamic())
+				{
+					return Rigid->IsSleeping() ? 1 : 3;
+				}
+				if (Rigid->IsMovingKinematic())
+				{
+					return 2;
+				}
+			}
+			return 0;
+		}
+
+		// Add the pair in the order the non-resim filter in ParticlePairCollisionAllowed expects from the outer loop
+		// of the spatial acceleration path, i.e. with the particle that would have been the query particle first
+		void AddPersistentOverlap(FGeometryParticleHandle* Particle0, FGeometryParticleHandle* Particle1)
+		{
+			const int32 Rank0 = GetPersistentOverlapRank(Particle0);
+			const int32 Rank1 = GetPersistentOverlapRank(Particle1);
+			if (FMath::Max(Rank0, Rank1) < 2)
+			{
+				return;
+			}
+
+			const bool bSwap = (Rank1 > Rank0) || ((Rank1 == Rank0) && !AreParticlesInPreferredOrder(Particle0, Particle1));
+			if (bSwap)
+			{
+				PersistentOverlaps.Emplace(Particle1, Particle0, 0);
+			}
+			else
+			{
+				PersistentOverlaps.Emplace(Particle0, Particle1, 0);
+			}
+		}
+
 		// Generate the set of particles that overlap the specified particle and are allowed to collide with it
 		template<bool bOnlyRigid, typename T_SPATIALACCELERATION>
 		void ProduceParticleOverlaps(
@@ -778,6 +1082,30 @@ namespace Chaos
 
 		int32 NumBroadPhasePairs;
 		int32 NumMidPhases;
+
+		struct FSweepAndPruneProxy
+		{
+			int32 ProxyId = INDEX_NONE;
+			bool bUnbounded = false;
+		};
+
+		struct FPersistentPair
+		{
+			FGeometryParticleHandle* Particle0;
+			FGeometryParticleHandle* Particle1;
+			Private::FPersistentSweepAndPrune::FPairKey Key;
+		};
+
+		EBroadPhaseType BroadPhaseType;
+		Private::FPersistentSweepAndPrune SweepAndPrune;
+		TMap<const FGeometryParticleHandle*, FSweepAndPruneProxy> SweepAndPruneProxies;
+		TArray<FGeometryParticleHandle*> SweepAndPruneUnbounded;
+		TSet<FGeometryParticleHandle*> SweepAndPruneDirtyParticles;
+		TSet<const FGeometryParticleHandle*> SweepAndPruneRemovedParticles;
+		TArray<FPersistentPair> PersistentPairs;
+		TMap<Private::FPersistentSweepAndPrune::FPairKey, int32> PersistentPairIndices;
+		TArray<Private::FBroadPhaseOverlap> PersistentOverlaps;
+		bool bSweepAndPruneNeedsFullSync;
 	};
 
 }
@@ -0,0 +1,379 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Chaos/AABB.h"
+#include "Chaos/Core.h"
+#include "Chaos/Framework/Parallel.h"
+#include "Algo/Sort.h"
+#include "Containers/Set.h"
+
+namespace Chaos::Private
+{
+	/**
+	 * A persistent, incremental 3-axis sweep-and-prune.
+	 *
+	 * Each proxy stores fattened bounds, and a proxy only counts as moved when its tight bounds leave the fat bounds, so
+	 * resting and slowly moving objects cost nothing per update. The endpoints of each axis are kept sorted from one
+	 * update to the next and only the endpoints of moved proxies are shifted into place, so the cost of an update scales
+	 * with the amount of motion rather than with the number of proxies.
+	 *
+	 * The set of overlapping pairs persists between updates and every update reports the pairs that were added and
+	 * removed. Endpoint swaps on any axis only nominate pairs for re-evaluation; the final state of a nominated pair
+	 * is decided by a full 3D test of the fat bounds, which lets the three axes be processed in parallel.
+	 */
+	class FPersistentSweepAndPrune
+	{
+	public:
+		using FPairKey = uint64;
+
+		FPersistentSweepAndPrune(const FReal InFatMargin = FReal(2))
+			: FatMargin(InFatMargin)
+		{
+		}
+
+		static FPairKey MakePairKey(const int32 ProxyIdA, const int32 ProxyIdB)
+		{
+			const uint32 Lo = uint32(FMath::Min(ProxyIdA, ProxyIdB));
+			const uint32 Hi = uint32(FMath::Max(ProxyIdA, ProxyIdB));
+			return (uint64(Hi) << 32) | uint64(Lo);
+		}
+
+		static int32 GetPairProxyA(const FPairKey Key) { return int32(Key & 0xFFFFFFFF); }
+		static int32 GetPairProxyB(const FPairKey Key) { return int32(Key >> 32); }
+
+		void SetFatMargin(const FReal InFatMargin) { FatMargin = InFatMargin; }
+
+		int32 GetNumProxies() const { return Proxies.Num() - FreeProxies.Num(); }
+
+		/** Adds a proxy. Its overlaps are reported by the next UpdatePairs. */
+		int32 AddProxy(const FAABB3& Bounds, void* UserData)
+		{
+			const int32 ProxyId = FreeProxies.Num() ? FreeProxies.Pop(EAllowShrinking::No) : Proxies.AddDefaulted();
+			FProxy& Proxy = Proxies[ProxyId];
+			Proxy.FatBounds = Fatten(Bounds);
+			Proxy.UserData = UserData;
+			Proxy.bValid = true;
+			Proxy.bMoved = true;
+
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Proxy.Endpoints[Axis][0] = Endpoints[Axis].Add({ Proxy.FatBounds.Min()[Axis], ProxyId, false });
+				Proxy.Endpoints[Axis][1] = Endpoints[Axis].Add({ Proxy.FatBounds.Max()[Axis], ProxyId, true });
+			}
+			MovedProxies.Add(ProxyId);
+			bNeedsRebuild |= (MovedProxies.Num() > RebuildThreshold());
+			return ProxyId;
+		}
+
+		/** Removes a proxy and reports all of its pairs as removed by the next UpdatePairs. */
+		void RemoveProxy(const int32 ProxyId)
+		{
+			FProxy& Proxy = Proxies[ProxyId];
+			check(Proxy.bValid);
+			Proxy.bValid = false;
+			Proxy.UserData = nullptr;
+
+			// Park the endpoints at +infinity so they sift to the end, crossing every partner, and get trimmed
+			Proxy.FatBounds = FAABB3(FVec3(TNumericLimits<FReal>::Max()), FVec3(TNumericLimits<FReal>::Max()));
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Endpoints[Axis][Proxy.Endpoints[Axis][0]].Value = TNumericLimits<FReal>::Max();
+				Endpoints[Axis][Proxy.Endpoints[Axis][1]].Value = TNumericLimits<FReal>::Max();
+			}
+			// The proxy may already be queued by AddProxy or UpdateProxy in this update
+			if (!Proxy.bMoved)
+			{
+				Proxy.bMoved = true;
+				MovedProxies.Add(ProxyId);
+				bNeedsRebuild |= (MovedProxies.Num() > RebuildThreshold());
+			}
+			RemovedProxies.Add(ProxyId);
+		}
+
+		/**
+		 * Updates the bounds of a proxy. Nothing happens while Bounds stays within the fat bounds.
+		 * @return whether the proxy was marked as moved
+		 */
+		bool UpdateProxy(const int32 ProxyId, const FAABB3& Bounds)
+		{
+			FProxy& Proxy = Proxies[ProxyId];
+			check(Proxy.bValid);
+			if (Proxy.FatBounds.Contains(Bounds.Min()) && Proxy.FatBounds.Contains(Bounds.Max()))
+			{
+				return false;
+			}
+
+			Proxy.FatBounds = Fatten(Bounds);
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Endpoints[Axis][Proxy.Endpoints[Axis][0]].Value = Proxy.FatBounds.Min()[Axis];
+				Endpoints[Axis][Proxy.Endpoints[Axis][1]].Value = Proxy.FatBounds.Max()[Axis];
+			}
+			if (!Proxy.bMoved)
+			{
+				Proxy.bMoved = true;
+				MovedProxies.Add(ProxyId);
+				bNeedsRebuild |= (MovedProxies.Num() > RebuildThreshold());
+			}
+			return true;
+		}
+
+		void* GetUserData(const int32 ProxyId) const { return Proxies[ProxyId].UserData; }
+
+		const FAABB3& GetFatBounds(const int32 ProxyId) const { return Proxies[ProxyId].FatBounds; }
+
+		/**
+		 * Brings the endpoint arrays and the pair set up to date with all proxy changes since the last call and fills
+		 * the added and removed pair lists. When a large fraction of the proxies moved, the axes are re-sorted from
+		 * scratch instead (in parallel, one task per axis).
+		 */
+		void UpdatePairs(const bool bAllowParallel = true)
+		{
+			AddedPairs.Reset();
+			RemovedPairs.Reset();
+
+			if (bNeedsRebuild)
+			{
+				Rebuild(bAllowParallel);
+			}
+			else if (MovedProxies.Num() > 0)
+			{
+				UpdateIncremental(bAllowParallel);
+			}
+
+			for (const int32 ProxyId : MovedProxies)
+			{
+				Proxies[ProxyId].bMoved = false;
+			}
+			MovedProxies.Reset();
+
+			ReleaseRemovedProxies();
+		}
+
+		const TSet<FPairKey>& GetPairs() const { return Pairs; }
+		TConstArrayView<FPairKey> GetAddedPairs() const { return AddedPairs; }
+		TConstArrayView<FPairKey> GetRemovedPairs() const { return RemovedPairs; }
+
+	private:
+		struct FEndpoint
+		{
+			FReal Value;
+			int32 ProxyId;
+			bool bIsMax;
+
+			bool operator<(const FEndpoint& Other) const
+			{
+				// Min before Max at equal values so that touching bounds count as overlapping
+				return (Value < Other.Value) || ((Value == Other.Value) && !bIsMax && Other.bIsMax);
+			}
+		};
+
+		struct FProxy
+		{
+			FAABB3 FatBounds;
+			void* UserData = nullptr;
+			int32 Endpoints[3][2] = {};
+			bool bValid = false;
+			bool bMoved = false;
+		};
+
+		FAABB3 Fatten(const FAABB3& Bounds) const
+		{
+			return FAABB3(Bounds.Min() - FVec3(FatMargin), Bounds.Max() + FVec3(FatMargin));
+		}
+
+		int32 RebuildThreshold() const
+		{
+			return FMath::Max(64, GetNumProxies() / 4);
+		}
+
+		bool ArePairable(const int32 ProxyIdA, const int32 ProxyIdB) const
+		{
+			const FProxy& A = Proxies[ProxyIdA];
+			const FProxy& B = Proxies[ProxyIdB];
+			return (ProxyIdA != ProxyIdB) && A.bValid && B.bValid && A.FatBounds.Intersects(B.FatBounds);
+		}
+
+		void SetEndpoint(const int32 Axis, const int32 Index, const FEndpoint& Endpoint)
+		{
+			Endpoints[Axis][Index] = Endpoint;
+			Proxies[Endpoint.ProxyId].Endpoints[Axis][Endpoint.bIsMax ? 1 : 0] = Index;
+		}
+
+		// Shift one endpoint into place, nominating every proxy whose endpoint it crosses for re-evaluation
+		// @return whether the endpoint moved
+		bool SiftEndpoint(const int32 Axis, int32 Index, TArray<FPairKey>& OutCandidates)
+		{
+			TArray<FEndpoint>& AxisEndpoints = Endpoints[Axis];
+			const FEndpoint Endpoint = AxisEndpoints[Index];
+			const int32 StartIndex = Index;
+
+			while ((Index > 0) && (Endpoint < AxisEndpoints[Index - 1]))
+			{
+				const FEndpoint& Other = AxisEndpoints[Index - 1];
+				if (Endpoint.bIsMax != Other.bIsMax)
+				{
+					OutCandidates.Add(MakePairKey(Endpoint.ProxyId, Other.ProxyId));
+				}
+				SetEndpoint(Axis, Index, Other);
+				--Index;
+			}
+			while ((Index < AxisEndpoints.Num() - 1) && (AxisEndpoints[Index + 1] < Endpoint))
+			{
+				const FEndpoint& Other = AxisEndpoints[Index + 1];
+				if (Endpoint.bIsMax != Other.bIsMax)
+				{
+					OutCandidates.Add(MakePairKey(Endpoint.ProxyId, Other.ProxyId));
+				}
+				SetEndpoint(Axis, Index, Other);
+				++Index;
+			}
+			SetEndpoint(Axis, Index, Endpoint);
+			return Index != StartIndex;
+		}
+
+		void UpdateIncremental(const bool bAllowParallel)
+		{
+			TArray<FPairKey> AxisCandidates[3];
+			PhysicsParallelFor(3, [this, &AxisCandidates](const int32 Axis)
+			{
+				// Only swaps involving a moved endpoint ever happen, so the unmoved endpoints keep their sorted relative
+				// order. A moved endpoint can stop early against another moved endpoint that has not been placed yet,
+				// so repeat until a pass moves nothing, at which point every adjacent pair is in order.
+				bool bAnyMoved = true;
+				while (bAnyMoved)
+				{
+					bAnyMoved = false;
+					for (const int32 ProxyId : MovedProxies)
+					{
+						// Re-read the indices for each sift since other moved endpoints may have shifted them
+						bAnyMoved |= SiftEndpoint(Axis, Proxies[ProxyId].Endpoints[Axis][0], AxisCandidates[Axis]);
+						bAnyMoved |= SiftEndpoint(Axis, Proxies[ProxyId].Endpoints[Axis][1], AxisCandidates[Axis]);
+					}
+				}
+			}, !bAllowParallel);
+
+			// Overlap on all three axes can only start or stop when two endpoints swap on one of them, so the crossed
+			// pairs are the only candidates. Removed proxies sift to +infinity and so cross all of their partners.
+			TSet<FPairKey> Visited;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				for (const FPairKey Key : AxisCandidates[Axis])
+				{
+					bool bAlreadyVisited = false;
+					Visited.Add(Key, &bAlreadyVisited);
+					if (!bAlreadyVisited)
+					{
+						EvaluatePair(Key);
+					}
+				}
+			}
+		}
+
+		void EvaluatePair(const FPairKey Key)
+		{
+			const bool bOverlap = ArePairable(GetPairProxyA(Key), GetPairProxyB(Key));
+			if (bOverlap)
+			{
+				bool bAlreadyInSet = false;
+				Pairs.Add(Key, &bAlreadyInSet);
+				if (!bAlreadyInSet)
+				{
+					AddedPairs.Add(Key);
+				}
+			}
+			else if (Pairs.Remove(Key) > 0)
+			{
+				RemovedPairs.Add(Key);
+			}
+		}
+
+		void Rebuild(const bool bAllowParallel)
+		{
+			bNeedsRebuild = false;
+
+			// Sort each axis from scratch, one task per axis
+			PhysicsParallelFor(3, [this](const int32 Axis)
+			{
+				Algo::Sort(Endpoints[Axis]);
+				for (int32 Index = 0; Index < Endpoints[Axis].Num(); ++Index)
+				{
+					const FEndpoint& Endpoint = Endpoints[Axis][Index];
+					Proxies[Endpoint.ProxyId].Endpoints[Axis][Endpoint.bIsMax ? 1 : 0] = Index;
+				}
+			}, !bAllowParallel);
+
+			// Sweep the X axis and test the other two for every interval overlap
+			TSet<FPairKey> NewPairs;
+			NewPairs.Reserve(Pairs.Num());
+			TArray<int32> OpenProxies;
+			for (const FEndpoint& Endpoint : Endpoints[0])
+			{
+				if (!Proxies[Endpoint.ProxyId].bValid)
+				{
+					continue;
+				}
+				if (Endpoint.bIsMax)
+				{
+					OpenProxies.RemoveSingleSwap(Endpoint.ProxyId, EAllowShrinking::No);
+					continue;
+				}
+				for (const int32 OpenProxyId : OpenProxies)
+				{
+					if (ArePairable(Endpoint.ProxyId, OpenProxyId))
+					{
+						NewPairs.Add(MakePairKey(Endpoint.ProxyId, OpenProxyId));
+					}
+				}
+				OpenProxies.Add(Endpoint.ProxyId);
+			}
+
+			for (const FPairKey Key : NewPairs)
+			{
+				if (!Pairs.Contains(Key))
+				{
+					AddedPairs.Add(Key);
+				}
+			}
+			for (const FPairKey Key : Pairs)
+			{
+				if (!NewPairs.Contains(Key))
+				{
+					RemovedPairs.Add(Key);
+				}
+			}
+			Pairs = MoveTemp(NewPairs);
+		}
+
+		// Removed proxies have sifted to the end of every axis; trim their endpoints and recycle the ids
+		void ReleaseRemovedProxies()
+		{
+			if (RemovedProxies.Num() == 0)
+			{
+				return;
+			}
+
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				TArray<FEndpoint>& AxisEndpoints = Endpoints[Axis];
+				while ((AxisEndpoints.Num() > 0) && !Proxies[AxisEndpoints.Last().ProxyId].bValid)
+				{
+					AxisEndpoints.Pop(EAllowShrinking::No);
+				}
+			}
+			FreeProxies.Append(RemovedProxies);
+			RemovedProxies.Reset();
+		}
+
+		TArray<FProxy> Proxies;
+		TArray<int32> FreeProxies;
+		TArray<int32> MovedProxies;
+		TArray<int32> RemovedProxies;
+		TArray<FEndpoint> Endpoints[3];
+		TSet<FPairKey> Pairs;
+		TArray<FPairKey> AddedPairs;
+		TArray<FPairKey> RemovedPairs;
+		FReal FatMargin;
+		bool bNeedsRebuild = false;
+	};
+}
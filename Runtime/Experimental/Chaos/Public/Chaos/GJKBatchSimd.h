@@ -0,0 +1,362 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Chaos/Core.h"
+#include "Chaos/Collision/ContactPoint.h"
+#include "Chaos/GJK.h"
+#include "Chaos/Simd4.h"
+#include "Chaos/SimplexVectorized.h"
+
+namespace Chaos
+{
+	namespace Private
+	{
+		/**
+		* How the support function of a lane in FGJKBatchShapesSimd is evaluated.
+		* Box, Capsule and Sphere are evaluated for all lanes at once. Convex lanes call the
+		* shape's own support function one lane at a time.
+		*/
+		enum class EGJKBatchShapeType : uint8
+		{
+			Sphere,
+			Capsule,
+			Box,
+			Convex,
+		};
+
+		/**
+		* One convex shape per lane, in its own local space. Only the core shape (with the margin or radius
+		* removed) takes part in GJK; the margin is added back to the resulting distance.
+		*	Sphere:		Center, Extent = 0
+		*	Capsule:	Center = segment mid point, Extent = half segment (signed by the direction)
+		*	Box:		Center = box center, Extent = core half extents (signed per component)
+		*/
+		struct FGJKBatchShapesSimd
+		{
+			FSimd4Vec3f Center;
+			FSimd4Vec3f Extent;
+			FSimd4Realf Margin;
+			FSimd4Selector IsBox;
+			TSimdValue<const FGeomGJKHelperSIMD*, 4> Convex;
+			bool bAnyConvex;
+
+			FGJKBatchShapesSimd()
+				: Center(FVec3f(0))
+				, Extent(FVec3f(0))
+				, Margin(FSimd4Realf::Zero())
+				, IsBox(FSimd4Selector::False())
+				, bAnyConvex(false)
+			{
+				Convex.SetValues(nullptr);
+			}
+
+			void SetSphere(const int32 LaneIndex, const FVec3f& InCenter, const FRealSingle InRadius)
+			{
+				SetLane(LaneIndex, EGJKBatchShapeType::Sphere, InCenter, FVec3f(0), InRadius);
+			}
+
+			void SetCapsule(const int32 LaneIndex, const FVec3f& InX1, const FVec3f& InX2, const FRealSingle InRadius)
+			{
+				SetLane(LaneIndex, EGJKBatchShapeType::Capsule, 0.5f * (InX1 + InX2), 0.5f * (InX2 - InX1), InRadius);
+			}
+
+			void SetBox(const int32 LaneIndex, const FVec3f& InMin, const FVec3f& InMax, const FRealSingle InMargin)
+			{
+				const FVec3f CoreExtent = FVec3f::Max(0.5f * (InMax - InMin) - FVec3f(InMargin), FVec3f(0));
+				SetLane(LaneIndex, EGJKBatchShapeType::Box, 0.5f * (InMin + InMax), CoreExtent, InMargin);
+			}
+
+			// The helper must outlive the batch. Its core support function is used with its own margin.
+			void SetConvex(const int32 LaneIndex, const FGeomGJKHelperSIMD* InConvex)
+			{
+				check(InConvex != nullptr);
+				SetLane(LaneIndex, EGJKBatchShapeType::Convex, FVec3f(0), FVec3f(0), InConvex->GetMargin());
+				Convex.SetValue(LaneIndex, InConvex);
+				bAnyConvex = true;
+			}
+
+			// Support point of the core shapes in direction Dir (which does not need to be normalized)
+			FSimd4Vec3f SupportCore(const FSimd4Vec3f& Dir) const
+			{
+				// Box: per-component sign of the direction. Capsule and sphere: sign of the direction along the segment.
+				const FSimd4Realf Zero = FSimd4Realf::Zero();
+				const FSimd4Realf AlongSegment = SimdDotProduct(Dir, Extent);
+				const FSimd4Selector SegmentPositive = SimdGreaterEqual(AlongSegment, Zero);
+
+				FSimd4Vec3f Offset;
+				Offset.SetValues(FVec3f(0));
+				SelectComponent(Offset.VX, Dir.VX, Extent.VX, SegmentPositive);
+				SelectComponent(Offset.VY, Dir.VY, Extent.VY, SegmentPositive);
+				SelectComponent(Offset.VZ, Dir.VZ, Extent.VZ, SegmentPositive);
+
+				FSimd4Vec3f Support = SimdAdd(Center, Offset);
+
+				if (bAnyConvex)
+				{
+					for (int32 LaneIndex = 0; LaneIndex < 4; ++LaneIndex)
+					{
+						if (const FGeomGJKHelperSIMD* LaneConvex = Convex.GetValue(LaneIndex))
+						{
+							const FVec3f LaneDir = Dir.GetValue(LaneIndex);
+							const VectorRegister4Float LaneSupport = LaneConvex->SupportFunction(MakeVectorRegisterFloat(LaneDir.X, LaneDir.Y, LaneDir.Z, 0.0f));
+							alignas(16) float Out[4];
+							VectorStoreAligned(LaneSupport, Out);
+							Support.SetValue(LaneIndex, FVec3f(Out[0], Out[1], Out[2]));
+						}
+					}
+				}
+
+				return Support;
+			}
+
+		private:
+			void SetLane(const int32 LaneIndex, const EGJKBatchShapeType InType, const FVec3f& InCenter, const FVec3f& InExtent, const FRealSingle InMargin)
+			{
+				Center.SetValue(LaneIndex, InCenter);
+				Extent.SetValue(LaneIndex, InExtent);
+				Margin.SetValue(LaneIndex, InMargin);
+				IsBox.SetValue(LaneIndex, InType == EGJKBatchShapeType::Box);
+				Convex.SetValue(LaneIndex, nullptr);
+			}
+
+			// Out = (Box ? sign(Dir) * Extent : (SegmentPositive ? Extent : -Extent)), one component at a time
+			void SelectComponent(float* RESTRICT Out, const float* RESTRICT Dir, const float* RESTRICT InExtent, const FSimd4Selector& SegmentPositive) const
+			{
+				const VectorRegister4Float D = VectorLoadAligned(Dir);
+				const VectorRegister4Float E = VectorLoadAligned(InExtent);
+				const VectorRegister4Float NegE = VectorNegate(E);
+				const VectorRegister4Float BoxOffset = VectorSelect(VectorCompareGE(D, VectorZeroFloat()), E, NegE);
+				const VectorRegister4Float SegmentOffset = VectorSelect(VectorLoadAligned(SegmentPositive.V), E, NegE);
+				VectorStoreAligned(VectorSelect(VectorLoadAligned(IsBox.V), BoxOffset, SegmentOffset), Out);
+			}
+		};
+
+		/**
+		* Results of a batched GJK query. All lanes are valid only where IsValid is set.
+		* Contact points are in the space of their own shape and the normal is in the space of shape B,
+		* pointing away from it, which matches FContactPointf and the layout used by TPBDCollisionSolverSimd.
+		*/
+		struct FGJKBatchResultSimd
+		{
+			FSimd4Vec3f ShapeContactPointA;
+			FSimd4Vec3f ShapeContactPointB;
+			FSimd4Vec3f ShapeContactNormal;
+			FSimd4Realf Phi;
+			FSimd4Selector IsValid;
+			/** Lanes whose core shapes overlap. GJK cannot produce a contact for them; run EPA (GJKPenetration) one lane at a time. */
+			FSimd4Selector NeedsPenetration;
+			int32 NumIterations = 0;
+
+			FContactPointf GetContactPoint(const int32 LaneIndex) const
+			{
+				FContactPointf ContactPoint;
+				if (IsValid.GetValue(LaneIndex))
+				{
+					ContactPoint.ShapeContactPoints[0] = ShapeContactPointA.GetValue(LaneIndex);
+					ContactPoint.ShapeContactPoints[1] = ShapeContactPointB.GetValue(LaneIndex);
+					ContactPoint.ShapeContactNormal = ShapeContactNormal.GetValue(LaneIndex);
+					ContactPoint.Phi = Phi.GetValue(LaneIndex);
+					ContactPoint.ContactType = EContactPointType::VertexPlane;
+				}
+				return ContactPoint;
+			}
+		};
+
+		// Rotate V by the unit quaternion (Q, W), 4 lanes at a time
+		FORCEINLINE FSimd4Vec3f SimdQuaternionRotateVector(const FSimd4Vec3f& Q, const FSimd4Realf& W, const FSimd4Vec3f& V)
+		{
+			// V' = V + W * T + Q x T, with T = 2 * (Q x V)
+			const FSimd4Vec3f T = SimdMultiply(SimdCrossProduct(Q, V), FSimd4Realf::Make(2.0f));
+			return SimdAdd(SimdAdd(V, SimdMultiply(T, W)), SimdCrossProduct(Q, T));
+		}
+
+		/**
+		* Closest points between the core shapes of A[i] and B[i] for 4 pairs at a time, where B is transformed into
+		* the space of A by (BToARotation, BToATranslation).
+		*
+		* Support mapping, transforms and termination tests run on all lanes at once. Lanes that terminate are masked
+		* out and the loop stops when no lane is active. Simplex reduction is done per lane with the vectorized
+		* single-pair simplex solver, since the lanes generally have simplices of different sizes.
+		*
+		* Every lane's simplex is seeded with the support point in the initial direction before the loop, so a lane
+		* that converges on its first iteration still has closest points to report.
+		*
+		* Only lanes set in LaneMask are processed. Lanes with overlapping core shapes are reported in NeedsPenetration.
+		*/
+		inline void GJKDistanceBatchSimd(
+			const FGJKBatchShapesSimd& A,
+			const FGJKBatchShapesSimd& B,
+			const FSimd4Vec3f& BToARotationQ,
+			const FSimd4Realf& BToARotationW,
+			const FSimd4Vec3f& BToATranslation,
+			const FSimd4Selector& LaneMask,
+			FGJKBatchResultSimd& OutResult,
+			const FRealSingle Epsilon = 1.e-3f,
+			const int32 MaxIterations = 32)
+		{
+			const FSimd4Vec3f AToBRotationQ = SimdMultiply(BToARotationQ, FSimd4Realf::Make(-1.0f));
+
+			// Support of the Minkowski difference A - B in direction -V, all lanes at once
+			auto SupportAB = [&A, &B, &BToARotationQ, &BToARotationW, &BToATranslation, &AToBRotationQ](const FSimd4Vec3f& V, FSimd4Vec3f& OutSupportA, FSimd4Vec3f& OutSupportB)
+			{
+				OutSupportA = A.SupportCore(SimdMultiply(V, FSimd4Realf::Make(-1.0f)));
+				const FSimd4Vec3f VInB = SimdQuaternionRotateVector(AToBRotationQ, BToARotationW, V);
+				OutSupportB = SimdAdd(SimdQuaternionRotateVector(BToARotationQ, BToARotationW, B.SupportCore(VInB)), BToATranslation);
+				return SimdSubtract(OutSupportA, OutSupportB);
+			};
+
+			// Per-lane simplex state
+			VectorRegister4Float Simplex[4][4];
+			VectorRegister4Float SimplexA[4][4];
+			VectorRegister4Float SimplexB[4][4];
+			VectorRegister4Float Barycentric[4];
+			int32 NumVerts[4] = { 0, 0, 0, 0 };
+			FRealSingle PrevDist2[4] = { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX };
+
+			// Initial direction: from B's center to A's center
+			FSimd4Vec3f V = SimdSubtract(A.Center, SimdAdd(SimdQuaternionRotateVector(BToARotationQ, BToARotationW, B.Center), BToATranslation));
+
+			FSimd4Selector Active = LaneMask;
+			OutResult.IsValid = FSimd4Selector::False();
+			OutResult.NeedsPenetration = FSimd4Selector::False();
+
+			for (int32 LaneIndex = 0; LaneIndex < 4; ++LaneIndex)
+			{
+				if (V.GetValue(LaneIndex).SizeSquared() < UE_SMALL_NUMBER)
+				{
+					V.SetValue(LaneIndex, FVec3f(1, 0, 0));
+				}
+			}
+
+			// Seed each lane's simplex with its first support point, which is also the closest point of that simplex
+			{
+				FSimd4Vec3f SupportA, SupportB;
+				const FSimd4Vec3f W = SupportAB(V, SupportA, SupportB);
+				for (int32 LaneIndex = 0; LaneIndex < 4; ++LaneIndex)
+				{
+					if (!LaneMask.GetValue(LaneIndex))
+					{
+						continue;
+					}
+
+					const FVec3f LaneW = W.GetValue(LaneIndex);
+					const FVec3f LaneA = SupportA.GetValue(LaneIndex);
+					const FVec3f LaneB = SupportB.GetValue(LaneIndex);
+					Simplex[LaneIndex][0] = MakeVectorRegisterFloat(LaneW.X, LaneW.Y, LaneW.Z, 0.0f);
+					SimplexA[LaneIndex][0] = MakeVectorRegisterFloat(LaneA.X, LaneA.Y, LaneA.Z, 0.0f);
+					SimplexB[LaneIndex][0] = MakeVectorRegisterFloat(LaneB.X, LaneB.Y, LaneB.Z, 0.0f);
+					Barycentric[LaneIndex] = MakeVectorRegisterFloat(1.0f, 0.0f, 0.0f, 0.0f);
+					NumVerts[LaneIndex] = 1;
+
+					const FRealSingle Dist2 = LaneW.SizeSquared();
+					if (Dist2 < Epsilon * Epsilon)
+					{
+						// Support point at the origin: the core shapes touch or overlap
+						Active.SetValue(LaneIndex, false);
+						OutResult.NeedsPenetration.SetValue(LaneIndex, true);
+						continue;
+					}
+					PrevDist2[LaneIndex] = Dist2;
+					V.SetValue(LaneIndex, LaneW);
+				}
+			}
+
+			const FSimd4Realf EpsilonSimd = FSimd4Realf::Make(Epsilon);
+			int32 NumIterations = 0;
+			while (SimdAnyTrue(Active) && (NumIterations < MaxIterations))
+			{
+				++NumIterations;
+
+				FSimd4Vec3f SupportA, SupportB;
+				const FSimd4Vec3f W = SupportAB(V, SupportA, SupportB);
+
+				// Converged when the new support point does not get us meaningfully closer: |V|^2 - V.W <= Eps * |V|^2
+				const FSimd4Realf VV = SimdDotProduct(V, V);
+				const FSimd4Realf VW = SimdDotProduct(V, W);
+				const FSimd4Selector Converged = SimdLess(SimdSubtract(VV, VW), SimdMultiply(EpsilonSimd, VV));
+				Active = SimdAnd(Active, SimdNot(Converged));
+
+				// Simplex reduction for each lane still running
+				for (int32 LaneIndex = 0; LaneIndex < 4; ++LaneIndex)
+				{
+					if (!Active.GetValue(LaneIndex))
+					{
+						continue;
+					}
+
+					const FVec3f LaneW = W.GetValue(LaneIndex);
+					const FVec3f LaneA = SupportA.GetValue(LaneIndex);
+					const FVec3f LaneB = SupportB.GetValue(LaneIndex);
+					const int32 VertIndex = NumVerts[LaneIndex]++;
+					Simplex[LaneIndex][VertIndex] = MakeVectorRegisterFloat(LaneW.X, LaneW.Y, LaneW.Z, 0.0f);
+					SimplexA[LaneIndex][VertIndex] = MakeVectorRegisterFloat(LaneA.X, LaneA.Y, LaneA.Z, 0.0f);
+					SimplexB[LaneIndex][VertIndex] = MakeVectorRegisterFloat(LaneB.X, LaneB.Y, LaneB.Z, 0.0f);
+
+					const VectorRegister4Float LaneV = VectorSimplexFindClosestToOrigin<VectorRegister4Float, true>(Simplex[LaneIndex], NumVerts[LaneIndex], Barycentric[LaneIndex], SimplexA[LaneIndex], SimplexB[LaneIndex]);
+					alignas(16) float LaneVOut[4];
+					VectorStoreAligned(LaneV, LaneVOut);
+					const FVec3f NewV(LaneVOut[0], LaneVOut[1], LaneVOut[2]);
+					const FRealSingle NewDist2 = NewV.SizeSquared();
+
+					if ((NumVerts[LaneIndex] == 4) || (NewDist2 < Epsilon * Epsilon))
+					{
+						// Origin is inside (or on) the core Minkowski difference
+						Active.SetValue(LaneIndex, false);
+						OutResult.NeedsPenetration.SetValue(LaneIndex, true);
+						continue;
+					}
+					if (NewDist2 >= PrevDist2[LaneIndex])
+					{
+						// No progress (numerical noise): the reduced simplex is as close as we get
+						Active.SetValue(LaneIndex, false);
+					}
+
+					PrevDist2[LaneIndex] = NewDist2;
+					V.SetValue(LaneIndex, NewV);
+				}
+			}
+			OutResult.NumIterations = NumIterations;
+
+			// Resolve closest points for the lanes that separated
+			for (int32 LaneIndex = 0; LaneIndex < 4; ++LaneIndex)
+			{
+				if (!LaneMask.GetValue(LaneIndex) || OutResult.NeedsPenetration.GetValue(LaneIndex))
+				{
+					continue;
+				}
+				check(NumVerts[LaneIndex] > 0);
+
+				alignas(16) float Bary[4];
+				VectorStoreAligned(Barycentric[LaneIndex], Bary);
+				FVec3f ClosestA(0), ClosestB(0);
+				for (int32 VertIndex = 0; VertIndex < NumVerts[LaneIndex]; ++VertIndex)
+				{
+					alignas(16) float LaneA[4], LaneB[4];
+					VectorStoreAligned(SimplexA[LaneIndex][VertIndex], LaneA);
+					VectorStoreAligned(SimplexB[LaneIndex][VertIndex], LaneB);
+					ClosestA += Bary[VertIndex] * FVec3f(LaneA[0], LaneA[1], LaneA[2]);
+					ClosestB += Bary[VertIndex] * FVec3f(LaneB[0], LaneB[1], LaneB[2]);
+				}
+
+				// V points from B to A in A space
+				const FVec3f LaneV = V.GetValue(LaneIndex);
+				const FRealSingle Distance = LaneV.Size();
+				const FVec3f NormalA = LaneV / Distance;
+				const FRealSingle MarginA = A.Margin.GetValue(LaneIndex);
+				const FRealSingle MarginB = B.Margin.GetValue(LaneIndex);
+
+				// Transform B's results back into B space
+				const FVec3f RotationQ = BToARotationQ.GetValue(LaneIndex);
+				const FRotation3f BToARotation = FRotation3f::FromElements(RotationQ.X, RotationQ.Y, RotationQ.Z, BToARotationW.GetValue(LaneIndex));
+				const FVec3f ClosestBLocal = BToARotation.UnrotateVector(ClosestB - BToATranslation.GetValue(LaneIndex));
+				const FVec3f NormalB = BToARotation.UnrotateVector(NormalA);
+
+				OutResult.ShapeContactPointA.SetValue(LaneIndex, ClosestA - MarginA * NormalA);
+				OutResult.ShapeContactPointB.SetValue(LaneIndex, ClosestBLocal + MarginB * NormalB);
+				OutResult.ShapeContactNormal.SetValue(LaneIndex, NormalB);
+				OutResult.Phi.SetValue(LaneIndex, Distance - MarginA - MarginB);
+				OutResult.IsValid.SetValue(LaneIndex, true);
+			}
+		}
+	}
+}
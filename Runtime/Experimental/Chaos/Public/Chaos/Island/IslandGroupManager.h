@@ -2,6 +2,7 @@
 #pragma once
 
 #include "Chaos/Island/IslandGroup.h"
+#include "Chaos/Island/IslandManager.h"
 
 namespace Chaos
 {
@@ -127,6 +128,19 @@ namespace Chaos
 			*/
 			const FIterationSettings& GetIterationSettings() const { return Iterations; }
 
+			/**
+			 * Islands with at least this many constraints are not assigned to a group. Instead they are colored and solved one
+			 * color at a time, with the constraints of each color split across worker threads. This removes the single-threaded
+			 * tail of very large islands (stacks, piles, long chains). 0 (the default) always solves islands in groups.
+			*/
+			void SetMinColoredIslandConstraints(const int32 InMinConstraints) { MinColoredIslandConstraints = InMinConstraints; }
+			int32 GetMinColoredIslandConstraints() const { return MinColoredIslandConstraints; }
+
+			/**
+			 * The number of islands that were too large for a group and will be solved by color this tick
+			*/
+			inline int32 GetNumColoredIslands() const { return ColoredIslands.Num(); }
+
 			/**
 			 * Solve all constraints.
 			*/
@@ -155,6 +169,64 @@ namespace Chaos
 				FPBDIslandConstraintGroupSolver* IslandGroup;
 			};
 
+			// The constraints of a large island bucketed by color. Colors are solved in order and the constraints of a color
+			// are split into ranges that are solved concurrently. Constraints of one color share no dynamic particle, so the
+			// result is the same however the ranges are scheduled. The last color may be the serial overflow color.
+			struct FColoredIsland
+			{
+				void Build(FPBDIslandManager& InIslandManager, FPBDIsland* InIsland, const int32 MaxColors)
+				{
+					Island = InIsland;
+					const int32 NumColors = InIslandManager.AssignIslandColors(Island, MaxColors);
+					bHasSerialColor = false;
+
+					// Stable counting sort by color, which keeps the constraints of each color grouped by container and in island order
+					ColorOffsets.Reset();
+					ColorOffsets.SetNumZeroed(NumColors + 1);
+					for (int32 ContainerId = 0; ContainerId < InIslandManager.GetNumConstraintContainers(); ++ContainerId)
+					{
+						for (const FPBDIslandConstraint* Constraint : Island->GetConstraints(ContainerId))
+						{
+							const int32 Color = InIslandManager.GetIslandConstraintColor(Constraint);
+							++ColorOffsets[Color + 1];
+							bHasSerialColor |= (Color == MaxColors);
+						}
+					}
+					for (int32 Color = 0; Color < NumColors; ++Color)
+					{
+						ColorOffsets[Color + 1] += ColorOffsets[Color];
+					}
+
+					TArray<int32> ColorCursors(ColorOffsets.GetData(), NumColors);
+					Constraints.SetNumUninitialized(ColorOffsets[NumColors]);
+					for (int32 ContainerId = 0; ContainerId < InIslandManager.GetNumConstraintContainers(); ++ContainerId)
+					{
+						for (FPBDIslandConstraint* Constraint : Island->GetConstraints(ContainerId))
+						{
+							Constraints[ColorCursors[InIslandManager.GetIslandConstraintColor(Constraint)]++] = Constraint;
+						}
+					}
+				}
+
+				int32 GetNumColors() const { return FMath::Max(ColorOffsets.Num() - 1, 0); }
+
+				TArrayView<FPBDIslandConstraint*> GetColorConstraints(const int32 Color)
+				{
+					return MakeArrayView(&Constraints[ColorOffsets[Color]], ColorOffsets[Color + 1] - ColorOffsets[Color]);
+				}
+
+				// Whether the constraints of a color may be split across threads (false for the serial overflow color)
+				bool IsParallelColor(const int32 Color) const
+				{
+					return !bHasSerialColor || (Color < GetNumColors() - 1);
+				}
+
+				FPBDIsland* Island = nullptr;
+				TArray<FPBDIslandConstraint*> Constraints;
+				TArray<int32> ColorOffsets;
+				bool bHasSerialColor = false;
+			};
+
 			CHAOS_API void SolveSerial(const FReal Dt);
 			CHAOS_API void SolveParallelFor(const FReal Dt);
 			CHAOS_API void SolveParallelTasks(const FReal Dt);
@@ -162,6 +234,9 @@ namespace Chaos
 			CHAOS_API void BuildGatherBatches(TArray<FIslandGroupRange>& BodyRanges, TArray<FIslandGroupRange>& ConstraintRanges);
 			CHAOS_API void SolveGroupConstraints(const int32 GroupIndex, const FReal Dt);
 
+			// Solve the islands in ColoredIslands, one color at a time with each color split into TargetNumConstraintsPerTask ranges
+			CHAOS_API void SolveColoredIslands(const FReal Dt);
+
 
 			FPBDIslandManager& IslandManager;
 			TArray<TUniquePtr<FPBDIslandConstraintGroupSolver>> IslandGroups;
@@ -171,6 +246,11 @@ namespace Chaos
 			int32 TargetNumConstraintsPerTask;
 			FIterationSettings Iterations;
 
+			// Islands at or above MinColoredIslandConstraints, pulled out of the groups by BuildGroups
+			TArray<FColoredIsland> ColoredIslands;
+			int32 MinColoredIslandConstraints = 0;
+			int32 MaxIslandColors = 64;
+
 	#if CSV_PROFILER_STATS
 			double& GetThreadStatAccumulator(const int32 ThreadIndex, const FIslandGroupStats::EPerIslandStat StatId)
 			{
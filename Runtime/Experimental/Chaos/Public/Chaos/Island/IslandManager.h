@@ -479,6 +479,24 @@ namespace Chaos::Private
 		CHAOS_API int32 GetConstraintLevel(const FPBDIslandConstraint* Edge) const;
 		CHAOS_API int32 GetConstraintColor(const FPBDIslandConstraint* Edge) const;
 
+		// The color assigned by AssignIslandColors. Only valid for islands colored this tick.
+		int32 GetIslandConstraintColor(const FPBDIslandConstraint* Edge) const
+		{
+			return ConstraintColors.IsValidIndex(Edge->GetArrayIndex()) ? ConstraintColors[Edge->GetArrayIndex()] : INDEX_NONE;
+		}
+
+		/**
+		* Color the constraints of an island so that no two constraints of the same color share a dynamic particle, which
+		* allows all the constraints of one color to be solved concurrently. Kinematic particles are not written by the
+		* solver and do not restrict the coloring.
+		* Constraints are visited in container order and then in island order (which is sorted by level and deterministic
+		* when determinism is enabled), so the coloring is deterministic. Constraints that cannot get a color below
+		* MaxColors are given color MaxColors and should be solved serially after all other colors.
+		* The colors can be retrieved with GetIslandConstraintColor.
+		* @return the number of colors used, including the serial color if it was needed
+		*/
+		int32 AssignIslandColors(FPBDIsland* Island, const int32 MaxColors = 64);
+
 		/**
 		* Visit all the awake constraints from the specified container.
 		* @tparam VisitorType void(const FPBDIslandConstraint*)
@@ -629,6 +647,9 @@ namespace Chaos::Private
 
 		// Whether we should assign levels (for shock propagation)
 		bool bAssignLevels = true;
+
+		// Graph colors assigned by AssignIslandColors, indexed by FPBDIslandConstraint::ArrayIndex (see GetIslandConstraintColor)
+		TArray<int32> ConstraintColors;
 	};
 
 
@@ -654,6 +675,60 @@ namespace Chaos::Private
 		}
 	}
 
+	inline int32 FPBDIslandManager::AssignIslandColors(FPBDIsland* Island, const int32 MaxColors)
+	{
+		check((MaxColors > 0) && (MaxColors <= 64));
+
+		// The colors already used by each dynamic particle in the island, indexed by FPBDIslandParticle::IslandArrayIndex
+		TArray<uint64> NodeColorMasks;
+		NodeColorMasks.SetNumZeroed(Island->Nodes.Num());
+		const uint64 AllowedColorsMask = (MaxColors == 64) ? ~uint64(0) : ((uint64(1) << MaxColors) - 1);
+
+		if (ConstraintColors.Num() < Edges.Num())
+		{
+			const int32 NumColored = ConstraintColors.Num();
+			ConstraintColors.SetNumUninitialized(Edges.Num());
+			for (int32 EdgeIndex = NumColored; EdgeIndex < ConstraintColors.Num(); ++EdgeIndex)
+			{
+				ConstraintColors[EdgeIndex] = INDEX_NONE;
+			}
+		}
+
+		int32 NumColors = 0;
+		for (TArray<FPBDIslandConstraint*>& IslandEdges : Island->ContainerEdges)
+		{
+			for (FPBDIslandConstraint* Edge : IslandEdges)
+			{
+				uint64 UsedColorsMask = 0;
+				for (const FPBDIslandParticle* Node : Edge->Nodes)
+				{
+					if ((Node != nullptr) && Node->Flags.bIsDynamic && (Node->Island == Island))
+					{
+						UsedColorsMask |= NodeColorMasks[Node->IslandArrayIndex];
+					}
+				}
+
+				const uint64 FreeColorsMask = ~UsedColorsMask & AllowedColorsMask;
+				const int32 Color = (FreeColorsMask != 0) ? int32(FMath::CountTrailingZeros64(FreeColorsMask)) : MaxColors;
+				ConstraintColors[Edge->GetArrayIndex()] = Color;
+				NumColors = FMath::Max(NumColors, Color + 1);
+
+				if (Color < MaxColors)
+				{
+					for (const FPBDIslandParticle* Node : Edge->Nodes)
+					{
+						if ((Node != nullptr) && Node->Flags.bIsDynamic && (Node->Island == Island))
+						{
+							NodeColorMasks[Node->IslandArrayIndex] |= (uint64(1) << Color);
+						}
+					}
+				}
+			}
+		}
+
+		return NumColors;
+	}
+
 	template<typename VisitorType>
 	void FPBDIslandManager::VisitAwakeConstConstraints(const int32 ContainerId, const VisitorType& Visitor) const
 	{
@@ -559,6 +559,8 @@ public:
 			auto& AsyncSpatialData = AsyncAccelerationQueue.FindOrAdd(UniqueIdx);
 			// ensure(AsyncSpatialData.Operation != EPendingSpatialDataOperation::Delete); // TODO: This may be hit: Potentially due to UniqueIdx reuse?
 			AsyncSpatialData = SpatialData;
+
+			OnParticleSpatialDataDirty(Particle.Handle());
 		}
 	}
 
@@ -700,6 +702,13 @@ public:
 	virtual void DestroyTransientConstraints(FGeometryParticleHandle* Particle) {}
 	virtual void DestroyTransientConstraints() {}
 
+	/**
+	* Called when a particle is added to, or updated in, the spatial acceleration queue (see DirtyParticle), and when it
+	* is removed from the spatial acceleration (see RemoveParticleFromAccelerationStructure).
+	*/
+	virtual void OnParticleSpatialDataDirty(FGeometryParticleHandle* Particle) {}
+	virtual void OnParticleSpatialDataRemoved(FGeometryParticleHandle* Particle) {}
+
 	const TParticleView<FPBDRigidClusteredParticles>& GetNonDisabledClusteredView() const { return Particles.GetNonDisabledClusteredView(); }
 
 	TSerializablePtr<FChaosPhysicsMaterial> GetPhysicsMaterial(const FGeometryParticleHandle* Particle) const { return Particle->AuxilaryValue(PhysicsMaterials); }
@@ -862,6 +871,8 @@ public:
 		//remove particle immediately for intermediate structure
 		//TODO: if we distinguished between first time adds we could avoid this. We could also make the RemoveElementFrom more strict and ensure when it fails
 		InternalAcceleration->RemoveElementFrom(SpatialData.AccelerationHandle, SpatialData.SpatialIdx);
+
+		OnParticleSpatialDataRemoved(ParticleHandle.Handle());
 	}
 
 	
@@ -213,6 +213,10 @@ namespace Chaos
 		virtual void DestroyTransientConstraints(FGeometryParticleHandle* Particle) override final;
 		virtual void DestroyTransientConstraints() override final;
 
+		// Keep the persistent sweep-and-prune broadphase in sync without scanning all particles every tick
+		virtual void OnParticleSpatialDataDirty(FGeometryParticleHandle* Particle) override final { BroadPhase.MarkParticleDirty(Particle); }
+		virtual void OnParticleSpatialDataRemoved(FGeometryParticleHandle* Particle) override final { BroadPhase.RemoveParticle(Particle); }
+
 		/** Reset the collisions warm starting when resimulate. Ideally we should store
 		  that in the RewindData history but probably too expensive for now */
 		virtual void ResetCollisions() override;
@@ -241,6 +245,10 @@ namespace Chaos
 
 		FSpatialAccelerationBroadPhase& GetBroadPhase() { return BroadPhase; }
 
+		/** Select between the per-tick spatial acceleration queries and the persistent sweep-and-prune broadphase */
+		void SetBroadPhaseType(const EBroadPhaseType InBroadPhaseType) { BroadPhase.SetBroadPhaseType(InBroadPhaseType); }
+		EBroadPhaseType GetBroadPhaseType() const { return BroadPhase.GetBroadPhaseType(); }
+
 		CHAOS_API void TransferJointConstraintCollisions();
 
 		// Resets VSmooth value to something plausible based on external forces to prevent object from going back to sleep if it was just impulsed.
@@ -9,6 +9,7 @@
 #include "Chaos/OBBVectorized.h"
 #include "Chaos/SegmentMesh.h"
 #include "Chaos/Triangle.h"
+#include "Chaos/TrimeshQuantizedBVH.h"
 
 #include "AABBTree.h"
 #include "BoundingVolume.h"
@@ -527,6 +528,7 @@ namespace Chaos
 			}
 			
 			RebuildFastBVH();
+			RebuildQuantizedBVH();
 		}
 
 		FTriangleMeshImplicitObject(const FTriangleMeshImplicitObject& Other) = delete;
@@ -663,6 +665,11 @@ namespace Chaos
 				RebuildFastBVH();
 			}
 
+			if (Ar.IsLoading())
+			{
+				RebuildQuantizedBVH();
+			}
+
 			if (Ar.CustomVer(FExternalPhysicsCustomObjectVersion::GUID) >= FExternalPhysicsCustomObjectVersion::AddTrimeshMaterialIndices)
 			{
 				Ar << MaterialIndices;
@@ -758,6 +765,14 @@ namespace Chaos
 		*/
 		void FindOverlappingTriangles(const FAABB3& QueryBounds, TArray<int32>& OutTriangleIndices) const
 		{
+#if CHAOS_TRIMESH_QUANTIZED_BVH
+			// The quantized bounds are conservative, so this may return a few extra triangles near the edge of QueryBounds
+			if (!QuantizedBVH.IsEmpty())
+			{
+				OutTriangleIndices = QuantizedBVH.FindAllIntersections(QueryBounds);
+				return;
+			}
+#endif
 			OutTriangleIndices = FastBVH.FindAllIntersections(QueryBounds);
 		}
 
@@ -800,6 +815,14 @@ namespace Chaos
 		CHAOS_API void RebuildFastBVHFromTree(const BVHType& BVH);
 		CHAOS_API void RebuildFastBVH();
 
+		// Rebuild the quantized tree from FastBVH. It is left empty (and FastBVH used instead) if FastBVH is too large for it.
+		void RebuildQuantizedBVH()
+		{
+#if CHAOS_TRIMESH_QUANTIZED_BVH
+			QuantizedBVH.Build(FastBVH);
+#endif
+		}
+
 		ParticlesType MParticles;
 		FTrimeshIndexBuffer MElements;
 		FAABB3 MLocalBoundingBox;
@@ -840,6 +863,7 @@ namespace Chaos
 			}
 			
 			RebuildFastBVHFromTree(InBvhToCopy);
+			RebuildQuantizedBVH();
 		}
 
 		template<typename InStorageType, typename InRealType>
@@ -890,6 +914,9 @@ namespace Chaos
 		};
 
 		FTrimeshBVH FastBVH;
+#if CHAOS_TRIMESH_QUANTIZED_BVH
+		FTrimeshQuantizedBVH QuantizedBVH;
+#endif
 
 		template<typename Geom, typename IdxType>
 		friend struct FTriangleMeshSweepVisitor;
@@ -0,0 +1,602 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Chaos/AABB.h"
+#include "Chaos/AABBVectorized.h"
+#include "Chaos/ChaosArchive.h"
+#include "Math/VectorRegister.h"
+
+/**
+ * Whether FTriangleMeshImplicitObject builds an FTrimeshQuantizedBVH next to its FTrimeshBVH and uses it for
+ * FindOverlappingTriangles and VisitTriangles. Off by default until every path that rebuilds the FTrimeshBVH
+ * (RebuildFastBVH, UpdateVertices) also calls RebuildQuantizedBVH.
+ */
+#ifndef CHAOS_TRIMESH_QUANTIZED_BVH
+#define CHAOS_TRIMESH_QUANTIZED_BVH 0
+#endif
+
+namespace Chaos
+{
+	/**
+	 * A compact, 4-wide bounding volume hierarchy over the faces of a triangle mesh.
+	 *
+	 * Every node is one 64 byte cache line holding the bounds of up to four children, quantized to 16 bits relative to
+	 * the bounds of the node itself, so the bounds of a child are only known once its parent has been decoded. Face
+	 * bounds are quantized the same way relative to the bounds of their leaf. All four children of a node (or four
+	 * faces of a leaf) are decoded and tested at once with 4-wide vector operations.
+	 *
+	 * Compared to FTrimeshBVH (80 bytes per binary node and 32 bytes per face) this uses 64 bytes per 4-wide node and
+	 * 12 bytes per face. The tree is built from an existing FTrimeshBVH and references the same face ranges, so face
+	 * indices passed to the visitors are identical. Quantization is conservative: decoded bounds always contain the
+	 * original bounds, so queries visit a superset of the faces FTrimeshBVH would visit.
+	 * The tree is derived data and is not serialized with the mesh. It is rebuilt from the FTrimeshBVH after loading.
+	 *
+	 * Visitors are the same as for FTrimeshBVH: VisitRaycast(FaceIndex, CurrentLength), VisitSweep(FaceIndex, CurrentLength)
+	 * and VisitOverlap(FaceIndex).
+	 */
+	class FTrimeshQuantizedBVH
+	{
+	public:
+		enum class EVisitorResult
+		{
+			Stop = 0,
+			Continue,
+		};
+
+		static constexpr int32 NumChildren = 4;
+		static constexpr uint32 InvalidChild = 0xFFFFFFFF;
+		static constexpr int32 FaceCountBits = 8;
+		static constexpr uint32 MaxFaceCount = (1u << FaceCountBits) - 1;
+		static constexpr uint32 MaxChildIndex = (1u << (32 - FaceCountBits)) - 1;
+
+		struct alignas(64) FNode
+		{
+			FNode()
+			{
+				FMemory::Memzero(QuantizedMin);
+				FMemory::Memzero(QuantizedMax);
+				for (uint32& Child : Children)
+				{
+					Child = InvalidChild;
+				}
+			}
+
+			// Child bounds relative to the bounds of this node, [Axis][Child] so each axis decodes with one vector operation
+			uint16 QuantizedMin[3][NumChildren];
+			uint16 QuantizedMax[3][NumChildren];
+
+			// InvalidChild for unused slots, otherwise (Index << FaceCountBits) | FaceCount. A FaceCount of zero
+			// means Index is a node, otherwise Index is the first of FaceCount faces.
+			uint32 Children[NumChildren];
+		};
+		static_assert(sizeof(FNode) == 64, "FTrimeshQuantizedBVH::FNode should fill exactly one cache line");
+
+		struct FQuantizedFaceBounds
+		{
+			// Relative to the bounds of the leaf that references the face
+			uint16 QuantizedMin[3] = { 0, 0, 0 };
+			uint16 QuantizedMax[3] = { 0, 0, 0 };
+		};
+
+		FTrimeshQuantizedBVH()
+			: RootFrame()
+		{
+		}
+
+		/**
+		 * Build from an existing binary tree (FTrimeshBVH), collapsing pairs of levels into 4-wide nodes.
+		 * @return false, leaving the tree empty, if the source has more faces or larger leaves than the packed child
+		 * indices can address. Callers then keep using the source tree.
+		 */
+		template <typename SourceBVHType>
+		bool Build(const SourceBVHType& Source)
+		{
+			Reset();
+			if ((Source.Nodes.Num() == 0) || (uint32(Source.FaceBounds.Num()) > MaxChildIndex) || (uint32(Source.Nodes.Num()) > MaxChildIndex))
+			{
+				return false;
+			}
+
+			FaceBounds.SetNum(Source.FaceBounds.Num());
+
+			TArray<FBuildEntry, TInlineAllocator<NumChildren>> RootEntries;
+			GatherEntries(Source, 0, RootEntries);
+			FVec3f RootMin(TNumericLimits<FRealSingle>::Max());
+			FVec3f RootMax(-TNumericLimits<FRealSingle>::Max());
+			for (const FBuildEntry& Entry : RootEntries)
+			{
+				RootMin = RootMin.ComponentMin(Entry.Min);
+				RootMax = RootMax.ComponentMax(Entry.Max);
+			}
+			RootFrame = MakeFrame(RootMin, RootMax);
+
+			if (BuildNode(Source, RootEntries, RootFrame) == INDEX_NONE)
+			{
+				Reset();
+				return false;
+			}
+			return true;
+		}
+
+		void Reset()
+		{
+			RootFrame = FFrame();
+			Nodes.Reset();
+			FaceBounds.Reset();
+		}
+
+		bool IsEmpty() const
+		{
+			return Nodes.Num() == 0;
+		}
+
+		SIZE_T GetAllocatedSize() const
+		{
+			return Nodes.GetAllocatedSize() + FaceBounds.GetAllocatedSize();
+		}
+
+		template <typename SQVisitor>
+		FORCEINLINE_DEBUGGABLE void Raycast(const FVec3& Start, const FVec3& Dir, const FReal Length, SQVisitor& Visitor) const
+		{
+			FRealSingle CurrentLength = static_cast<FRealSingle>(Length);
+			const FRayData Ray(Start, Dir);
+
+			const auto BoundsFilter = [&Ray, &CurrentLength](const FBounds4& Bounds) -> int32
+			{
+				return Ray.Intersect(Bounds.Min, Bounds.Max, CurrentLength);
+			};
+
+			const auto FaceVisitor = [&Visitor, &CurrentLength](int32 FaceIndex)
+			{
+				const bool bContinueVisiting = Visitor.VisitRaycast(FaceIndex, CurrentLength);
+				return bContinueVisiting ? EVisitorResult::Continue : EVisitorResult::Stop;
+			};
+
+			VisitTree(BoundsFilter, FaceVisitor);
+		}
+
+		template <typename SQVisitor>
+		FORCEINLINE_DEBUGGABLE void Sweep(const FVec3& Start, const FVec3& Dir, const FReal Length, const FVec3& QueryHalfExtents, SQVisitor& Visitor) const
+		{
+			FRealSingle CurrentLength = static_cast<FRealSingle>(Length);
+			const FRayData Ray(Start, Dir);
+			const VectorRegister4Float HalfExtents[3] =
+			{
+				VectorSetFloat1(static_cast<FRealSingle>(QueryHalfExtents.X)),
+				VectorSetFloat1(static_cast<FRealSingle>(QueryHalfExtents.Y)),
+				VectorSetFloat1(static_cast<FRealSingle>(QueryHalfExtents.Z)),
+			};
+
+			const auto BoundsFilter = [&Ray, &CurrentLength, &HalfExtents](const FBounds4& Bounds) -> int32
+			{
+				const VectorRegister4Float SweepMin[3] = { VectorSubtract(Bounds.Min[0], HalfExtents[0]), VectorSubtract(Bounds.Min[1], HalfExtents[1]), VectorSubtract(Bounds.Min[2], HalfExtents[2]) };
+				const VectorRegister4Float SweepMax[3] = { VectorAdd(Bounds.Max[0], HalfExtents[0]), VectorAdd(Bounds.Max[1], HalfExtents[1]), VectorAdd(Bounds.Max[2], HalfExtents[2]) };
+				return Ray.Intersect(SweepMin, SweepMax, CurrentLength);
+			};
+
+			const auto FaceVisitor = [&Visitor, &CurrentLength](int32 FaceIndex)
+			{
+				const bool bContinueVisiting = Visitor.VisitSweep(FaceIndex, CurrentLength);
+				return bContinueVisiting ? EVisitorResult::Continue : EVisitorResult::Stop;
+			};
+
+			VisitTree(BoundsFilter, FaceVisitor);
+		}
+
+		template <typename SQVisitor>
+		FORCEINLINE_DEBUGGABLE void Overlap(const FAABB3& AABB, SQVisitor& Visitor) const
+		{
+			const VectorRegister4Float QueryMin[3] = { VectorSetFloat1(FRealSingle(AABB.Min().X)), VectorSetFloat1(FRealSingle(AABB.Min().Y)), VectorSetFloat1(FRealSingle(AABB.Min().Z)) };
+			const VectorRegister4Float QueryMax[3] = { VectorSetFloat1(FRealSingle(AABB.Max().X)), VectorSetFloat1(FRealSingle(AABB.Max().Y)), VectorSetFloat1(FRealSingle(AABB.Max().Z)) };
+
+			const auto BoundsFilter = [&QueryMin, &QueryMax](const FBounds4& Bounds) -> int32
+			{
+				VectorRegister4Float Hit = VectorBitwiseAnd(VectorCompareLE(Bounds.Min[0], QueryMax[0]), VectorCompareGE(Bounds.Max[0], QueryMin[0]));
+				Hit = VectorBitwiseAnd(Hit, VectorBitwiseAnd(VectorCompareLE(Bounds.Min[1], QueryMax[1]), VectorCompareGE(Bounds.Max[1], QueryMin[1])));
+				Hit = VectorBitwiseAnd(Hit, VectorBitwiseAnd(VectorCompareLE(Bounds.Min[2], QueryMax[2]), VectorCompareGE(Bounds.Max[2], QueryMin[2])));
+				return VectorMaskBits(Hit);
+			};
+
+			const auto FaceVisitor = [&Visitor](int32 FaceIndex)
+			{
+				const bool bContinueVisiting = Visitor.VisitOverlap(FaceIndex);
+				return bContinueVisiting ? EVisitorResult::Continue : EVisitorResult::Stop;
+			};
+
+			VisitTree(BoundsFilter, FaceVisitor);
+		}
+
+		/** The faces whose quantized bounds overlap Intersection, a superset of FTrimeshBVH::FindAllIntersections */
+		TArray<int32> FindAllIntersections(const FAABB3& Intersection) const
+		{
+			struct FCollectVisitor
+			{
+				bool VisitOverlap(const int32 FaceIndex)
+				{
+					FaceIndices.Add(FaceIndex);
+					return true;
+				}
+				TArray<int32> FaceIndices;
+			};
+
+			FCollectVisitor Visitor;
+			Overlap(Intersection, Visitor);
+			return MoveTemp(Visitor.FaceIndices);
+		}
+
+		void Serialize(FChaosArchive& Ar)
+		{
+			Ar << RootFrame.Min[0] << RootFrame.Min[1] << RootFrame.Min[2];
+			Ar << RootFrame.Scale[0] << RootFrame.Scale[1] << RootFrame.Scale[2];
+
+			int32 NumNodes = Nodes.Num();
+			Ar << NumNodes;
+			if (Ar.IsLoading())
+			{
+				Nodes.SetNum(NumNodes);
+			}
+			for (FNode& Node : Nodes)
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					for (int32 ChildIndex = 0; ChildIndex < NumChildren; ++ChildIndex)
+					{
+						Ar << Node.QuantizedMin[Axis][ChildIndex];
+						Ar << Node.QuantizedMax[Axis][ChildIndex];
+					}
+				}
+				for (uint32& Child : Node.Children)
+				{
+					Ar << Child;
+				}
+			}
+
+			int32 NumFaces = FaceBounds.Num();
+			Ar << NumFaces;
+			if (Ar.IsLoading())
+			{
+				FaceBounds.SetNum(NumFaces);
+			}
+			for (FQuantizedFaceBounds& Face : FaceBounds)
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					Ar << Face.QuantizedMin[Axis];
+					Ar << Face.QuantizedMax[Axis];
+				}
+			}
+		}
+
+	private:
+		// The origin and size of one quantization step of a node or leaf. Decoded value = Min + Quantized * Scale.
+		struct FFrame
+		{
+			FRealSingle Min[3] = { 0, 0, 0 };
+			FRealSingle Scale[3] = { 0, 0, 0 };
+		};
+
+		// Bounds of four children, one register per axis
+		struct FBounds4
+		{
+			VectorRegister4Float Min[3];
+			VectorRegister4Float Max[3];
+		};
+
+		struct FRayData
+		{
+			FRayData(const FVec3& Start, const FVec3& Dir)
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					// Near-parallel axes get a huge inverse so the slab either spans all of t (start inside) or none of it
+					const FRealSingle DirAxis = FRealSingle(Dir[Axis]);
+					const FRealSingle InvDir = (FMath::Abs(DirAxis) > UE_SMALL_NUMBER) ? (1.0f / DirAxis) : ((DirAxis < 0.0f) ? -UE_BIG_NUMBER : UE_BIG_NUMBER);
+					StartSimd[Axis] = VectorSetFloat1(FRealSingle(Start[Axis]));
+					InvDirSimd[Axis] = VectorSetFloat1(InvDir);
+				}
+			}
+
+			int32 Intersect(const VectorRegister4Float (&Min)[3], const VectorRegister4Float (&Max)[3], const FRealSingle Length) const
+			{
+				VectorRegister4Float TMin = VectorZero();
+				VectorRegister4Float TMax = VectorSetFloat1(Length);
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					const VectorRegister4Float T0 = VectorMultiply(VectorSubtract(Min[Axis], StartSimd[Axis]), InvDirSimd[Axis]);
+					const VectorRegister4Float T1 = VectorMultiply(VectorSubtract(Max[Axis], StartSimd[Axis]), InvDirSimd[Axis]);
+					TMin = VectorMax(TMin, VectorMin(T0, T1));
+					TMax = VectorMin(TMax, VectorMax(T0, T1));
+				}
+				return VectorMaskBits(VectorCompareLE(TMin, TMax));
+			}
+
+			VectorRegister4Float StartSimd[3];
+			VectorRegister4Float InvDirSimd[3];
+		};
+
+		struct FBuildEntry
+		{
+			int32 Index;
+			int32 FaceCount;
+			FVec3f Min;
+			FVec3f Max;
+		};
+
+		struct FStackEntry
+		{
+			int32 NodeIndex;
+			FFrame Frame;
+		};
+
+		// Decode four quantized values per axis. Used by both the build and the queries so they agree bit for bit.
+		static FORCEINLINE void DecodeBounds(const uint16 (&QuantizedMin)[3][NumChildren], const uint16 (&QuantizedMax)[3][NumChildren], const FFrame& Frame, FBounds4& OutBounds)
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				const FRealSingle MinValues[NumChildren] = { FRealSingle(QuantizedMin[Axis][0]), FRealSingle(QuantizedMin[Axis][1]), FRealSingle(QuantizedMin[Axis][2]), FRealSingle(QuantizedMin[Axis][3]) };
+				const FRealSingle MaxValues[NumChildren] = { FRealSingle(QuantizedMax[Axis][0]), FRealSingle(QuantizedMax[Axis][1]), FRealSingle(QuantizedMax[Axis][2]), FRealSingle(QuantizedMax[Axis][3]) };
+				const VectorRegister4Float Origin = VectorSetFloat1(Frame.Min[Axis]);
+				const VectorRegister4Float Scale = VectorSetFloat1(Frame.Scale[Axis]);
+				OutBounds.Min[Axis] = VectorAdd(Origin, VectorMultiply(VectorLoad(MinValues), Scale));
+				OutBounds.Max[Axis] = VectorAdd(Origin, VectorMultiply(VectorLoad(MaxValues), Scale));
+			}
+		}
+
+		static FRealSingle DecodeValue(const uint16 Quantized, const FFrame& Frame, const int32 Axis)
+		{
+			alignas(16) FRealSingle Result[4];
+			VectorStoreAligned(VectorAdd(VectorSetFloat1(Frame.Min[Axis]), VectorMultiply(VectorSetFloat1(FRealSingle(Quantized)), VectorSetFloat1(Frame.Scale[Axis]))), Result);
+			return Result[0];
+		}
+
+		static FFrame MakeFrame(const FVec3f& Min, const FVec3f& Max)
+		{
+			FFrame Frame;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				// Pad the step so that the largest quantized value still reaches Max after float rounding
+				const FRealSingle Padding = (FMath::Abs(Min[Axis]) + FMath::Abs(Max[Axis])) * 4.0f * FLT_EPSILON + UE_SMALL_NUMBER;
+				Frame.Min[Axis] = Min[Axis];
+				Frame.Scale[Axis] = (Max[Axis] - Min[Axis] + Padding) / 65535.0f;
+			}
+			return Frame;
+		}
+
+		static FFrame MakeChildFrame(const FBounds4& Bounds, const int32 ChildIndex)
+		{
+			alignas(16) FRealSingle Values[4];
+			FVec3f Min, Max;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				VectorStoreAligned(Bounds.Min[Axis], Values);
+				Min[Axis] = Values[ChildIndex];
+				VectorStoreAligned(Bounds.Max[Axis], Values);
+				Max[Axis] = Values[ChildIndex];
+			}
+			return MakeFrame(Min, Max);
+		}
+
+		// Quantize conservatively: round outwards, then step until the decoded value contains the input
+		static void Quantize(const FFrame& Frame, const FVec3f& Min, const FVec3f& Max, uint16 (&OutMin)[3], uint16 (&OutMax)[3])
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				int32 QuantizedMin = FMath::Clamp(FMath::FloorToInt32((Min[Axis] - Frame.Min[Axis]) / Frame.Scale[Axis]), 0, 65535);
+				int32 QuantizedMax = FMath::Clamp(FMath::CeilToInt32((Max[Axis] - Frame.Min[Axis]) / Frame.Scale[Axis]), 0, 65535);
+				while ((QuantizedMin > 0) && (DecodeValue(uint16(QuantizedMin), Frame, Axis) > Min[Axis]))
+				{
+					--QuantizedMin;
+				}
+				while ((QuantizedMax < 65535) && (DecodeValue(uint16(QuantizedMax), Frame, Axis) < Max[Axis]))
+				{
+					++QuantizedMax;
+				}
+				OutMin[Axis] = uint16(QuantizedMin);
+				OutMax[Axis] = uint16(QuantizedMax);
+			}
+		}
+
+		static void GetSourceBounds(const FAABBVectorized& Bounds, FVec3f& OutMin, FVec3f& OutMax)
+		{
+			alignas(16) FRealSingle Values[4];
+			VectorStoreAligned(Bounds.GetMin(), Values);
+			OutMin = FVec3f(Values[0], Values[1], Values[2]);
+			VectorStoreAligned(Bounds.GetMax(), Values);
+			OutMax = FVec3f(Values[0], Values[1], Values[2]);
+		}
+
+		static FRealSingle GetSurfaceArea(const FBuildEntry& Entry)
+		{
+			const FVec3f Extents = Entry.Max - Entry.Min;
+			return Extents.X * Extents.Y + Extents.Y * Extents.Z + Extents.Z * Extents.X;
+		}
+
+		template <typename SourceBVHType>
+		static void AddSourceChildren(const SourceBVHType& Source, const int32 SourceNodeIndex, TArray<FBuildEntry, TInlineAllocator<NumChildren>>& OutEntries)
+		{
+			const auto& ChildData = Source.Nodes[SourceNodeIndex].Children;
+			for (int32 ChildIndex = 0; ChildIndex < 2; ++ChildIndex)
+			{
+				if (ChildData.GetChildOrFaceIndex(ChildIndex) != INDEX_NONE)
+				{
+					FBuildEntry& Entry = OutEntries.AddDefaulted_GetRef();
+					Entry.Index = ChildData.GetChildOrFaceIndex(ChildIndex);
+					Entry.FaceCount = ChildData.GetFaceCount(ChildIndex);
+					GetSourceBounds(ChildData.GetBounds(ChildIndex), Entry.Min, Entry.Max);
+				}
+			}
+		}
+
+		// Collect up to four children for a 4-wide node by repeatedly opening the largest internal binary child
+		template <typename SourceBVHType>
+		static void GatherEntries(const SourceBVHType& Source, const int32 SourceNodeIndex, TArray<FBuildEntry, TInlineAllocator<NumChildren>>& OutEntries)
+		{
+			OutEntries.Reset();
+			AddSourceChildren(Source, SourceNodeIndex, OutEntries);
+
+			while (OutEntries.Num() < NumChildren)
+			{
+				int32 OpenIndex = INDEX_NONE;
+				for (int32 EntryIndex = 0; EntryIndex < OutEntries.Num(); ++EntryIndex)
+				{
+					if ((OutEntries[EntryIndex].FaceCount == 0) && ((OpenIndex == INDEX_NONE) || (GetSurfaceArea(OutEntries[EntryIndex]) > GetSurfaceArea(OutEntries[OpenIndex]))))
+					{
+						OpenIndex = EntryIndex;
+					}
+				}
+				if (OpenIndex == INDEX_NONE)
+				{
+					break;
+				}
+
+				const int32 OpenSourceNodeIndex = OutEntries[OpenIndex].Index;
+				OutEntries.RemoveAt(OpenIndex);
+				AddSourceChildren(Source, OpenSourceNodeIndex, OutEntries);
+			}
+		}
+
+		// Returns INDEX_NONE if a leaf holds more faces than a packed child can address
+		template <typename SourceBVHType>
+		int32 BuildNode(const SourceBVHType& Source, const TArray<FBuildEntry, TInlineAllocator<NumChildren>>& Entries, const FFrame& Frame)
+		{
+			const int32 NodeIndex = Nodes.AddDefaulted();
+
+			for (int32 ChildIndex = 0; ChildIndex < Entries.Num(); ++ChildIndex)
+			{
+				uint16 QuantizedMin[3], QuantizedMax[3];
+				Quantize(Frame, Entries[ChildIndex].Min, Entries[ChildIndex].Max, QuantizedMin, QuantizedMax);
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					Nodes[NodeIndex].QuantizedMin[Axis][ChildIndex] = QuantizedMin[Axis];
+					Nodes[NodeIndex].QuantizedMax[Axis][ChildIndex] = QuantizedMax[Axis];
+				}
+			}
+
+			FBounds4 ChildBounds;
+			DecodeBounds(Nodes[NodeIndex].QuantizedMin, Nodes[NodeIndex].QuantizedMax, Frame, ChildBounds);
+
+			for (int32 ChildIndex = 0; ChildIndex < Entries.Num(); ++ChildIndex)
+			{
+				const FBuildEntry& Entry = Entries[ChildIndex];
+				const FFrame ChildFrame = MakeChildFrame(ChildBounds, ChildIndex);
+				if (Entry.FaceCount == 0)
+				{
+					TArray<FBuildEntry, TInlineAllocator<NumChildren>> ChildEntries;
+					GatherEntries(Source, Entry.Index, ChildEntries);
+					const int32 ChildNodeIndex = BuildNode(Source, ChildEntries, ChildFrame);
+					if (ChildNodeIndex == INDEX_NONE)
+					{
+						return INDEX_NONE;
+					}
+					Nodes[NodeIndex].Children[ChildIndex] = uint32(ChildNodeIndex) << FaceCountBits;
+				}
+				else
+				{
+					if (uint32(Entry.FaceCount) > MaxFaceCount)
+					{
+						return INDEX_NONE;
+					}
+					for (int32 FaceIndex = Entry.Index; FaceIndex < Entry.Index + Entry.FaceCount; ++FaceIndex)
+					{
+						FVec3f FaceMin, FaceMax;
+						GetSourceBounds(Source.FaceBounds[FaceIndex], FaceMin, FaceMax);
+						Quantize(ChildFrame, FaceMin, FaceMax, FaceBounds[FaceIndex].QuantizedMin, FaceBounds[FaceIndex].QuantizedMax);
+					}
+					Nodes[NodeIndex].Children[ChildIndex] = (uint32(Entry.Index) << FaceCountBits) | uint32(Entry.FaceCount);
+				}
+			}
+
+			return NodeIndex;
+		}
+
+		template <typename BoundsFilterType, typename FaceVisitorType>
+		FORCEINLINE_DEBUGGABLE EVisitorResult VisitFaces(const int32 StartIndex, const int32 FaceCount, const FFrame& LeafFrame, BoundsFilterType& BoundsFilter, FaceVisitorType& FaceVisitor) const
+		{
+			for (int32 GroupStart = StartIndex; GroupStart < StartIndex + FaceCount; GroupStart += NumChildren)
+			{
+				const int32 GroupCount = FMath::Min(NumChildren, StartIndex + FaceCount - GroupStart);
+
+				// Transpose the face bounds into the same layout as the node bounds so they decode and test four at a time
+				uint16 QuantizedMin[3][NumChildren] = {};
+				uint16 QuantizedMax[3][NumChildren] = {};
+				for (int32 Lane = 0; Lane < GroupCount; ++Lane)
+				{
+					const FQuantizedFaceBounds& Face = FaceBounds[GroupStart + Lane];
+					for (int32 Axis = 0; Axis < 3; ++Axis)
+					{
+						QuantizedMin[Axis][Lane] = Face.QuantizedMin[Axis];
+						QuantizedMax[Axis][Lane] = Face.QuantizedMax[Axis];
+					}
+				}
+
+				FBounds4 Bounds;
+				DecodeBounds(QuantizedMin, QuantizedMax, LeafFrame, Bounds);
+				int32 HitMask = BoundsFilter(Bounds) & ((1 << GroupCount) - 1);
+				while (HitMask != 0)
+				{
+					const int32 Lane = FMath::CountTrailingZeros(uint32(HitMask));
+					HitMask &= HitMask - 1;
+					if (FaceVisitor(GroupStart + Lane) == EVisitorResult::Stop)
+					{
+						return EVisitorResult::Stop;
+					}
+				}
+			}
+			return EVisitorResult::Continue;
+		}
+
+		template <typename BoundsFilterType, typename FaceVisitorType>
+		FORCEINLINE_DEBUGGABLE void VisitTree(BoundsFilterType& BoundsFilter, FaceVisitorType& FaceVisitor) const
+		{
+			if (Nodes.Num() == 0)
+			{
+				return;
+			}
+
+			TArray<FStackEntry, TInlineAllocator<32>> Stack;
+			Stack.Push({ 0, RootFrame });
+			while (Stack.Num())
+			{
+				const FStackEntry Entry = Stack.Pop(EAllowShrinking::No);
+				const FNode& Node = Nodes[Entry.NodeIndex];
+
+				FBounds4 ChildBounds;
+				DecodeBounds(Node.QuantizedMin, Node.QuantizedMax, Entry.Frame, ChildBounds);
+				int32 HitMask = BoundsFilter(ChildBounds);
+
+				while (HitMask != 0)
+				{
+					const int32 ChildIndex = FMath::CountTrailingZeros(uint32(HitMask));
+					HitMask &= HitMask - 1;
+
+					const uint32 Child = Node.Children[ChildIndex];
+					if (Child == InvalidChild)
+					{
+						continue;
+					}
+
+					const int32 Index = int32(Child >> FaceCountBits);
+					const int32 FaceCount = int32(Child & MaxFaceCount);
+					if (FaceCount == 0)
+					{
+						Stack.Push({ Index, MakeChildFrame(ChildBounds, ChildIndex) });
+					}
+					else if (VisitFaces(Index, FaceCount, MakeChildFrame(ChildBounds, ChildIndex), BoundsFilter, FaceVisitor) == EVisitorResult::Stop)
+					{
+						return;
+					}
+				}
+			}
+		}
+
+		FFrame RootFrame;
+		TArray<FNode> Nodes;
+		TArray<FQuantizedFaceBounds> FaceBounds;
+	};
+
+	FORCEINLINE_DEBUGGABLE FChaosArchive& operator<<(FChaosArchive& Ar, FTrimeshQuantizedBVH& QuantizedBVH)
+	{
+		QuantizedBVH.Serialize(Ar);
+		return Ar;
+	}
+}
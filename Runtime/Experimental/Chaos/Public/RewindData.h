@@ -828,6 +828,674 @@ private:
 	TArray<FPropertyInterval> Buffer;
 };
 
+namespace Private
+{
+	template <typename TFloat>
+	uint64 FloatToHistoryWord(const TFloat Value)
+	{
+		static_assert(sizeof(TFloat) <= sizeof(uint64), "History words hold at most 64 bits");
+		uint64 Word = 0;
+		FMemory::Memcpy(&Word, &Value, sizeof(TFloat));
+		return Word;
+	}
+
+	template <typename TFloat>
+	TFloat HistoryWordToFloat(const uint64 Word)
+	{
+		TFloat Value;
+		FMemory::Memcpy(&Value, &Word, sizeof(TFloat));
+		return Value;
+	}
+
+	//Appends Words xor'ed against PrevWords. A header holds one nibble per word with the number of significant bytes of the xor,
+	//followed by those bytes. Consecutive frames of a property share sign, exponent and upper mantissa so most high bytes are zero.
+	inline void EncodeHistoryWords(const uint64* Words, const uint64* PrevWords, const int32 NumWords, TArray<uint8>& OutBytes)
+	{
+		const int32 HeaderOffset = OutBytes.Num();
+		OutBytes.AddZeroed((NumWords + 1) / 2);
+		for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+		{
+			const uint64 Xor = Words[WordIndex] ^ PrevWords[WordIndex];
+			uint8 NumBytes = 0;
+			for (uint64 Remaining = Xor; Remaining != 0; Remaining >>= 8)
+			{
+				OutBytes.Add(uint8(Remaining & 0xFF));
+				++NumBytes;
+			}
+			OutBytes[HeaderOffset + WordIndex / 2] |= uint8(NumBytes << ((WordIndex & 1) * 4));
+		}
+	}
+
+	//Inverse of EncodeHistoryWords. InOutWords holds the previous words on input. Returns the number of bytes consumed
+	inline int32 DecodeHistoryWords(const uint8* Bytes, uint64* InOutWords, const int32 NumWords)
+	{
+		int32 Offset = (NumWords + 1) / 2;
+		for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+		{
+			const int32 NumBytes = (Bytes[WordIndex / 2] >> ((WordIndex & 1) * 4)) & 0xF;
+			uint64 Xor = 0;
+			for (int32 ByteIndex = 0; ByteIndex < NumBytes; ++ByteIndex)
+			{
+				Xor |= uint64(Bytes[Offset++]) << (ByteIndex * 8);
+			}
+			InOutWords[WordIndex] ^= Xor;
+		}
+		return Offset;
+	}
+}
+
+//Converts a property to and from the raw words stored by TCompressedParticlePropertyBuffer. Must round trip bit exactly
+template <typename T>
+struct TCompressedHistoryCodec;
+
+template <>
+struct TCompressedHistoryCodec<FParticlePositionRotation>
+{
+	static constexpr int32 NumWords = 7;
+
+	static void ToWords(const FParticlePositionRotation& Value, uint64* OutWords)
+	{
+		const FRotation3f R(Value.R());
+		OutWords[0] = Private::FloatToHistoryWord(Value.X().X);
+		OutWords[1] = Private::FloatToHistoryWord(Value.X().Y);
+		OutWords[2] = Private::FloatToHistoryWord(Value.X().Z);
+		OutWords[3] = Private::FloatToHistoryWord(R.X);
+		OutWords[4] = Private::FloatToHistoryWord(R.Y);
+		OutWords[5] = Private::FloatToHistoryWord(R.Z);
+		OutWords[6] = Private::FloatToHistoryWord(R.W);
+	}
+
+	static void FromWords(const uint64* Words, FParticlePositionRotation& OutValue)
+	{
+		OutValue.SetX(FVec3(Private::HistoryWordToFloat<FReal>(Words[0]), Private::HistoryWordToFloat<FReal>(Words[1]), Private::HistoryWordToFloat<FReal>(Words[2])));
+		OutValue.SetR(FRotation3(FRotation3f(Private::HistoryWordToFloat<FRealSingle>(Words[3]), Private::HistoryWordToFloat<FRealSingle>(Words[4]), Private::HistoryWordToFloat<FRealSingle>(Words[5]), Private::HistoryWordToFloat<FRealSingle>(Words[6]))));
+	}
+};
+
+template <>
+struct TCompressedHistoryCodec<FParticleVelocities>
+{
+	static constexpr int32 NumWords = 6;
+
+	static void ToWords(const FParticleVelocities& Value, uint64* OutWords)
+	{
+		const FVec3f V(Value.V());
+		const FVec3f W(Value.W());
+		OutWords[0] = Private::FloatToHistoryWord(V.X);
+		OutWords[1] = Private::FloatToHistoryWord(V.Y);
+		OutWords[2] = Private::FloatToHistoryWord(V.Z);
+		OutWords[3] = Private::FloatToHistoryWord(W.X);
+		OutWords[4] = Private::FloatToHistoryWord(W.Y);
+		OutWords[5] = Private::FloatToHistoryWord(W.Z);
+	}
+
+	static void FromWords(const uint64* Words, FParticleVelocities& OutValue)
+	{
+		OutValue.SetV(FVec3(FVec3f(Private::HistoryWordToFloat<FRealSingle>(Words[0]), Private::HistoryWordToFloat<FRealSingle>(Words[1]), Private::HistoryWordToFloat<FRealSingle>(Words[2]))));
+		OutValue.SetW(FVec3(FVec3f(Private::HistoryWordToFloat<FRealSingle>(Words[3]), Private::HistoryWordToFloat<FRealSingle>(Words[4]), Private::HistoryWordToFloat<FRealSingle>(Words[5]))));
+	}
+};
+
+/**
+ * Compressed alternative to TParticlePropertyBuffer for the high frequency properties (XR and Velocities), with the same
+ * interval semantics. Instead of a pooled copy of the property per entry, entries are stored as xor deltas against the
+ * previous entry in byte streams. Every KeyframeInterval entries a new stream starts from a keyframe, which bounds the
+ * number of deltas that have to be applied to decode an entry and lets whole streams be dropped as the history wraps.
+ * Decoding is lazy: nothing is decoded until Read is called, which in practice only happens for particles involved in a
+ * resim. The encoding is lossless since resimulation must restore the exact state that was simulated.
+ */
+template <typename T, bool bNoEntryIsHead = true>
+class TCompressedParticlePropertyBuffer
+{
+	using FCodec = TCompressedHistoryCodec<T>;
+
+public:
+	explicit TCompressedParticlePropertyBuffer(int32 InCapacity, int32 InKeyframeInterval = 8)
+	: Capacity(InCapacity)
+	, KeyframeInterval(FMath::Max(InKeyframeInterval, 1))
+	{
+	}
+
+	//Appends an entry. FrameAndPhase must be greater than that of the latest entry (x_{n+1} > x_n)
+	void WriteMonotonic(const FFrameAndPhase FrameAndPhase, const T& Value)
+	{
+		if (NumEntries)
+		{
+			FFrameAndPhase LatestFrameAndPhase;
+			GetHeadFrameAndPhase(LatestFrameAndPhase);
+			ensure(LatestFrameAndPhase < FrameAndPhase);	//Must write in monotonic growing order so that x_{n+1} > x_n
+		}
+
+		if (Streams.Num() == 0 || Streams.Last().Entries.Num() >= KeyframeInterval)
+		{
+			AddStream();
+		}
+		else if (!bLastWordsValid)
+		{
+			DecodeEntry(Streams.Num() - 1, Streams.Last().Entries.Num() - 1, LastWords);
+			bLastWordsValid = true;
+		}
+
+		uint64 Words[FCodec::NumWords];
+		FCodec::ToWords(Value, Words);
+
+		FStream& Stream = Streams.Last();
+		Stream.Entries.Add({ FrameAndPhase, Stream.Bytes.Num() });
+		Private::EncodeHistoryWords(Words, LastWords, FCodec::NumWords, Stream.Bytes);
+		FMemory::Memcpy(LastWords, Words, sizeof(Words));
+		++NumEntries;
+
+		//Keep at least Capacity entries, dropping whole streams from the tail since their deltas chain from the keyframe
+		while (Streams.Num() > 1 && NumEntries - Streams[0].Entries.Num() >= Capacity)
+		{
+			NumEntries -= Streams[0].Entries.Num();
+			FreeStreams.Add(MoveTemp(Streams[0]));
+			Streams.RemoveAt(0, 1, EAllowShrinking::No);
+		}
+	}
+
+	//Decodes the entry containing FrameAndPhase into OutValue. Returns false if there is none (the head value applies)
+	bool Read(const FFrameAndPhase FrameAndPhase, T& OutValue) const
+	{
+		int32 StreamIdx;
+		int32 EntryIdx;
+		if (!FindIdx(FrameAndPhase, StreamIdx, EntryIdx))
+		{
+			return false;
+		}
+
+		uint64 Words[FCodec::NumWords];
+		DecodeEntry(StreamIdx, EntryIdx, Words);
+		FCodec::FromWords(Words, OutValue);
+		return true;
+	}
+
+	const bool GetHeadFrameAndPhase(FFrameAndPhase& OutFrameAndPhase) const
+	{
+		if (NumEntries)
+		{
+			OutFrameAndPhase = Streams.Last().Entries.Last().FrameAndPhase;
+			return true;
+		}
+		return false;
+	}
+
+	//Get the FrameAndPhase of the oldest entry
+	const bool GetTailFrameAndPhase(FFrameAndPhase& OutFrameAndPhase) const
+	{
+		if (NumEntries)
+		{
+			OutFrameAndPhase = Streams[0].Entries[0].FrameAndPhase;
+			return true;
+		}
+		return false;
+	}
+
+	void ClearEntryAndFuture(const FFrameAndPhase FrameAndPhase)
+	{
+		while (NumEntries)
+		{
+			FStream& Stream = Streams.Last();
+			const FEntry& Entry = Stream.Entries.Last();
+			if (Entry.FrameAndPhase < FrameAndPhase)
+			{
+				break;
+			}
+
+			Stream.Bytes.SetNum(Entry.ByteOffset, EAllowShrinking::No);
+			Stream.Entries.Pop(EAllowShrinking::No);
+			--NumEntries;
+			bLastWordsValid = false;
+
+			if (Stream.Entries.Num() == 0)
+			{
+				FreeStreams.Add(Streams.Pop(EAllowShrinking::No));
+			}
+		}
+	}
+
+	//Same as ClearEntryAndFuture but decodes the removed entries into OutEntries first, oldest first
+	void PopEntryAndFuture(const FFrameAndPhase FrameAndPhase, TArray<TPair<FFrameAndPhase, T>>& OutEntries)
+	{
+		//Find the oldest entry at or after FrameAndPhase
+		int32 FirstStreamIdx = Streams.Num();
+		int32 FirstEntryIdx = 0;
+		for (int32 StreamIdx = Streams.Num() - 1; StreamIdx >= 0; --StreamIdx)
+		{
+			const TArray<FEntry>& Entries = Streams[StreamIdx].Entries;
+			int32 EntryIdx = Entries.Num();
+			while (EntryIdx > 0 && !(Entries[EntryIdx - 1].FrameAndPhase < FrameAndPhase))
+			{
+				--EntryIdx;
+			}
+			if (EntryIdx < Entries.Num())
+			{
+				FirstStreamIdx = StreamIdx;
+				FirstEntryIdx = EntryIdx;
+			}
+			if (EntryIdx > 0)
+			{
+				break;
+			}
+		}
+
+		for (int32 StreamIdx = FirstStreamIdx; StreamIdx < Streams.Num(); ++StreamIdx)
+		{
+			const FStream& Stream = Streams[StreamIdx];
+			const int32 BeginIdx = StreamIdx == FirstStreamIdx ? FirstEntryIdx : 0;
+
+			uint64 Words[FCodec::NumWords];
+			DecodeEntry(StreamIdx, BeginIdx, Words);
+			for (int32 EntryIdx = BeginIdx; EntryIdx < Stream.Entries.Num(); ++EntryIdx)
+			{
+				if (EntryIdx > BeginIdx)
+				{
+					Private::DecodeHistoryWords(&Stream.Bytes[Stream.Entries[EntryIdx].ByteOffset], Words, FCodec::NumWords);
+				}
+				TPair<FFrameAndPhase, T>& Entry = OutEntries.AddDefaulted_GetRef();
+				Entry.Key = Stream.Entries[EntryIdx].FrameAndPhase;
+				FCodec::FromWords(Words, Entry.Value);
+			}
+		}
+
+		ClearEntryAndFuture(FrameAndPhase);
+	}
+
+	void Reset()
+	{
+		while (Streams.Num())
+		{
+			FreeStreams.Add(Streams.Pop(EAllowShrinking::No));
+		}
+		NumEntries = 0;
+		bLastWordsValid = false;
+	}
+
+	//Reset and free all the memory
+	void Empty()
+	{
+		Streams.Empty();
+		FreeStreams.Empty();
+		NumEntries = 0;
+		bLastWordsValid = false;
+	}
+
+	bool IsEmpty() const
+	{
+		return NumEntries == 0;
+	}
+
+	bool IsClean(const FFrameAndPhase FrameAndPhase) const
+	{
+		int32 StreamIdx;
+		int32 EntryIdx;
+		return !FindIdx(FrameAndPhase, StreamIdx, EntryIdx);
+	}
+
+	int32 Num() const
+	{
+		return NumEntries;
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T AllocatedSize = Streams.GetAllocatedSize() + FreeStreams.GetAllocatedSize();
+		for (const FStream& Stream : Streams)
+		{
+			AllocatedSize += Stream.Entries.GetAllocatedSize() + Stream.Bytes.GetAllocatedSize();
+		}
+		for (const FStream& Stream : FreeStreams)
+		{
+			AllocatedSize += Stream.Entries.GetAllocatedSize() + Stream.Bytes.GetAllocatedSize();
+		}
+		return AllocatedSize;
+	}
+
+private:
+	struct FEntry
+	{
+		FFrameAndPhase FrameAndPhase;
+		int32 ByteOffset;
+	};
+
+	//A keyframe (encoded against zero) followed by deltas against the previous entry
+	struct FStream
+	{
+		TArray<FEntry> Entries;
+		TArray<uint8> Bytes;
+	};
+
+	void AddStream()
+	{
+		FStream& Stream = FreeStreams.Num() ? Streams.Add_GetRef(FreeStreams.Pop(EAllowShrinking::No)) : Streams.AddDefaulted_GetRef();
+		Stream.Entries.Reset();
+		Stream.Bytes.Reset();
+		FMemory::Memzero(LastWords, sizeof(LastWords));
+		bLastWordsValid = true;
+	}
+
+	void DecodeEntry(const int32 StreamIdx, const int32 EntryIdx, uint64* OutWords) const
+	{
+		const FStream& Stream = Streams[StreamIdx];
+		FMemory::Memzero(OutWords, sizeof(uint64) * FCodec::NumWords);
+		for (int32 Idx = 0; Idx <= EntryIdx; ++Idx)
+		{
+			Private::DecodeHistoryWords(&Stream.Bytes[Stream.Entries[Idx].ByteOffset], OutWords, FCodec::NumWords);
+		}
+	}
+
+	//Finds the oldest entry at or after FrameAndPhase, see TParticlePropertyBuffer::FindIdx
+	bool FindIdx(const FFrameAndPhase FrameAndPhase, int32& OutStreamIdx, int32& OutEntryIdx) const
+	{
+		OutStreamIdx = INDEX_NONE;
+		OutEntryIdx = INDEX_NONE;
+		for (int32 StreamIdx = Streams.Num() - 1; StreamIdx >= 0; --StreamIdx)
+		{
+			const TArray<FEntry>& Entries = Streams[StreamIdx].Entries;
+			int32 EntryIdx = Entries.Num() - 1;
+			for (; EntryIdx >= 0 && !(Entries[EntryIdx].FrameAndPhase < FrameAndPhase); --EntryIdx)
+			{
+				OutStreamIdx = StreamIdx;
+				OutEntryIdx = EntryIdx;
+			}
+			if (EntryIdx >= 0)
+			{
+				//no reason to keep searching, frame is bigger than everything before this
+				break;
+			}
+		}
+
+		if (OutStreamIdx == INDEX_NONE)
+		{
+			return false;
+		}
+
+		//when entries represent the frame the property was dirtied on (rather than an interval) they have to match exactly
+		return bNoEntryIsHead || Streams[OutStreamIdx].Entries[OutEntryIdx].FrameAndPhase == FrameAndPhase;
+	}
+
+	int32 Capacity;
+	int32 KeyframeInterval;
+	int32 NumEntries = 0;
+	TArray<FStream> Streams;
+	TArray<FStream> FreeStreams;
+
+	//Words of the latest entry, which the next delta is encoded against. Rebuilt on demand after ClearEntryAndFuture
+	uint64 LastWords[FCodec::NumWords];
+	bool bLastWordsValid = false;
+};
+
+//When set, newly created particle histories store XR and Velocities in TCompressedParticlePropertyBuffer (p.Chaos.RewindData.CompressHighFrequencyHistory)
+extern CHAOS_API bool bChaos_RewindData_CompressHighFrequencyHistory;
+
+/**
+ * History buffer for the high frequency properties. Exposes the TParticlePropertyBuffer interface and stores the entries
+ * either pooled or compressed, picked from bChaos_RewindData_CompressHighFrequencyHistory when the buffer is created.
+ *
+ * In compressed mode writes go to a staging area which is encoded on the next mutation, since the write accessors hand out
+ * a reference that is filled in after the call. Read decodes into storage owned by the caller, so concurrent const reads
+ * don't share state. Entries removed by ClearEntryAndFuture are kept decoded until the next write so that
+ * RestoreBufferState can bring them back, like the pooled buffer does.
+ */
+template <typename T, EChaosProperty PropName, bool bNoEntryIsHead = true>
+class TSelectableParticlePropertyBuffer
+{
+	using FEntry = TPair<FFrameAndPhase, T>;
+
+public:
+	using FValueType = T;
+
+	explicit TSelectableParticlePropertyBuffer(int32 InCapacity)
+	: Pooled(InCapacity)
+	, Compressed(InCapacity)
+	, bCompressed(bChaos_RewindData_CompressHighFrequencyHistory)
+	{
+	}
+
+	TSelectableParticlePropertyBuffer(TSelectableParticlePropertyBuffer&& Other) = default;
+	TSelectableParticlePropertyBuffer(const TSelectableParticlePropertyBuffer& Other) = delete;
+
+	bool IsCompressed() const
+	{
+		return bCompressed;
+	}
+
+	T& WriteAccessMonotonic(const FFrameAndPhase FrameAndPhase, FDirtyPropertiesPool& Manager)
+	{
+		if (!bCompressed)
+		{
+			return Pooled.WriteAccessMonotonic(FrameAndPhase, Manager);
+		}
+
+		FFrameAndPhase LatestFrameAndPhase;
+		if (GetHeadFrameAndPhase(LatestFrameAndPhase))
+		{
+			ensure(LatestFrameAndPhase < FrameAndPhase);	//Must write in monotonic growing order so that x_{n+1} > x_n
+		}
+		return StageWrite(FrameAndPhase);
+	}
+
+	T* WriteAccessNonDecreasing(const FFrameAndPhase FrameAndPhase, FDirtyPropertiesPool& Manager)
+	{
+		if (!bCompressed)
+		{
+			return Pooled.WriteAccessNonDecreasing(FrameAndPhase, Manager);
+		}
+
+		FFrameAndPhase LatestFrameAndPhase;
+		if (GetHeadFrameAndPhase(LatestFrameAndPhase))
+		{
+			ensure(LatestFrameAndPhase <= FrameAndPhase);	//Must write in growing order so that x_{n+1} >= x_n
+			if (LatestFrameAndPhase == FrameAndPhase)
+			{
+				//Already wrote once for this FrameAndPhase so skip
+				return nullptr;
+			}
+		}
+		return &StageWrite(FrameAndPhase);
+	}
+
+	//Returns the entry containing FrameAndPhase, which may be decoded into OutStorage. Valid as long as OutStorage and the buffer are unchanged
+	const T* Read(const FFrameAndPhase FrameAndPhase, const FDirtyPropertiesPool& Manager, T& OutStorage) const
+	{
+		if (!bCompressed)
+		{
+			return Pooled.Read(FrameAndPhase, Manager);
+		}
+
+		//Staged entries are all newer than the compressed ones, so only look at them if the compressed buffer has nothing
+		if (Compressed.Read(FrameAndPhase, OutStorage))
+		{
+			return &OutStorage;
+		}
+		const int32 StagedIdx = FindStagedIdx(FrameAndPhase);
+		return StagedIdx != INDEX_NONE ? &Staged[StagedIdx].Value : nullptr;
+	}
+
+	const bool GetHeadFrameAndPhase(FFrameAndPhase& OutFrameAndPhase) const
+	{
+		if (!bCompressed)
+		{
+			return Pooled.GetHeadFrameAndPhase(OutFrameAndPhase);
+		}
+
+		if (Staged.Num())
+		{
+			OutFrameAndPhase = Staged.Last().Key;
+			return true;
+		}
+		return Compressed.GetHeadFrameAndPhase(OutFrameAndPhase);
+	}
+
+	void Release(FDirtyPropertiesPool& Manager)
+	{
+		Pooled.Release(Manager);
+		Compressed.Empty();
+		Staged.Empty();
+		Cleared.Empty();
+	}
+
+	void Reset()
+	{
+		Pooled.Reset();
+		Compressed.Reset();
+		Staged.Reset();
+		Cleared.Reset();
+	}
+
+	bool IsEmpty() const
+	{
+		return bCompressed ? (Compressed.IsEmpty() && Staged.Num() == 0) : Pooled.IsEmpty();
+	}
+
+	void ClearEntryAndFuture(const FFrameAndPhase FrameAndPhase)
+	{
+		if (!bCompressed)
+		{
+			Pooled.ClearEntryAndFuture(FrameAndPhase);
+			return;
+		}
+
+		FlushStaged();
+
+		//Anything cleared earlier is newer than what is left, so the newly removed entries go in front
+		TArray<FEntry> Removed;
+		Compressed.PopEntryAndFuture(FrameAndPhase, Removed);
+		Cleared.Insert(MoveTemp(Removed), 0);
+	}
+
+	void ExtractBufferState(int32& ValidCount, int32& NextIterator) const
+	{
+		if (!bCompressed)
+		{
+			Pooled.ExtractBufferState(ValidCount, NextIterator);
+			return;
+		}
+
+		ValidCount = Compressed.Num() + Staged.Num();
+		NextIterator = INDEX_NONE;
+	}
+
+	void RestoreBufferState(const int32& ValidCount, const int32& NextIterator)
+	{
+		if (!bCompressed)
+		{
+			Pooled.RestoreBufferState(ValidCount, NextIterator);
+			return;
+		}
+
+		//Drop the newest entries, keeping them around in case a later restore wants them back
+		const int32 NumToRemove = Compressed.Num() + Staged.Num() - ValidCount;
+		if (NumToRemove > 0)
+		{
+			TArray<FEntry> All;
+			FFrameAndPhase TailFrameAndPhase;
+			if (Compressed.GetTailFrameAndPhase(TailFrameAndPhase))
+			{
+				Compressed.PopEntryAndFuture(TailFrameAndPhase, All);
+			}
+			All.Append(Staged.GetData(), Staged.Num());
+			Cleared.Insert(All.GetData() + All.Num() - NumToRemove, NumToRemove, 0);
+			All.SetNum(All.Num() - NumToRemove, EAllowShrinking::No);
+			Staged = MoveTemp(All);
+		}
+		else if (NumToRemove < 0)
+		{
+			const int32 NumToRestore = FMath::Min(-NumToRemove, Cleared.Num());
+			ensureMsgf(NumToRestore == -NumToRemove, TEXT("Restoring %d entries but only %d were cleared"), -NumToRemove, Cleared.Num());
+			Staged.Append(Cleared.GetData(), NumToRestore);
+			Cleared.RemoveAt(0, NumToRestore, EAllowShrinking::No);
+		}
+
+		FlushStaged();
+	}
+
+	bool IsClean(const FFrameAndPhase FrameAndPhase) const
+	{
+		if (!bCompressed)
+		{
+			return Pooled.IsClean(FrameAndPhase);
+		}
+		return Compressed.IsClean(FrameAndPhase) && FindStagedIdx(FrameAndPhase) == INDEX_NONE;
+	}
+
+	template <typename THandle>
+	bool IsInSync(const THandle& Handle, const FFrameAndPhase FrameAndPhase, const FDirtyPropertiesPool& Pool) const
+	{
+		T Storage;
+		if (const T* Val = Read(FrameAndPhase, Pool, Storage))
+		{
+			T HeadVal;
+			CopyDataFromObject(HeadVal, Handle);
+			return *Val == HeadVal;
+		}
+
+		return NoEntryInSync<THandle, T, bNoEntryIsHead>::Helper(Handle);
+	}
+
+	T& Insert(const FFrameAndPhase FrameAndPhase, FDirtyPropertiesPool& Manager)
+	{
+		if (!bCompressed)
+		{
+			return Pooled.Insert(FrameAndPhase, Manager);
+		}
+
+		//Entries can't be inserted into the middle of a stream, so decode everything from FrameAndPhase on and stage it again
+		FlushStaged();
+		Cleared.Reset();
+		Compressed.PopEntryAndFuture(FrameAndPhase, Staged);
+
+		//Same rules as TParticlePropertyBuffer::Insert: reuse the interval containing FrameAndPhase, or add a new one
+		if (Staged.Num() == 0 || (!bNoEntryIsHead && !(Staged[0].Key == FrameAndPhase)))
+		{
+			Staged.Insert(FEntry(FrameAndPhase, T()), 0);
+		}
+		return Staged[0].Value;
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Compressed.GetAllocatedSize() + Staged.GetAllocatedSize() + Cleared.GetAllocatedSize();
+	}
+
+private:
+	T& StageWrite(const FFrameAndPhase FrameAndPhase)
+	{
+		FlushStaged();
+		Cleared.Reset();
+		return Staged.Add_GetRef(FEntry(FrameAndPhase, T())).Value;
+	}
+
+	//Encodes the staged entries. References handed out by the write accessors are invalid afterwards
+	void FlushStaged()
+	{
+		for (const FEntry& Entry : Staged)
+		{
+			Compressed.WriteMonotonic(Entry.Key, Entry.Value);
+		}
+		Staged.Reset();
+	}
+
+	//Same search as TParticlePropertyBuffer::FindIdx over the staged entries
+	int32 FindStagedIdx(const FFrameAndPhase FrameAndPhase) const
+	{
+		for (int32 Idx = 0; Idx < Staged.Num(); ++Idx)
+		{
+			if (!(Staged[Idx].Key < FrameAndPhase))
+			{
+				return (bNoEntryIsHead || Staged[Idx].Key == FrameAndPhase) ? Idx : INDEX_NONE;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	TParticlePropertyBuffer<T, PropName, bNoEntryIsHead> Pooled;
+	TCompressedParticlePropertyBuffer<T, bNoEntryIsHead> Compressed;
+	TArray<FEntry> Staged;
+	TArray<FEntry> Cleared;
+	bool bCompressed;
+};
+
 
 enum EDesyncResult
 {
@@ -1004,6 +1672,12 @@ private:
 		const auto Data = State ? State->PROP.Read(FrameAndPhase, Pool) : nullptr;\
 		return Data ? Data->NAME() : Head.NAME();\
 
+// For TSelectableParticlePropertyBuffer, whose entries may be decoded into local storage, so the value is returned by copy
+#define REWIND_CHAOS_DECODED_PARTICLE_PROPERTY(PROP, NAME)\
+		decltype(State->PROP)::FValueType Storage;\
+		const auto Data = State ? State->PROP.Read(FrameAndPhase, Pool, Storage) : nullptr;\
+		return Data ? Data->NAME() : Head.NAME();\
+
 #define REWIND_CHAOS_ZERO_PARTICLE_PROPERTY(PROP, NAME)\
 		const auto Data = State ? State->PROP.Read(FrameAndPhase, Pool) : nullptr;\
 		return Data ? Data->NAME() : ZeroVector;\
@@ -1015,6 +1689,20 @@ private:
 		REWIND_CHAOS_PARTICLE_PROPERTY(PROP, NAME);\
 	}\
 
+#define REWIND_PARTICLE_STATIC_DECODED_PROPERTY(PROP, NAME)\
+	auto NAME() const\
+	{\
+		auto& Head = Particle;\
+		REWIND_CHAOS_DECODED_PARTICLE_PROPERTY(PROP, NAME);\
+	}\
+
+#define REWIND_PARTICLE_KINEMATIC_DECODED_PROPERTY(PROP, NAME)\
+	auto NAME() const\
+	{\
+		auto& Head = *Particle.CastToKinematicParticle();\
+		REWIND_CHAOS_DECODED_PARTICLE_PROPERTY(PROP, NAME);\
+	}\
+
 #define REWIND_PARTICLE_KINEMATIC_PROPERTY(PROP, NAME)\
 	decltype(auto) NAME() const\
 	{\
@@ -1158,9 +1846,9 @@ struct FGeometryParticleStateBase
 		PreCorrectionXR.SetR(Particle.GetR());
 	}
 
-	TParticlePropertyBuffer<FParticlePositionRotation,EChaosProperty::XR> ParticlePositionRotation;
+	TSelectableParticlePropertyBuffer<FParticlePositionRotation,EChaosProperty::XR> ParticlePositionRotation;
 	TParticlePropertyBuffer<FParticleNonFrequentData,EChaosProperty::NonFrequentData> NonFrequentData;
-	TParticlePropertyBuffer<FParticleVelocities,EChaosProperty::Velocities> Velocities;
+	TSelectableParticlePropertyBuffer<FParticleVelocities,EChaosProperty::Velocities> Velocities;
 	TParticlePropertyBuffer<FParticleDynamics,EChaosProperty::Dynamics, /*bNoEntryIsHead=*/false> Dynamics;
 	TParticlePropertyBuffer<FParticleDynamicMisc,EChaosProperty::DynamicMisc> DynamicsMisc;
 	TParticlePropertyBuffer<FParticleMassProps,EChaosProperty::MassProps> MassProps;
@@ -1195,11 +1883,11 @@ public:
 	}
 
 
-	REWIND_PARTICLE_STATIC_PROPERTY(ParticlePositionRotation, GetX)
-	REWIND_PARTICLE_STATIC_PROPERTY(ParticlePositionRotation, GetR)
+	REWIND_PARTICLE_STATIC_DECODED_PROPERTY(ParticlePositionRotation, GetX)
+	REWIND_PARTICLE_STATIC_DECODED_PROPERTY(ParticlePositionRotation, GetR)
 
-	REWIND_PARTICLE_KINEMATIC_PROPERTY(Velocities, GetV)
-	REWIND_PARTICLE_KINEMATIC_PROPERTY(Velocities, GetW)
+	REWIND_PARTICLE_KINEMATIC_DECODED_PROPERTY(Velocities, GetV)
+	REWIND_PARTICLE_KINEMATIC_DECODED_PROPERTY(Velocities, GetW)
 
 	REWIND_PARTICLE_RIGID_PROPERTY(DynamicsMisc, LinearEtherDrag)
 	REWIND_PARTICLE_RIGID_PROPERTY(DynamicsMisc, AngularEtherDrag)
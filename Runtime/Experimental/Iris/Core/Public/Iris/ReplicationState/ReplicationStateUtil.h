@@ -8,6 +8,7 @@
 #include "Net/Core/DirtyNetObjectTracker/GlobalDirtyNetObjectTracker.h"
 #include "Iris/ReplicationState/ReplicationStateDescriptor.h"
 #include "Iris/ReplicationState/ReplicationStateFwd.h"
+#include "Iris/Serialization/NetSerializer.h"
 
 namespace UE::Net
 {
@@ -71,4 +72,95 @@ inline void MarkDirty(UE::Net::FReplicationStateHeader& InternalState, FNetBitAr
 	MemberChangeMask.SetBits(ChangeMaskInfo.BitOffset, ChangeMaskInfo.BitCount);
 }
 
+
+/**
+ * A run of consecutive members using the same serializer and config, with a constant non-zero distance between the members in both the external and internal state.
+ * Each member of the run has a single changemask bit, directly following the bit of the previous member.
+ */
+struct FReplicationStateMemberRun
+{
+	uint16 FirstMemberIndex;
+	uint16 MemberCount;
+	uint32 ExternalStride;
+	uint32 InternalStride;
+};
+
+/**
+ * Split the members of a state into runs that can be passed to the serializers' QuantizeArray, DequantizeArray and IsEqualArray functions.
+ * Members with dynamic state or more than one changemask bit always get a run of their own.
+ */
+inline void GetReplicationStateMemberRuns(const FReplicationStateDescriptor* Descriptor, TArray<FReplicationStateMemberRun>& OutRuns)
+{
+	OutRuns.Reset();
+	for (uint16 MemberIt = 0, MemberEndIt = Descriptor->MemberCount; MemberIt < MemberEndIt; ++MemberIt)
+	{
+		const FReplicationStateMemberSerializerDescriptor& SerializerDescriptor = Descriptor->MemberSerializerDescriptors[MemberIt];
+		const bool bCanJoinRun = !EnumHasAnyFlags(Descriptor->MemberTraitsDescriptors[MemberIt].Traits, EReplicationStateMemberTraits::HasDynamicState) && (Descriptor->MemberChangeMaskDescriptors[MemberIt].BitCount == 1U);
+
+		if (bCanJoinRun && OutRuns.Num() > 0)
+		{
+			FReplicationStateMemberRun& Run = OutRuns.Last();
+			const uint16 PrevMemberIndex = Run.FirstMemberIndex + Run.MemberCount - 1U;
+			const FReplicationStateMemberSerializerDescriptor& RunSerializerDescriptor = Descriptor->MemberSerializerDescriptors[Run.FirstMemberIndex];
+			const bool bRunCanGrow = !EnumHasAnyFlags(Descriptor->MemberTraitsDescriptors[Run.FirstMemberIndex].Traits, EReplicationStateMemberTraits::HasDynamicState) && (Descriptor->MemberChangeMaskDescriptors[Run.FirstMemberIndex].BitCount == 1U);
+			if (bRunCanGrow && SerializerDescriptor.Serializer == RunSerializerDescriptor.Serializer && SerializerDescriptor.SerializerConfig == RunSerializerDescriptor.SerializerConfig)
+			{
+				const FReplicationStateMemberDescriptor& MemberDescriptor = Descriptor->MemberDescriptors[MemberIt];
+				const FReplicationStateMemberDescriptor& PrevMemberDescriptor = Descriptor->MemberDescriptors[PrevMemberIndex];
+				const bool bHasNextChangeMaskBit = Descriptor->MemberChangeMaskDescriptors[MemberIt].BitOffset == Descriptor->MemberChangeMaskDescriptors[PrevMemberIndex].BitOffset + 1U;
+				// Members sharing or preceding the offset of the previous member can't be addressed with a stride
+				const bool bHasPositiveStrides = (MemberDescriptor.ExternalMemberOffset > PrevMemberDescriptor.ExternalMemberOffset) && (MemberDescriptor.InternalMemberOffset > PrevMemberDescriptor.InternalMemberOffset);
+				const uint32 ExternalStride = MemberDescriptor.ExternalMemberOffset - PrevMemberDescriptor.ExternalMemberOffset;
+				const uint32 InternalStride = MemberDescriptor.InternalMemberOffset - PrevMemberDescriptor.InternalMemberOffset;
+				if (bHasNextChangeMaskBit && bHasPositiveStrides && (Run.MemberCount == 1U || (ExternalStride == Run.ExternalStride && InternalStride == Run.InternalStride)))
+				{
+					Run.ExternalStride = ExternalStride;
+					Run.InternalStride = InternalStride;
+					++Run.MemberCount;
+					continue;
+				}
+			}
+		}
+
+		OutRuns.Add(FReplicationStateMemberRun{MemberIt, 1U, 0U, 0U});
+	}
+}
+
+/** Quantize a run of members from the external state buffer to the internal state buffer. */
+inline void QuantizeMemberRun(FNetSerializationContext& Context, const FReplicationStateDescriptor* Descriptor, const FReplicationStateMemberRun& Run, uint8* InternalBuffer, const uint8* ExternalBuffer)
+{
+	const FReplicationStateMemberSerializerDescriptor& SerializerDescriptor = Descriptor->MemberSerializerDescriptors[Run.FirstMemberIndex];
+	const FReplicationStateMemberDescriptor& MemberDescriptor = Descriptor->MemberDescriptors[Run.FirstMemberIndex];
+	const FReplicationStateMemberChangeMaskDescriptor& ChangeMaskDescriptor = Descriptor->MemberChangeMaskDescriptors[Run.FirstMemberIndex];
+
+	if (SerializerDescriptor.Serializer->QuantizeArray != nullptr && (Run.MemberCount == 1U || (Run.ExternalStride > 0U && Run.InternalStride > 0U)))
+	{
+		FNetQuantizeArrayArgs Args;
+		Args.Version = 0;
+		Args.NetSerializerConfig = SerializerDescriptor.SerializerConfig;
+		Args.ChangeMaskInfo.BitOffset = ChangeMaskDescriptor.BitOffset;
+		Args.ChangeMaskInfo.BitCount = ChangeMaskDescriptor.BitCount;
+		Args.Source = NetSerializerValuePointer(ExternalBuffer + MemberDescriptor.ExternalMemberOffset);
+		Args.Target = NetSerializerValuePointer(InternalBuffer + MemberDescriptor.InternalMemberOffset);
+		Args.ElementCount = Run.MemberCount;
+		Args.SourceStride = Run.ExternalStride;
+		Args.TargetStride = Run.InternalStride;
+		SerializerDescriptor.Serializer->QuantizeArray(Context, Args);
+		return;
+	}
+
+	// Serializers not built with TNetSerializer may lack the array functions
+	for (uint16 MemberIt = Run.FirstMemberIndex, MemberEndIt = Run.FirstMemberIndex + Run.MemberCount; MemberIt < MemberEndIt; ++MemberIt)
+	{
+		FNetQuantizeArgs Args;
+		Args.Version = 0;
+		Args.NetSerializerConfig = SerializerDescriptor.SerializerConfig;
+		Args.ChangeMaskInfo.BitOffset = Descriptor->MemberChangeMaskDescriptors[MemberIt].BitOffset;
+		Args.ChangeMaskInfo.BitCount = Descriptor->MemberChangeMaskDescriptors[MemberIt].BitCount;
+		Args.Source = NetSerializerValuePointer(ExternalBuffer + Descriptor->MemberDescriptors[MemberIt].ExternalMemberOffset);
+		Args.Target = NetSerializerValuePointer(InternalBuffer + Descriptor->MemberDescriptors[MemberIt].InternalMemberOffset);
+		SerializerDescriptor.Serializer->Quantize(Context, Args);
+	}
+}
+
 }
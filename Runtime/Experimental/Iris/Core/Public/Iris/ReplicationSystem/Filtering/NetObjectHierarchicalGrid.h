@@ -0,0 +1,322 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "Math/Vector.h"
+#include "Math/VectorRegister.h"
+#include "Net/Core/NetBitArray.h"
+
+namespace UE::Net::Private
+{
+
+/**
+ * Hierarchical spatial hash of replicated objects for distance based relevancy, in the spirit of THierarchicalHashGrid2D.
+ *
+ * Each level doubles the cell size of the previous one. An object is stored in exactly one cell, on the lowest level where the
+ * cell size is at least its cull distance. A viewer can then only be within the cull distance of objects stored in its own cell
+ * or the eight neighbouring cells on each level, so a query touches 9 cells per level regardless of how many objects there are
+ * or how large their cull distances are, and large objects are never duplicated into many cells.
+ *
+ * Cells store the object positions and squared cull distances as separate float arrays so the exact distance test runs four
+ * objects at a time. Positions are stored relative to the origin of their cell, which is kept in double precision, so the
+ * precision of the test only depends on the cell size and not on how far from the world origin the cell is.
+ * Objects whose cull distance exceeds the cell size of the top level are kept in a separate list that is tested against every viewer.
+ * @see UNetObjectHierarchicalGridWorldLocFilter
+ */
+class FNetObjectHierarchicalGrid
+{
+public:
+	/**
+	 * @param InBaseCellSize The cell size of the lowest level. Should be around the smallest common cull distance.
+	 * @param InLevelCount The number of levels. The top level cell size is InBaseCellSize * 2^(InLevelCount - 1).
+	 */
+	void Init(float InBaseCellSize, uint32 InLevelCount)
+	{
+		Reset();
+		BaseCellSize = FMath::Max(InBaseCellSize, 1.0f);
+		LevelCount = FMath::Clamp(InLevelCount, 1U, MaxLevelCount);
+	}
+
+	void Reset()
+	{
+		CellKeyToCellIndex.Reset();
+		Cells.Reset();
+		FreeCellIndices.Reset();
+		ObjectLocations.Reset();
+	}
+
+	/** Add an object or update its position and cull distance. */
+	void AddOrUpdateObject(uint32 ObjectIndex, const FVector& Position, float CullDistance)
+	{
+		FVector CellOrigin;
+		const uint64 CellKey = CalculateCellKey(Position, CullDistance, CellOrigin);
+		const int32 CellIndex = GetOrAddCell(CellKey, CellOrigin);
+
+		if (ObjectIndex < static_cast<uint32>(ObjectLocations.Num()) && ObjectLocations[ObjectIndex].CellIndex != INDEX_NONE)
+		{
+			FObjectLocation& Location = ObjectLocations[ObjectIndex];
+			if (Location.CellIndex == CellIndex)
+			{
+				Cells[CellIndex].Set(Location.Slot, ObjectIndex, Position, CullDistance);
+				return;
+			}
+			RemoveObject(ObjectIndex);
+		}
+
+		if (ObjectIndex >= static_cast<uint32>(ObjectLocations.Num()))
+		{
+			ObjectLocations.SetNum(ObjectIndex + 1U);
+		}
+
+		FCell& Cell = Cells[CellIndex];
+		ObjectLocations[ObjectIndex] = FObjectLocation{CellIndex, Cell.Num()};
+		Cell.Add(ObjectIndex, Position, CullDistance);
+	}
+
+	void RemoveObject(uint32 ObjectIndex)
+	{
+		if (ObjectIndex >= static_cast<uint32>(ObjectLocations.Num()) || ObjectLocations[ObjectIndex].CellIndex == INDEX_NONE)
+		{
+			return;
+		}
+
+		FObjectLocation& Location = ObjectLocations[ObjectIndex];
+		FCell& Cell = Cells[Location.CellIndex];
+		const uint32 MovedObjectIndex = Cell.RemoveAtSwap(Location.Slot);
+		if (MovedObjectIndex != ObjectIndex)
+		{
+			ObjectLocations[MovedObjectIndex].Slot = Location.Slot;
+		}
+
+		if (Cell.Num() == 0)
+		{
+			CellKeyToCellIndex.Remove(Cell.Key);
+			FreeCellIndices.Add(Location.CellIndex);
+		}
+
+		Location = FObjectLocation();
+	}
+
+	/** Returns the squared cull distance the object was added with, or a negative value if it isn't in the grid. */
+	float GetObjectCullDistanceSq(uint32 ObjectIndex) const
+	{
+		if (ObjectIndex >= static_cast<uint32>(ObjectLocations.Num()) || ObjectLocations[ObjectIndex].CellIndex == INDEX_NONE)
+		{
+			return -1.0f;
+		}
+
+		const FObjectLocation& Location = ObjectLocations[ObjectIndex];
+		return Cells[Location.CellIndex].CullDistanceSq[Location.Slot];
+	}
+
+	/** Set the bit of every object that is within its cull distance of any of the view positions. Bits are only ever set. */
+	void FindRelevantObjects(TConstArrayView<FVector> ViewPositions, FNetBitArrayView OutRelevantObjects) const
+	{
+		for (const FVector& ViewPos : ViewPositions)
+		{
+			for (uint32 Level = 0; Level < LevelCount; ++Level)
+			{
+				const double CellSize = GetCellSize(Level);
+				const int64 CenterX = FMath::FloorToInt64(ViewPos.X/CellSize);
+				const int64 CenterY = FMath::FloorToInt64(ViewPos.Y/CellSize);
+				for (int64 Y = CenterY - 1; Y <= CenterY + 1; ++Y)
+				{
+					for (int64 X = CenterX - 1; X <= CenterX + 1; ++X)
+					{
+						if (const int32* CellIndex = CellKeyToCellIndex.Find(MakeCellKey(Level, X, Y)))
+						{
+							Cells[*CellIndex].FindRelevantObjects(ViewPos, OutRelevantObjects);
+						}
+					}
+				}
+			}
+
+			if (const int32* CellIndex = CellKeyToCellIndex.Find(OversizedCellKey))
+			{
+				Cells[*CellIndex].FindRelevantObjects(ViewPos, OutRelevantObjects);
+			}
+		}
+	}
+
+	uint32 GetLevelCount() const { return LevelCount; }
+	double GetCellSize(uint32 Level) const { return double(BaseCellSize)*double(uint64(1) << Level); }
+
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T AllocatedSize = CellKeyToCellIndex.GetAllocatedSize() + Cells.GetAllocatedSize() + FreeCellIndices.GetAllocatedSize() + ObjectLocations.GetAllocatedSize();
+		for (const FCell& Cell : Cells)
+		{
+			AllocatedSize += Cell.GetAllocatedSize();
+		}
+		return AllocatedSize;
+	}
+
+private:
+	enum : uint32
+	{
+		MaxLevelCount = 15U,
+	};
+
+	// Level in the top 4 bits and 30 bits per cell coordinate. The oversized objects use the otherwise unused level 15.
+	static constexpr uint64 OversizedCellKey = uint64(MaxLevelCount) << 60U;
+
+	static uint64 MakeCellKey(uint32 Level, int64 X, int64 Y)
+	{
+		constexpr uint64 CoordMask = (uint64(1) << 30U) - 1U;
+		return (uint64(Level) << 60U) | ((uint64(X) & CoordMask) << 30U) | (uint64(Y) & CoordMask);
+	}
+
+	/**
+	 * @param OutCellOrigin The origin to use if the cell doesn't exist yet. Cells are unbounded along Z, and the oversized cell in all directions,
+	 * so those coordinates are taken from the object that creates the cell.
+	 */
+	uint64 CalculateCellKey(const FVector& Position, float CullDistance, FVector& OutCellOrigin) const
+	{
+		uint32 Level = 0;
+		while (Level < LevelCount && GetCellSize(Level) < CullDistance)
+		{
+			++Level;
+		}
+
+		if (Level == LevelCount)
+		{
+			OutCellOrigin = Position;
+			return OversizedCellKey;
+		}
+
+		const double CellSize = GetCellSize(Level);
+		const int64 X = FMath::FloorToInt64(Position.X/CellSize);
+		const int64 Y = FMath::FloorToInt64(Position.Y/CellSize);
+		OutCellOrigin = FVector(double(X)*CellSize, double(Y)*CellSize, Position.Z);
+		return MakeCellKey(Level, X, Y);
+	}
+
+	struct FObjectLocation
+	{
+		int32 CellIndex = INDEX_NONE;
+		int32 Slot = INDEX_NONE;
+	};
+
+	struct FCell
+	{
+		uint64 Key = 0;
+		/** The positions below are relative to this. */
+		FVector Origin = FVector::ZeroVector;
+		TArray<uint32> ObjectIndices;
+		TArray<float> X;
+		TArray<float> Y;
+		TArray<float> Z;
+		TArray<float> CullDistanceSq;
+
+		int32 Num() const { return ObjectIndices.Num(); }
+
+		void Reset(uint64 InKey, const FVector& InOrigin)
+		{
+			Key = InKey;
+			Origin = InOrigin;
+			ObjectIndices.Reset();
+			X.Reset();
+			Y.Reset();
+			Z.Reset();
+			CullDistanceSq.Reset();
+		}
+
+		void Add(uint32 ObjectIndex, const FVector& Position, float CullDistance)
+		{
+			ObjectIndices.Add(ObjectIndex);
+			X.Add(static_cast<float>(Position.X - Origin.X));
+			Y.Add(static_cast<float>(Position.Y - Origin.Y));
+			Z.Add(static_cast<float>(Position.Z - Origin.Z));
+			CullDistanceSq.Add(CullDistance*CullDistance);
+		}
+
+		void Set(int32 Slot, uint32 ObjectIndex, const FVector& Position, float CullDistance)
+		{
+			ObjectIndices[Slot] = ObjectIndex;
+			X[Slot] = static_cast<float>(Position.X - Origin.X);
+			Y[Slot] = static_cast<float>(Position.Y - Origin.Y);
+			Z[Slot] = static_cast<float>(Position.Z - Origin.Z);
+			CullDistanceSq[Slot] = CullDistance*CullDistance;
+		}
+
+		/** @return The object index that was moved into Slot. */
+		uint32 RemoveAtSwap(int32 Slot)
+		{
+			ObjectIndices.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+			X.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+			Y.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+			Z.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+			CullDistanceSq.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+			return Slot < ObjectIndices.Num() ? ObjectIndices[Slot] : ~0U;
+		}
+
+		void FindRelevantObjects(const FVector& ViewPos, FNetBitArrayView& OutRelevantObjects) const
+		{
+			// Move the view into the cell's frame in double precision before dropping to float
+			const float ViewPosX = static_cast<float>(ViewPos.X - Origin.X);
+			const float ViewPosY = static_cast<float>(ViewPos.Y - Origin.Y);
+			const float ViewPosZ = static_cast<float>(ViewPos.Z - Origin.Z);
+			const VectorRegister4Float ViewX = VectorSetFloat1(ViewPosX);
+			const VectorRegister4Float ViewY = VectorSetFloat1(ViewPosY);
+			const VectorRegister4Float ViewZ = VectorSetFloat1(ViewPosZ);
+
+			const int32 ObjectCount = Num();
+			int32 ObjectIt = 0;
+			for (; ObjectIt + 4 <= ObjectCount; ObjectIt += 4)
+			{
+				const VectorRegister4Float DeltaX = VectorSubtract(VectorLoad(X.GetData() + ObjectIt), ViewX);
+				const VectorRegister4Float DeltaY = VectorSubtract(VectorLoad(Y.GetData() + ObjectIt), ViewY);
+				const VectorRegister4Float DeltaZ = VectorSubtract(VectorLoad(Z.GetData() + ObjectIt), ViewZ);
+				const VectorRegister4Float DistSq = VectorMultiplyAdd(DeltaZ, DeltaZ, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaX, DeltaX)));
+				uint32 RelevantMask = static_cast<uint32>(VectorMaskBits(VectorCompareLE(DistSq, VectorLoad(CullDistanceSq.GetData() + ObjectIt))));
+				for (; RelevantMask != 0U; RelevantMask &= RelevantMask - 1U)
+				{
+					OutRelevantObjects.SetBit(ObjectIndices[ObjectIt + FPlatformMath::CountTrailingZeros(RelevantMask)]);
+				}
+			}
+
+			for (; ObjectIt < ObjectCount; ++ObjectIt)
+			{
+				const float DeltaX = X[ObjectIt] - ViewPosX;
+				const float DeltaY = Y[ObjectIt] - ViewPosY;
+				const float DeltaZ = Z[ObjectIt] - ViewPosZ;
+				if (DeltaX*DeltaX + DeltaY*DeltaY + DeltaZ*DeltaZ <= CullDistanceSq[ObjectIt])
+				{
+					OutRelevantObjects.SetBit(ObjectIndices[ObjectIt]);
+				}
+			}
+		}
+
+		SIZE_T GetAllocatedSize() const
+		{
+			return ObjectIndices.GetAllocatedSize() + X.GetAllocatedSize() + Y.GetAllocatedSize() + Z.GetAllocatedSize() + CullDistanceSq.GetAllocatedSize();
+		}
+	};
+
+	int32 GetOrAddCell(uint64 Key, const FVector& Origin)
+	{
+		if (const int32* CellIndex = CellKeyToCellIndex.Find(Key))
+		{
+			return *CellIndex;
+		}
+
+		const int32 CellIndex = FreeCellIndices.Num() > 0 ? FreeCellIndices.Pop(EAllowShrinking::No) : Cells.AddDefaulted();
+		Cells[CellIndex].Reset(Key, Origin);
+		CellKeyToCellIndex.Add(Key, CellIndex);
+		return CellIndex;
+	}
+
+	float BaseCellSize = 10000.0f;
+	uint32 LevelCount = 1U;
+
+	TMap<uint64, int32> CellKeyToCellIndex;
+	TArray<FCell> Cells;
+	TArray<int32> FreeCellIndices;
+	TArray<FObjectLocation> ObjectLocations;
+};
+
+}
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Iris/ReplicationSystem/Filtering/NetObjectFilter.h"
+#include "Iris/ReplicationSystem/Filtering/NetObjectHierarchicalGrid.h"
+#include "Iris/ReplicationSystem/NetCullDistanceOverrides.h"
+#include "Iris/ReplicationSystem/ReplicationSystem.h"
+#include "Iris/ReplicationSystem/WorldLocations.h"
+#include "UObject/StrongObjectPtr.h"
+#include "NetObjectHierarchicalGridFilter.generated.h"
+
+/**
+ * Settings for UNetObjectHierarchicalGridWorldLocFilter.
+ */
+UCLASS(transient, config=Engine, MinimalAPI)
+class UNetObjectHierarchicalGridFilterConfig : public UNetObjectFilterConfig
+{
+	GENERATED_BODY()
+
+public:
+	/** The cell size of the lowest level. Should be around the smallest common cull distance. */
+	UPROPERTY(Config)
+	float BaseCellSize = 5000.0f;
+
+	/** The number of levels, each doubling the cell size of the previous one. Objects with larger cull distances than the top level cell size are tested against every viewer. */
+	UPROPERTY(Config)
+	uint32 LevelCount = 6;
+
+	/** Objects without a cull distance will assume to have this value unless there's a cull distance override. */
+	UPROPERTY(Config)
+	float DefaultCullDistance = 15000.0f;
+};
+
+/**
+ * Distance based filter for replicated objects that have a WorldLocation (e.g. Actors), backed by FNetObjectHierarchicalGrid.
+ *
+ * Unlike UNetObjectGridWorldLocFilter, which inserts each object into every cell its cull distance overlaps, each object is stored
+ * in a single cell on the level matching its cull distance, so the cost of moving an object doesn't grow with its cull distance.
+ * The exact cull distance is always used and objects are culled as soon as no view is within their cull distance.
+ */
+UCLASS(transient, MinimalAPI)
+class UNetObjectHierarchicalGridWorldLocFilter : public UNetObjectFilter
+{
+	GENERATED_BODY()
+
+protected:
+	// UNetObjectFilter interface
+	virtual void OnInit(const FNetObjectFilterInitParams&) override;
+	virtual void OnDeinit() override;
+	virtual void OnMaxInternalNetRefIndexIncreased(uint32 NewMaxInternalIndex) override;
+	virtual bool AddObject(uint32 ObjectIndex, FNetObjectFilterAddObjectParams&) override;
+	virtual void RemoveObject(uint32 ObjectIndex, const FNetObjectFilteringInfo&) override;
+	virtual void PreFilter(FNetObjectPreFilteringParams&) override;
+	virtual void Filter(FNetObjectFilteringParams&) override;
+
+private:
+	void AddOrUpdateObject(uint32 ObjectIndex);
+	void UpdateObjectIfCullDistanceChanged(uint32 ObjectIndex);
+	float GetCullDistance(uint32 ObjectIndex) const;
+
+	TStrongObjectPtr<UNetObjectHierarchicalGridFilterConfig> Config;
+	UE::Net::Private::FNetObjectHierarchicalGrid Grid;
+	const UE::Net::FWorldLocations* WorldLocations = nullptr;
+	const UE::Net::FNetCullDistanceOverrides* NetCullDistanceOverrides = nullptr;
+
+	/** Objects that were last added to the grid with a cull distance override */
+	UE::Net::FNetBitArray ObjectsWithCullDistanceOverride;
+};
+
+inline void UNetObjectHierarchicalGridWorldLocFilter::OnInit(const FNetObjectFilterInitParams& Params)
+{
+	AddFilterTraits(ENetFilterTraits::Spatial);
+
+	Config = TStrongObjectPtr<UNetObjectHierarchicalGridFilterConfig>(CastChecked<UNetObjectHierarchicalGridFilterConfig>(Params.Config));
+	WorldLocations = &Params.ReplicationSystem->GetWorldLocations();
+	NetCullDistanceOverrides = &Params.ReplicationSystem->GetNetCullDistanceOverrides();
+	Grid.Init(Config->BaseCellSize, Config->LevelCount);
+	ObjectsWithCullDistanceOverride.Init(Params.CurrentMaxInternalIndex);
+}
+
+inline void UNetObjectHierarchicalGridWorldLocFilter::OnDeinit()
+{
+	Grid.Reset();
+	ObjectsWithCullDistanceOverride.Init(0);
+	WorldLocations = nullptr;
+	NetCullDistanceOverrides = nullptr;
+	Config.Reset();
+}
+
+inline void UNetObjectHierarchicalGridWorldLocFilter::OnMaxInternalNetRefIndexIncreased(uint32 NewMaxInternalIndex)
+{
+	ObjectsWithCullDistanceOverride.SetNumBits(NewMaxInternalIndex);
+}
+
+inline bool UNetObjectHierarchicalGridWorldLocFilter::AddObject(uint32 ObjectIndex, FNetObjectFilterAddObjectParams& Params)
+{
+	if (!WorldLocations->HasInfoForObject(ObjectIndex))
+	{
+		return false;
+	}
+
+	AddOrUpdateObject(ObjectIndex);
+	return true;
+}
+
+inline void UNetObjectHierarchicalGridWorldLocFilter::RemoveObject(uint32 ObjectIndex, const FNetObjectFilteringInfo&)
+{
+	Grid.RemoveObject(ObjectIndex);
+	ObjectsWithCullDistanceOverride.ClearBit(ObjectIndex);
+}
+
+inline void UNetObjectHierarchicalGridWorldLocFilter::PreFilter(FNetObjectPreFilteringParams&)
+{
+	// Only objects whose location or cull distance changed since the last update need to move in the grid
+	UE::Net::FNetBitArrayView::ForAllSetBits(GetFilteredObjects(), WorldLocations->GetObjectsWithDirtyInfo(), UE::Net::FNetBitArrayBase::AndOp, [this](uint32 ObjectIndex)
+	{
+		AddOrUpdateObject(ObjectIndex);
+	});
+
+	// Cull distance overrides aren't dirty tracked. Compare the objects that have one against the distance they were added with,
+	// and re-resolve the objects whose override was cleared since.
+	const UE::Net::FNetBitArray& ObjectsWithOverride = NetCullDistanceOverrides->GetObjectsWithCullDistanceOverride();
+	UE::Net::FNetBitArrayView::ForAllSetBits(GetFilteredObjects(), UE::Net::MakeNetBitArrayView(ObjectsWithOverride), UE::Net::FNetBitArrayBase::AndOp, [this](uint32 ObjectIndex)
+	{
+		UpdateObjectIfCullDistanceChanged(ObjectIndex);
+	});
+	UE::Net::FNetBitArray::ForAllSetBits(ObjectsWithCullDistanceOverride, ObjectsWithOverride, UE::Net::FNetBitArrayBase::AndNotOp, [this](uint32 ObjectIndex)
+	{
+		AddOrUpdateObject(ObjectIndex);
+	});
+}
+
+inline void UNetObjectHierarchicalGridWorldLocFilter::Filter(FNetObjectFilteringParams& Params)
+{
+	TArray<FVector, TInlineAllocator<UE_IRIS_INLINE_VIEWS_PER_CONNECTION>> ViewPositions;
+	for (const UE::Net::FReplicationView::FView& View : Params.View.Views)
+	{
+		ViewPositions.Add(View.Pos);
+	}
+
+	Params.OutAllowedObjects.ClearAllBits();
+	Grid.FindRelevantObjects(ViewPositions, Params.OutAllowedObjects);
+}
+
+inline void UNetObjectHierarchicalGridWorldLocFilter::AddOrUpdateObject(uint32 ObjectIndex)
+{
+	Grid.AddOrUpdateObject(ObjectIndex, WorldLocations->GetWorldLocation(ObjectIndex), GetCullDistance(ObjectIndex));
+	ObjectsWithCullDistanceOverride.SetBitValue(ObjectIndex, NetCullDistanceOverrides->HasCullDistanceOverride(ObjectIndex));
+}
+
+inline void UNetObjectHierarchicalGridWorldLocFilter::UpdateObjectIfCullDistanceChanged(uint32 ObjectIndex)
+{
+	const float CullDistance = GetCullDistance(ObjectIndex);
+	if (Grid.GetObjectCullDistanceSq(ObjectIndex) != CullDistance*CullDistance)
+	{
+		AddOrUpdateObject(ObjectIndex);
+	}
+	else
+	{
+		ObjectsWithCullDistanceOverride.SetBit(ObjectIndex);
+	}
+}
+
+inline float UNetObjectHierarchicalGridWorldLocFilter::GetCullDistance(uint32 ObjectIndex) const
+{
+	const float CullDistanceSqr = NetCullDistanceOverrides->GetCullDistanceSqr(ObjectIndex);
+	if (CullDistanceSqr >= 0.0f)
+	{
+		return FMath::Sqrt(CullDistanceSqr);
+	}
+
+	const float CullDistance = WorldLocations->GetCullDistance(ObjectIndex);
+	return CullDistance > 0.0f ? CullDistance : Config->DefaultCullDistance;
+}
@@ -39,6 +39,9 @@ public:
 	/** Set cull distance override for object. */
 	void SetCullDistanceSqr(uint32 ObjectIndex, float CullDistSqr);
 
+	/** Returns the objects that have a cull distance override. Changes aren't tracked, users that cache cull distances must compare them. */
+	const FNetBitArray& GetObjectsWithCullDistanceOverride() const { return ValidCullDistanceSqr; }
+
 	/** Called when the maximum InternalNetRefIndex increased and we need to realloc our lists */
 	void OnMaxInternalNetRefIndexIncreased(UE::Net::Private::FInternalNetRefIndex NewMaxInternalIndex);
 
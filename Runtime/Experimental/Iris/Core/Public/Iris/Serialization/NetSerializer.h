@@ -117,6 +117,15 @@ struct FExampleNetSerializer
 
 	/** Serializers that want to be selective about which members to modify in the target instance when applying state should implement Apply where the serializer is responsible for setting the members of the target instance. The function operates on non-quantized state. */
 	static void Apply(FNetSerializationContext&, const FNetApplyArgs&);
+
+	/**
+	 * Optional. Quantize, Dequantize and IsEqual for a run of values of this serializer's type, for example consecutive members of a replication state.
+	 * The defaults call the single value functions directly, which allows them to be inlined and vectorized by the compiler.
+	 * Implement these when a hand written SIMD kernel does better.
+	 */
+	static void QuantizeArray(FNetSerializationContext&, const FNetQuantizeArrayArgs&);
+	static void DequantizeArray(FNetSerializationContext&, const FNetDequantizeArrayArgs&);
+	static bool IsEqualArray(FNetSerializationContext&, const FNetIsEqualArrayArgs&);
 };
 UE_NET_IMPLEMENT_SERIALIZER(FExampleNetSerializer);
 
@@ -338,6 +347,66 @@ struct FNetApplyArgs : FNetSerializerBaseArgs
 };
 typedef void(*NetApplyFunction)(FNetSerializationContext&, const FNetApplyArgs&);
 
+/**
+ * Parameters passed to a NetSerializer's QuantizeArray function.
+ * Quantizes ElementCount values, with the i:th value found at Source + i*SourceStride and stored at Target + i*TargetStride.
+ * Each value has a single changemask bit. ChangeMaskInfo describes the bit of the first value and the i:th value uses bit ChangeMaskInfo.BitOffset + i.
+ * Both strides are non-zero. The result must be identical to calling Quantize for each value.
+ */
+struct FNetQuantizeArrayArgs : FNetSerializerBaseArgs
+{
+	/** A pointer to the first non-quantized value. */
+	NetSerializerValuePointer Source;
+	/** A pointer to the first quantized value. */
+	NetSerializerValuePointer Target;
+	/** The number of values. */
+	uint32 ElementCount = 0;
+	/** The distance in bytes between two consecutive source values. */
+	uint32 SourceStride = 0;
+	/** The distance in bytes between two consecutive quantized values. */
+	uint32 TargetStride = 0;
+};
+typedef void(*NetQuantizeArrayFunction)(FNetSerializationContext&, const FNetQuantizeArrayArgs&);
+
+/**
+ * Parameters passed to a NetSerializer's DequantizeArray function.
+ * The result must be identical to calling Dequantize for each value. @see FNetQuantizeArrayArgs
+ */
+struct FNetDequantizeArrayArgs : FNetSerializerBaseArgs
+{
+	/** A pointer to the first quantized value. */
+	NetSerializerValuePointer Source;
+	/** A pointer to the first non-quantized value. */
+	NetSerializerValuePointer Target;
+	/** The number of values. */
+	uint32 ElementCount = 0;
+	/** The distance in bytes between two consecutive quantized values. */
+	uint32 SourceStride = 0;
+	/** The distance in bytes between two consecutive source values. */
+	uint32 TargetStride = 0;
+};
+typedef void(*NetDequantizeArrayFunction)(FNetSerializationContext&, const FNetDequantizeArrayArgs&);
+
+/**
+ * Parameters passed to a NetSerializer's IsEqualArray function.
+ * IsEqualArray returns true if all ElementCount values in Source0 are equal to the corresponding values in Source1, as determined by IsEqual.
+ * Both runs use the same Stride.
+ */
+struct FNetIsEqualArrayArgs : FNetSerializerBaseArgs
+{
+	/** Source data or quantized data. */
+	NetSerializerValuePointer Source0;
+	/** Source data or quantized data to compare with. */
+	NetSerializerValuePointer Source1;
+	/** The number of values. */
+	uint32 ElementCount = 0;
+	/** The distance in bytes between two consecutive values. */
+	uint32 Stride = 0;
+	/** Whether the data pointed to is source or quantized form. */
+	bool bStateIsQuantized = false;
+};
+typedef bool(*NetIsEqualArrayFunction)(FNetSerializationContext&, const FNetIsEqualArrayArgs&);
+
 /**
  * Various traits that can be set for a FNetSerializer.
  * These traits are typically set via constexpr bool in the declaration of the serializer.
@@ -390,6 +459,9 @@ struct FNetSerializer
 	NetFreeDynamicStateFunction FreeDynamicState;
 	NetCollectNetReferencesFunction CollectNetReferences;
 	NetApplyFunction Apply;
+	NetQuantizeArrayFunction QuantizeArray;
+	NetDequantizeArrayFunction DequantizeArray;
+	NetIsEqualArrayFunction IsEqualArray;
 	const FNetSerializerConfig* DefaultConfig;
 	uint16 QuantizedTypeSize;
 	uint16 QuantizedTypeAlignment;
@@ -431,6 +503,9 @@ public:
 		Serializer.FreeDynamicState = Builder.GetFreeDynamicStateFunction();
 		Serializer.CollectNetReferences = Builder.GetCollectNetReferencesFunction();
 		Serializer.Apply = Builder.GetApplyFunction();
+		Serializer.QuantizeArray = Builder.GetQuantizeArrayFunction();
+		Serializer.DequantizeArray = Builder.GetDequantizeArrayFunction();
+		Serializer.IsEqualArray = Builder.GetIsEqualArrayFunction();
 
 		Serializer.DefaultConfig = Builder.GetDefaultConfig();
 
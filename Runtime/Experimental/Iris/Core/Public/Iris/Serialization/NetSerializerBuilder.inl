@@ -100,6 +100,63 @@ NetIsEqualDefault(FNetSerializationContext& Context, const FNetIsEqualArgs& Args
 	return *reinterpret_cast<const T*>(Args.Source0) == *reinterpret_cast<const T*>(Args.Source1);
 }
 
+template<NetQuantizeFunction Quantize>
+void
+NetQuantizeArrayDefault(FNetSerializationContext& Context, const FNetQuantizeArrayArgs& Args)
+{
+	FNetQuantizeArgs ElementArgs;
+	ElementArgs.Version = Args.Version;
+	ElementArgs.NetSerializerConfig = Args.NetSerializerConfig;
+	ElementArgs.ChangeMaskInfo = Args.ChangeMaskInfo;
+	for (uint32 ElementIt = 0, ElementEndIt = Args.ElementCount; ElementIt != ElementEndIt; ++ElementIt)
+	{
+		ElementArgs.ChangeMaskInfo.BitOffset = Args.ChangeMaskInfo.BitOffset + ElementIt;
+		ElementArgs.Source = Args.Source + ElementIt*Args.SourceStride;
+		ElementArgs.Target = Args.Target + ElementIt*Args.TargetStride;
+		Quantize(Context, ElementArgs);
+	}
+}
+
+template<NetDequantizeFunction Dequantize>
+void
+NetDequantizeArrayDefault(FNetSerializationContext& Context, const FNetDequantizeArrayArgs& Args)
+{
+	FNetDequantizeArgs ElementArgs;
+	ElementArgs.Version = Args.Version;
+	ElementArgs.NetSerializerConfig = Args.NetSerializerConfig;
+	ElementArgs.ChangeMaskInfo = Args.ChangeMaskInfo;
+	for (uint32 ElementIt = 0, ElementEndIt = Args.ElementCount; ElementIt != ElementEndIt; ++ElementIt)
+	{
+		ElementArgs.ChangeMaskInfo.BitOffset = Args.ChangeMaskInfo.BitOffset + ElementIt;
+		ElementArgs.Source = Args.Source + ElementIt*Args.SourceStride;
+		ElementArgs.Target = Args.Target + ElementIt*Args.TargetStride;
+		Dequantize(Context, ElementArgs);
+	}
+}
+
+template<NetIsEqualFunction IsEqual>
+bool
+NetIsEqualArrayDefault(FNetSerializationContext& Context, const FNetIsEqualArrayArgs& Args)
+{
+	FNetIsEqualArgs ElementArgs;
+	ElementArgs.Version = Args.Version;
+	ElementArgs.NetSerializerConfig = Args.NetSerializerConfig;
+	ElementArgs.ChangeMaskInfo = Args.ChangeMaskInfo;
+	ElementArgs.bStateIsQuantized = Args.bStateIsQuantized;
+	for (uint32 ElementIt = 0, ElementEndIt = Args.ElementCount; ElementIt != ElementEndIt; ++ElementIt)
+	{
+		ElementArgs.ChangeMaskInfo.BitOffset = Args.ChangeMaskInfo.BitOffset + ElementIt;
+		ElementArgs.Source0 = Args.Source0 + ElementIt*Args.Stride;
+		ElementArgs.Source1 = Args.Source1 + ElementIt*Args.Stride;
+		if (!IsEqual(Context, ElementArgs))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 template<typename T = void>
 bool
 NetValidateDefault(FNetSerializationContext& Context, const FNetValidateArgs& Args)
@@ -237,6 +294,15 @@ private:
 	template<typename U> static ETrueType TestHasApply(FSignatureCheck<NetApplyFunction, &U::Apply>*);
 	template<typename> static EFalseType TestHasApply(...);
 
+	template<typename U> static ETrueType TestHasQuantizeArray(FSignatureCheck<NetQuantizeArrayFunction, &U::QuantizeArray>*);
+	template<typename> static EFalseType TestHasQuantizeArray(...);
+
+	template<typename U> static ETrueType TestHasDequantizeArray(FSignatureCheck<NetDequantizeArrayFunction, &U::DequantizeArray>*);
+	template<typename> static EFalseType TestHasDequantizeArray(...);
+
+	template<typename U> static ETrueType TestHasIsEqualArray(FSignatureCheck<NetIsEqualArrayFunction, &U::IsEqualArray>*);
+	template<typename> static EFalseType TestHasIsEqualArray(...);
+
 	enum ETraits : unsigned
 	{
 		HasVersion = unsigned(decltype(TestHasVersion<NetSerializerImpl>(nullptr))::Value),
@@ -278,6 +344,9 @@ private:
 		HasCloneDynamicState = unsigned(decltype(TestHasCloneDynamicState<NetSerializerImpl>(nullptr))::Value),
 		HasCollectNetReferences = unsigned(decltype(TestHasCollectNetReferences<NetSerializerImpl>(nullptr))::Value),
 		HasApply = unsigned(decltype(TestHasApply<NetSerializerImpl>(nullptr))::Value),
+		HasQuantizeArray = unsigned(decltype(TestHasQuantizeArray<NetSerializerImpl>(nullptr))::Value),
+		HasDequantizeArray = unsigned(decltype(TestHasDequantizeArray<NetSerializerImpl>(nullptr))::Value),
+		HasIsEqualArray = unsigned(decltype(TestHasIsEqualArray<NetSerializerImpl>(nullptr))::Value),
 	};
 
 public:
@@ -402,6 +471,34 @@ public:
 	template<typename T = void, typename U = typename TEnableIf<!HasApply, T>::Type, char V = 0>
 	static NetApplyFunction GetApplyFunction() { return NetApplyFunction(nullptr); }
 
+	// Provide default QuantizeArray, DequantizeArray and IsEqualArray implementations if needed. The defaults call the single value function for each value.
+	template<typename T = void, typename U = typename TEnableIf<HasQuantizeArray, T>::Type, bool V = true>
+	static NetQuantizeArrayFunction GetQuantizeArrayFunction() { return NetSerializerImpl::QuantizeArray; }
+
+	template<typename T = void, typename U = typename TEnableIf<!HasQuantizeArray && HasQuantize, T>::Type, char V = 0>
+	static NetQuantizeArrayFunction GetQuantizeArrayFunction() { return NetQuantizeArrayDefault<NetSerializerImpl::Quantize>; }
+
+	template<typename T = void, typename U = typename TEnableIf<!HasQuantizeArray && !HasQuantize, T>::Type, int V = 0>
+	static NetQuantizeArrayFunction GetQuantizeArrayFunction() { return NetQuantizeArrayDefault<NetQuantizeDefault<typename NetSerializerImpl::SourceType>>; }
+
+	template<typename T = void, typename U = typename TEnableIf<HasDequantizeArray, T>::Type, bool V = true>
+	static NetDequantizeArrayFunction GetDequantizeArrayFunction() { return NetSerializerImpl::DequantizeArray; }
+
+	template<typename T = void, typename U = typename TEnableIf<!HasDequantizeArray && HasDequantize, T>::Type, char V = 0>
+	static NetDequantizeArrayFunction GetDequantizeArrayFunction() { return NetDequantizeArrayDefault<NetSerializerImpl::Dequantize>; }
+
+	template<typename T = void, typename U = typename TEnableIf<!HasDequantizeArray && !HasDequantize, T>::Type, int V = 0>
+	static NetDequantizeArrayFunction GetDequantizeArrayFunction() { return NetDequantizeArrayDefault<NetDequantizeDefault<typename NetSerializerImpl::SourceType>>; }
+
+	template<typename T = void, typename U = typename TEnableIf<HasIsEqualArray, T>::Type, bool V = true>
+	static NetIsEqualArrayFunction GetIsEqualArrayFunction() { return NetSerializerImpl::IsEqualArray; }
+
+	template<typename T = void, typename U = typename TEnableIf<!HasIsEqualArray && HasIsEqual, T>::Type, char V = 0>
+	static NetIsEqualArrayFunction GetIsEqualArrayFunction() { return NetIsEqualArrayDefault<NetSerializerImpl::IsEqual>; }
+
+	template<typename T = void, typename U = typename TEnableIf<!HasIsEqualArray && !HasIsEqual, T>::Type, int V = 0>
+	static NetIsEqualArrayFunction GetIsEqualArrayFunction() { return NetIsEqualArrayDefault<NetIsEqualDefault<typename NetSerializerImpl::SourceType>>; }
+
 	// CloneDynamicState
 	template<typename T = void, typename U = typename TEnableIf<HasCloneDynamicState && (IsForwardingSerializer() || HasDynamicState()), T>::Type, bool V = true>
 	static NetCloneDynamicStateFunction GetCloneDynamicStateFunction() { return NetSerializerImpl::CloneDynamicState; }
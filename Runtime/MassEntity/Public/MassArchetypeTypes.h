@@ -213,3 +213,62 @@ struct FMassQueryRequirementIndicesMapping
 		return EntityFragments.Num() == 0 || ChunkFragments.Num() == 0;
 	}
 };
+
+//////////////////////////////////////////////////////////////////////
+// FMassChunkChangeVersions
+
+/**
+ * Per-chunk record of the FMassEntityManager change version at which each of the archetype's fragments and chunk
+ * fragments was last written. Indexed like the archetype's fragment and chunk fragment configs.
+ * Every path that writes fragment data is expected to stamp it, not only FMassExecutionContext:
+ *	- a newly allocated chunk starts with all versions set to the version it has been allocated at,
+ *	- entities created in, or moved into, a chunk (archetype changes, chunk compaction) stamp all of its fragments,
+ *	- FMassEntityManager value setters, the command buffer's Set and AddFragmentInstances commands and mutable
+ *	  FMassEntityView access stamp the fragments they write.
+ * Writes done outside of processor execution use a fresh FMassEntityManager::IncrementChangeVersion, so that they
+ * count as newer than any processor's last run.
+ */
+struct FMassChunkChangeVersions
+{
+	void Initialize(const int32 NumFragments, const int32 NumChunkFragments, const uint32 Version)
+	{
+		FragmentVersions.Init(Version, NumFragments);
+		ChunkFragmentVersions.Init(Version, NumChunkFragments);
+	}
+
+	/** Marks every fragment and chunk fragment as written at Version, used when entities get added to the chunk */
+	void StampAll(const uint32 Version)
+	{
+		for (uint32& FragmentVersion : FragmentVersions)
+		{
+			FragmentVersion = Version;
+		}
+		for (uint32& ChunkFragmentVersion : ChunkFragmentVersions)
+		{
+			ChunkFragmentVersion = Version;
+		}
+	}
+
+	void StampFragment(const int32 FragmentIndex, const uint32 Version)
+	{
+		FragmentVersions[FragmentIndex] = Version;
+	}
+
+	void StampFragments(TConstArrayView<int32> FragmentIndices, const uint32 Version)
+	{
+		for (const int32 FragmentIndex : FragmentIndices)
+		{
+			FragmentVersions[FragmentIndex] = Version;
+		}
+	}
+
+	uint32 GetFragmentVersion(const int32 FragmentIndex) const { return FragmentVersions[FragmentIndex]; }
+
+	/** Used to bind FMassExecutionContext's fragment views, which stamp on mutable access */
+	uint32* GetFragmentVersionPtr(const int32 FragmentIndex) { return &FragmentVersions[FragmentIndex]; }
+	uint32* GetChunkFragmentVersionPtr(const int32 ChunkFragmentIndex) { return &ChunkFragmentVersions[ChunkFragmentIndex]; }
+
+private:
+	TArray<uint32, TInlineAllocator<16>> FragmentVersions;
+	TArray<uint32, TInlineAllocator<4>> ChunkFragmentVersions;
+};
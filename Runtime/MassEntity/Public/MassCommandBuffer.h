@@ -165,6 +165,13 @@ public:
 	}
 	bool IsFlushing() const { return bIsFlushing; }
 
+	/**
+	 * Opts this buffer in to merging composition changing commands during Flush (see
+	 * FMassBatchedCommand::GatherCompositionChanges). Off by default.
+	 */
+	void SetGatherCompositionChanges(const bool bInGatherCompositionChanges) { bGatherCompositionChanges = bInGatherCompositionChanges; }
+	bool IsGatheringCompositionChanges() const { return bGatherCompositionChanges; }
+
 private:
 	friend FMassEntityManager;
 
@@ -190,6 +197,10 @@ private:
 
 	/** 
 	 * Executes all accumulated commands. 
+	 * Commands are executed in EMassCommandOperationType order. If bGatherCompositionChanges is set, commands that only
+	 * change entity composition (see FMassBatchedCommand::GatherCompositionChanges) are not executed one by one; their
+	 * changes are merged per entity and applied with FMassEntityManager::BatchApplyCompositionChanges at the end of
+	 * their operation type's slot, before any command of the following operation type runs.
 	 * @return whether any commands have actually been executed
 	 */
 	bool Flush(FMassEntityManager& EntityManager);
@@ -215,6 +226,9 @@ private:
 	/** Indicates that this specific MassCommandBuffer is currently flushing its contents */
 	bool bIsFlushing = false;
 
+	/** Whether Flush merges composition changing commands, see SetGatherCompositionChanges */
+	bool bGatherCompositionChanges = false;
+
 	/** 
 	 * Identifies the thread where given FMassCommandBuffer instance was created. Adding commands from other
 	 * threads is not supported and we use this value to check that.
@@ -75,6 +75,155 @@ namespace UE::Mass::Utils
 	}
 } // namespace UE::Mass::Utils
 
+/**
+ * Accumulates the fragment and tag changes of several commands into a single net composition delta per entity, so that
+ * FMassCommandBuffer::Flush can move every entity to its final archetype once instead of once per command.
+ * Adding a type cancels a pending removal of the same type and vice versa, so the last command wins. A fragment that
+ * gets removed and then added again is recorded in FragmentsToReset, so that, like with separate Remove and Add
+ * commands, it ends up default-initialized rather than keeping its previous value.
+ * Note that changes are only ever merged within a single EMassCommandOperationType slot.
+ */
+struct FMassCommandCompositionChanges
+{
+	struct FDelta
+	{
+		FMassFragmentBitSet FragmentsToAdd;
+		FMassFragmentBitSet FragmentsToRemove;
+		/** Fragments that have been removed and re-added. Entities already owning them get them re-initialized. */
+		FMassFragmentBitSet FragmentsToReset;
+		FMassTagBitSet TagsToAdd;
+		FMassTagBitSet TagsToRemove;
+
+		bool IsEmpty() const
+		{
+			return FragmentsToAdd.IsEmpty() && FragmentsToRemove.IsEmpty() && TagsToAdd.IsEmpty() && TagsToRemove.IsEmpty();
+		}
+
+		bool operator==(const FDelta& Other) const
+		{
+			return FragmentsToAdd == Other.FragmentsToAdd && FragmentsToRemove == Other.FragmentsToRemove
+				&& FragmentsToReset == Other.FragmentsToReset && TagsToAdd == Other.TagsToAdd && TagsToRemove == Other.TagsToRemove;
+		}
+
+		friend uint32 GetTypeHash(const FDelta& Delta)
+		{
+			return HashCombine(HashCombine(HashCombine(GetTypeHash(Delta.FragmentsToAdd), GetTypeHash(Delta.FragmentsToRemove))
+				, GetTypeHash(Delta.FragmentsToReset)), HashCombine(GetTypeHash(Delta.TagsToAdd), GetTypeHash(Delta.TagsToRemove)));
+		}
+	};
+
+	/** Entities sharing both the source archetype and the delta. They all end up in the same target archetype. */
+	struct FGroup
+	{
+		FMassArchetypeHandle SourceArchetype;
+		FDelta Delta;
+		TArray<FMassEntityHandle> Entities;
+	};
+
+	void ChangeFragments(TConstArrayView<FMassEntityHandle> Entities, const FMassFragmentBitSet& ToAdd, const FMassFragmentBitSet& ToRemove)
+	{
+		for (const FMassEntityHandle Entity : Entities)
+		{
+			FDelta& Delta = Deltas.FindOrAdd(Entity);
+			Delta.FragmentsToReset -= ToRemove;
+			Delta.FragmentsToReset += Delta.FragmentsToRemove.GetOverlap(ToAdd);
+			Delta.FragmentsToAdd -= ToRemove;
+			Delta.FragmentsToRemove -= ToAdd;
+			Delta.FragmentsToAdd += ToAdd;
+			Delta.FragmentsToRemove += ToRemove;
+		}
+	}
+
+	void ChangeTags(TConstArrayView<FMassEntityHandle> Entities, const FMassTagBitSet& ToAdd, const FMassTagBitSet& ToRemove)
+	{
+		for (const FMassEntityHandle Entity : Entities)
+		{
+			FDelta& Delta = Deltas.FindOrAdd(Entity);
+			Delta.TagsToAdd -= ToRemove;
+			Delta.TagsToRemove -= ToAdd;
+			Delta.TagsToAdd += ToAdd;
+			Delta.TagsToRemove += ToRemove;
+		}
+	}
+
+	bool IsEmpty() const
+	{
+		return Deltas.IsEmpty();
+	}
+
+	int32 Num() const
+	{
+		return Deltas.Num();
+	}
+
+	void Reset()
+	{
+		Deltas.Reset();
+	}
+
+	/**
+	 * Groups the accumulated entities by (source archetype, delta). Entities that are no longer valid, and entities
+	 * whose changes cancelled out, are dropped. Groups are ordered by the first entity that was added to them.
+	 */
+	void BuildGroups(const FMassEntityManager& EntityManager, TArray<FGroup>& OutGroups) const
+	{
+		OutGroups.Reset();
+		TMap<TPair<FMassArchetypeHandle, FDelta>, int32> GroupIndices;
+		for (const TPair<FMassEntityHandle, FDelta>& Pair : Deltas)
+		{
+			if (Pair.Value.IsEmpty() || !EntityManager.IsEntityValid(Pair.Key))
+			{
+				continue;
+			}
+
+			const FMassArchetypeHandle SourceArchetype = EntityManager.GetArchetypeForEntity(Pair.Key);
+			int32& GroupIndex = GroupIndices.FindOrAdd({ SourceArchetype, Pair.Value }, INDEX_NONE);
+			if (GroupIndex == INDEX_NONE)
+			{
+				GroupIndex = OutGroups.Num();
+				FGroup& NewGroup = OutGroups.AddDefaulted_GetRef();
+				NewGroup.SourceArchetype = SourceArchetype;
+				NewGroup.Delta = Pair.Value;
+			}
+			OutGroups[GroupIndex].Entities.Add(Pair.Key);
+		}
+	}
+
+	/**
+	 * Splits Groups into waves that can be processed in parallel. No two groups within a wave share an archetype,
+	 * neither as source nor as target, so they never touch the same chunks. Groups that do share an archetype are
+	 * placed in subsequent waves, in their original order.
+	 * @param TargetArchetypes the target archetype of every group, indexed like Groups
+	 * @param OutWaves indices into Groups, one array per wave. Waves need to be processed one after another.
+	 */
+	static void BuildIndependentWaves(TConstArrayView<FGroup> Groups, TConstArrayView<FMassArchetypeHandle> TargetArchetypes, TArray<TArray<int32>>& OutWaves)
+	{
+		check(Groups.Num() == TargetArchetypes.Num());
+		OutWaves.Reset();
+		TMap<FMassArchetypeHandle, int32> LastWaveUsingArchetype;
+		for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
+		{
+			const FMassArchetypeHandle& SourceArchetype = Groups[GroupIndex].SourceArchetype;
+			const FMassArchetypeHandle& TargetArchetype = TargetArchetypes[GroupIndex];
+			const int32* SourceWave = LastWaveUsingArchetype.Find(SourceArchetype);
+			const int32* TargetWave = LastWaveUsingArchetype.Find(TargetArchetype);
+			const int32 WaveIndex = FMath::Max(SourceWave ? *SourceWave : INDEX_NONE, TargetWave ? *TargetWave : INDEX_NONE) + 1;
+
+			if (WaveIndex == OutWaves.Num())
+			{
+				OutWaves.AddDefaulted();
+			}
+			OutWaves[WaveIndex].Add(GroupIndex);
+			LastWaveUsingArchetype.Add(SourceArchetype, WaveIndex);
+			LastWaveUsingArchetype.Add(TargetArchetype, WaveIndex);
+		}
+	}
+
+private:
+	/** Insertion ordered, so groups and entities within groups keep the order the commands were issued in */
+	TMap<FMassEntityHandle, FDelta> Deltas;
+};
+
 struct MASSENTITY_API FMassBatchedCommand
 {
 	FMassBatchedCommand() = default;
@@ -90,6 +239,16 @@ struct MASSENTITY_API FMassBatchedCommand
 	virtual ~FMassBatchedCommand() { Reset(); }
 
 	virtual void Execute(FMassEntityManager& System) const = 0;
+
+	/**
+	 * Commands that only change the fragment or tag composition of existing entities can hand their changes to
+	 * OutChanges instead of being executed. When gathering is enabled on the buffer (see
+	 * FMassCommandBuffer::SetGatherCompositionChanges) Flush applies the combined changes of all such commands of a
+	 * given EMassCommandOperationType with a single archetype move per entity, before moving on to the next type.
+	 * @return whether the command's work has been gathered, in which case Execute won't be called.
+	 */
+	virtual bool GatherCompositionChanges(FMassCommandCompositionChanges& OutChanges) const { return false; }
+
 	virtual void Reset()
 	{
 		bHasWork = false;
@@ -212,6 +371,11 @@ protected:
 		UE::Mass::Utils::CreateEntityCollections(System, TargetEntities, FMassArchetypeEntityCollection::FoldDuplicates, EntityCollections);
 		System.BatchChangeFragmentCompositionForEntities(EntityCollections, FragmentsAffected, FMassFragmentBitSet());
 	}
+	virtual bool GatherCompositionChanges(FMassCommandCompositionChanges& OutChanges) const override
+	{
+		OutChanges.ChangeFragments(TargetEntities, FragmentsAffected, FMassFragmentBitSet());
+		return true;
+	}
 	FMassFragmentBitSet FragmentsAffected;
 };
 
@@ -235,6 +399,11 @@ protected:
 		UE::Mass::Utils::CreateEntityCollections(System, TargetEntities, FMassArchetypeEntityCollection::FoldDuplicates, EntityCollections);
 		System.BatchChangeFragmentCompositionForEntities(EntityCollections, FMassFragmentBitSet(), FragmentsAffected);
 	}
+	virtual bool GatherCompositionChanges(FMassCommandCompositionChanges& OutChanges) const override
+	{
+		OutChanges.ChangeFragments(TargetEntities, FMassFragmentBitSet(), FragmentsAffected);
+		return true;
+	}
 	FMassFragmentBitSet FragmentsAffected;
 };
 
@@ -267,6 +436,12 @@ protected:
 		System.BatchChangeTagsForEntities(EntityCollections, TagsToAdd, TagsToRemove);
 	}
 
+	virtual bool GatherCompositionChanges(FMassCommandCompositionChanges& OutChanges) const override
+	{
+		OutChanges.ChangeTags(TargetEntities, TagsToAdd, TagsToRemove);
+		return true;
+	}
+
 	virtual SIZE_T GetAllocatedSize() const override
 	{
 		return TagsToAdd.GetAllocatedSize() + TagsToRemove.GetAllocatedSize() + Super::GetAllocatedSize();
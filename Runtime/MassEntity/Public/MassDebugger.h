@@ -39,6 +39,23 @@ namespace UE::Mass::Debug
 		SIZE_T WastedEntityMemory = 0;
 		/** Total amount of memory needed by a single entity */
 		SIZE_T BytesPerEntity = 0;
+		/** Part of BytesPerEntity stored in cold side chunks */
+		SIZE_T ColdBytesPerEntity = 0;
+	};
+
+	/** Memory traffic of a single processor, as implied by its queries' requirements and the archetypes they match. */
+	struct FProcessorFootprint
+	{
+		/** Number of entities the processor's queries currently match. */
+		int32 EntitiesCount = 0;
+		/** Number of chunks, regular and cold, the processor's queries iterate. */
+		int32 ChunksCount = 0;
+		/** Average number of fragment bytes in regular chunks accessed per processed entity. */
+		float HotBytesPerEntity = 0.f;
+		/** Average number of fragment bytes in cold side chunks accessed per processed entity. */
+		float ColdBytesPerEntity = 0.f;
+		/** Average number of bytes per entity that share the cache lines of the accessed chunks without being accessed. */
+		float UntouchedBytesPerEntity = 0.f;
 	};
 } // namespace UE::Mass::Debug
 
@@ -158,6 +175,13 @@ struct MASSENTITY_API FMassDebugger
 	static const FMassArchetypeCompositionDescriptor& GetArchetypeComposition(const FMassArchetypeHandle& ArchetypeHandle);
 
 	static void GetArchetypeEntityStats(const FMassArchetypeHandle& ArchetypeHandle, UE::Mass::Debug::FArchetypeStats& OutStats);
+
+	static void GetProcessorFootprint(const FMassEntityManager& EntityManager, UMassProcessor& Processor, UE::Mass::Debug::FProcessorFootprint& OutFootprint);
+	/** 
+	 * Outputs the footprint of every processor in Processors, ordered by bytes touched per entity. Used by the 
+	 * mass.debug.ProcessorFootprint console command to compare chunk configurations.
+	 */
+	static void OutputProcessorFootprints(FOutputDevice& Ar, const FMassEntityManager& EntityManager, TConstArrayView<UMassProcessor*> Processors);
 	static const TConstArrayView<FName> GetArchetypeDebugNames(const FMassArchetypeHandle& ArchetypeHandle);
 
 	static TConstArrayView<UMassCompositeProcessor::FDependencyNode> GetProcessingGraph(const UMassCompositeProcessor& GraphOwner);
@@ -22,6 +22,7 @@ struct FMassEntityQuery;
 struct FMassExecutionContext;
 struct FMassArchetypeData;
 struct FMassCommandBuffer;
+struct FMassCommandCompositionChanges;
 struct FMassArchetypeEntityCollection;
 class FOutputDevice;
 struct FMassDebugger;
@@ -383,6 +384,15 @@ public:
 	void BatchChangeTagsForEntities(TConstArrayView<FMassArchetypeEntityCollection> EntityCollections, const FMassTagBitSet& TagsToAdd, const FMassTagBitSet& TagsToRemove);
 	void BatchChangeFragmentCompositionForEntities(TConstArrayView<FMassArchetypeEntityCollection> EntityCollections, const FMassFragmentBitSet& FragmentsToAdd, const FMassFragmentBitSet& FragmentsToRemove);
 	void BatchAddFragmentInstancesForEntities(TConstArrayView<FMassArchetypeEntityCollectionWithPayload> EntityCollections, const FMassFragmentBitSet& FragmentsAffected);
+	/**
+	 * Applies the net fragment and tag changes gathered from a command buffer. Entities are grouped by source archetype
+	 * and delta, and every group is moved to its target archetype at once, copying whole column slices per chunk rather
+	 * than entity by entity. Target archetypes are created up front, then groups are split with
+	 * FMassCommandCompositionChanges::BuildIndependentWaves. Groups within a wave share neither source nor target
+	 * archetypes and are processed in parallel when there's enough work to justify it; waves run one after another.
+	 * Fragments in FDelta::FragmentsToReset are default-initialized, matching a Remove followed by an Add.
+	 */
+	void BatchApplyCompositionChanges(const FMassCommandCompositionChanges& Changes);
 	/** 
 	 * Adds a new const and non-const shared fragments to all entities provided via EntityCollections 
 	 */
@@ -406,7 +416,8 @@ public:
 	void MoveEntityToAnotherArchetype(FMassEntityHandle Entity, FMassArchetypeHandle NewArchetypeHandle);
 
 	/** Copies values from FragmentInstanceList over to Entity's fragment. Caller is responsible for ensuring that 
-	 *  the given entity does have given fragments. Failing this assumption will cause a check-fail.*/
+	 *  the given entity does have given fragments. Failing this assumption will cause a check-fail.
+	 *  Like all the value setters, stamps the written fragments with a new change version. */
 	void SetEntityFragmentsValues(FMassEntityHandle Entity, TArrayView<const FInstancedStruct> FragmentInstanceList);
 
 	/** Copies values from FragmentInstanceList over to fragments of given entities collection. The caller is responsible 
@@ -522,6 +533,26 @@ public:
 
 	uint32 GetArchetypeDataVersion() const { return ArchetypeDataVersion; }
 
+	/** 
+	 * The global change version. Fragments written via FMassExecutionContext get stamped, per chunk, with the version
+	 * of the processor execution that wrote them. Writes done through the entity manager itself (chunk allocation,
+	 * entity creation and archetype moves, SetEntityFragmentsValues, BatchSetEntityFragmentsValues and the
+	 * AddFragmentInstance functions) and through FMassEntityView stamp a freshly incremented version instead.
+	 * @see FMassChunkChangeVersions, FMassEntityQuery::SetChangedSince
+	 */
+	uint32 GetChangeVersion() const { return ChangeVersion.load(std::memory_order_relaxed); }
+
+	/** Advances the global change version and returns the new value. Never returns 0, which stands for "never". */
+	uint32 IncrementChangeVersion()
+	{
+		uint32 NewVersion = ChangeVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+		if (NewVersion == 0)
+		{
+			NewVersion = ChangeVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+		return NewVersion;
+	}
+
 	/**
 	 * Creates and initializes a FMassExecutionContext instance.
 	 */
@@ -1091,6 +1122,9 @@ private:
 	// the "version" number increased every time an archetype gets added
 	uint32 ArchetypeDataVersion = 0;
 
+	// the "version" number increased every time a processor starts executing, used to stamp written chunk fragments
+	std::atomic<uint32> ChangeVersion = 1;
+
 	// Map of hash of sorted fragment list to archetypes with that hash
 	TMap<uint32, TArray<TSharedPtr<FMassArchetypeData>>> FragmentHashToArchetypeMap;
 
@@ -70,6 +70,7 @@ public:
 	{
 		FMassFragmentRequirements::Reset();
 		FMassSubsystemRequirements::Reset();
+		ClearChangeFilter();
 		DirtyCachedData();
 	}
 
@@ -127,6 +128,46 @@ public:
 
 	bool HasChunkFilter() const { return bool(ChunkCondition); }
 
+	/**
+	 * Adds FragmentType to the change filter. A query with a change filter skips chunks in which none of the filtered
+	 * fragments has been written since the version set with SetChangedSince. Writes are tracked per chunk, so a single
+	 * written entity marks its whole chunk as changed. Besides writes through FMassExecutionContext, chunk allocation,
+	 * entities moving into a chunk and all non-context writes count as changes, see FMassChunkChangeVersions.
+	 * The fragment needs to be one of the query's requirements.
+	 * Like the chunk filter, the change filter is not applied when a specific entity collection is used.
+	 */
+	void AddChangeFilter(const UScriptStruct* FragmentType)
+	{
+		checkf(FragmentType && (RequiredAllFragments.Contains(*FragmentType) || RequiredAnyFragments.Contains(*FragmentType) || RequiredOptionalFragments.Contains(*FragmentType))
+			, TEXT("Change filter fragment %s needs to be required by the query."), *GetNameSafe(FragmentType));
+		ChangeFilterFragments.Add(*FragmentType);
+	}
+
+	template<typename T>
+	void AddChangeFilter()
+	{
+		static_assert(TIsDerivedFrom<T, FMassFragment>::IsDerived, "Given struct is not of a valid fragment type.");
+		AddChangeFilter(T::StaticStruct());
+	}
+
+	void ClearChangeFilter() { ChangeFilterFragments.Reset(); }
+
+	bool HasChangeFilter() const { return !ChangeFilterFragments.IsEmpty(); }
+
+	/** 
+	 * Sets the version the change filter compares chunks against, usually UMassProcessor::GetLastRunChangeVersion.
+	 * With 0 every chunk passes, so the first execution after the query got created processes everything.
+	 */
+	void SetChangedSince(const uint32 InVersion) { ChangedSinceVersion = InVersion; }
+
+	uint32 GetChangedSince() const { return ChangedSinceVersion; }
+
+	/** @return whether ChunkVersion was stamped after Version. Wrap-around safe as long as the two are less than 2^31 apart. */
+	static bool IsVersionNewer(const uint32 ChunkVersion, const uint32 Version)
+	{
+		return Version == 0 || int32(ChunkVersion - Version) > 0;
+	}
+
 	/** 
 	 * If ArchetypeHandle is among ValidArchetypes then the function retrieves requirements mapping cached for it,
 	 * otherwise an empty mapping will be returned (and the requirements binding will be done the slow way).
@@ -159,6 +200,10 @@ private:
 	 */
 	FMassChunkConditionFunction ChunkCondition;
 
+	/** Fragments checked against ChangedSinceVersion before a chunk gets bound. @see AddChangeFilter */
+	FMassFragmentBitSet ChangeFilterFragments;
+	uint32 ChangedSinceVersion = 0;
+
 	uint32 EntitySubsystemHash = 0;
 	uint32 LastUpdatedArchetypeDataVersion = 0;
 
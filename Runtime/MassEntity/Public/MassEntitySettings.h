@@ -57,6 +57,13 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = Mass, config, AdvancedDisplay)
 	int32 ChunkMemorySize = 128 * 1024;
 
+	/** 
+	 * Rarely accessed fragment types to be stored in cold side chunks in every archetype that contains them, in addition
+	 * to types flagged via TMassFragmentTraits::ColdStorage. @see FMassArchetypeCreationParams::ColdFragments
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = Mass, config, AdvancedDisplay, meta = (MetaStruct = "/Script/MassEntity.MassFragment"))
+	TArray<TObjectPtr<UScriptStruct>> ColdFragmentTypes;
+
 	/**
 	 * The name of the file to dump the processor dependency graph. T
 	 * The dot file will be put in the project log folder.
@@ -680,6 +680,16 @@ namespace UE::Mass
 			Super::PopulateBitSet(OutBitSet);
 			OutBitSet += TBitSetType::template GetTypeBitSet<FType>();
 		}
+
+		/** Adds the types flagged with TMassFragmentTraits::ColdStorage */
+		static void PopulateColdFragmentBitSet(FMassFragmentBitSet& OutBitSet)
+		{
+			Super::PopulateColdFragmentBitSet(OutBitSet);
+			if constexpr (TMassFragmentTraits<FType>::ColdStorage)
+			{
+				OutBitSet += FMassFragmentBitSet::GetTypeBitSet<FType>();
+			}
+		}
 	};
 		
 	/** Single-type specialization of TMultiTypeList. */
@@ -697,6 +707,14 @@ namespace UE::Mass
 		{
 			OutBitSet += TBitSetType::template GetTypeBitSet<FType>();
 		}
+
+		static void PopulateColdFragmentBitSet(FMassFragmentBitSet& OutBitSet)
+		{
+			if constexpr (TMassFragmentTraits<FType>::ColdStorage)
+			{
+				OutBitSet += FMassFragmentBitSet::GetTypeBitSet<FType>();
+			}
+		}
 	};
 
 	/** 
@@ -794,6 +812,13 @@ struct FMassArchetypeCreationParams
 	/** Created archetype will have chunks of this size. 0 denotes "use default" (see UE::Mass::ChunkSize) */
 	int32 ChunkMemorySize = 0;
 
+	/** 
+	 * Fragments to be stored in the archetype's cold side chunks rather than in the regular chunks. Side chunks are
+	 * sized to hold the same number of entities as the regular ones. Combined with UMassEntitySettings::ColdFragmentTypes.
+	 * Use UE::Mass::TMultiTypeList<...>::PopulateColdFragmentBitSet to fill it from TMassFragmentTraits.
+	 */
+	FMassFragmentBitSet ColdFragments;
+
 	/** Name to identify the archetype while debugging*/
 	FName DebugName;
 };
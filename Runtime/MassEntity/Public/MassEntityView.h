@@ -44,7 +44,11 @@ struct MASSENTITY_API FMassEntityView
 
 	FMassEntityHandle GetEntity() const	{ return Entity; }
 
-	/** will fail a check if the viewed entity doesn't have the given fragment */	
+	/** 
+	 * will fail a check if the viewed entity doesn't have the given fragment.
+	 * Note that the fragment accessors hand out mutable data, so they mark the fragment as changed in the entity's
+	 * chunk (see FMassChunkChangeVersions). Use GetConstFragmentData for read-only access.
+	 */
 	template<typename T>
 	T& GetFragmentData() const
 	{
@@ -74,6 +78,30 @@ struct MASSENTITY_API FMassEntityView
 		return FStructView(FragmentType, static_cast<uint8*>(GetFragmentPtr(*FragmentType)));
 	}
 
+	/** Read-only counterpart of GetFragmentData, doesn't mark the fragment as changed */
+	template<typename T>
+	const T& GetConstFragmentData() const
+	{
+		static_assert(!std::is_base_of_v<FMassTag, T>,
+			"Given struct doesn't represent a valid fragment type but a tag. Use HasTag instead.");
+		static_assert(std::is_base_of_v<FMassTag, T> || std::is_base_of_v<FMassFragment, T>,
+			"Given struct doesn't represent a valid fragment type. Make sure to inherit from FMassFragment or one of its child-types.");
+
+		return *((const T*)GetConstFragmentPtrChecked(*T::StaticStruct()));
+	}
+
+	/** Read-only counterpart of GetFragmentDataPtr, doesn't mark the fragment as changed */
+	template<typename T>
+	const T* GetConstFragmentDataPtr() const
+	{
+		static_assert(!std::is_base_of_v<FMassTag, T>,
+			"Given struct doesn't represent a valid fragment type but a tag. Use HasTag instead.");
+		static_assert(std::is_base_of_v<FMassTag, T> || std::is_base_of_v<FMassFragment, T>,
+			"Given struct doesn't represent a valid fragment type. Make sure to inherit from FMassFragment or one of its child-types.");
+
+		return (const T*)GetConstFragmentPtr(*T::StaticStruct());
+	}
+
 	/** if the viewed entity doesn't have the given const shared fragment the function will return null */
 	template<typename T>
 	const T* GetConstSharedFragmentDataPtr() const
@@ -152,6 +180,8 @@ struct MASSENTITY_API FMassEntityView
 protected:
 	void* GetFragmentPtr(const UScriptStruct& FragmentType) const;
 	void* GetFragmentPtrChecked(const UScriptStruct& FragmentType) const;
+	const void* GetConstFragmentPtr(const UScriptStruct& FragmentType) const;
+	const void* GetConstFragmentPtrChecked(const UScriptStruct& FragmentType) const;
 	const void* GetConstSharedFragmentPtr(const UScriptStruct& FragmentType) const;
 	const void* GetConstSharedFragmentPtrChecked(const UScriptStruct& FragmentType) const;
 	void* GetSharedFragmentPtr(const UScriptStruct& FragmentType) const;
@@ -27,6 +27,8 @@ private:
 	{
 		FMassFragmentRequirementDescription Requirement;
 		ViewType FragmentView;
+		/** Points at the current chunk's change version of the fragment. Stamped on mutable access. */
+		uint32* ChangeVersion = nullptr;
 
 		TFragmentView() {}
 		explicit TFragmentView(const FMassFragmentRequirementDescription& InRequirement) : Requirement(InRequirement) {}
@@ -59,6 +61,8 @@ private:
 	FInstancedStruct AuxData;
 	float DeltaTimeSeconds = 0.0f;
 	int32 ChunkSerialModificationNumber = -1;
+	/** Change version of the ongoing processor execution, stamped onto fragments accessed for writing */
+	uint32 CurrentChangeVersion = 0;
 	FMassArchetypeCompositionDescriptor CurrentArchetypeCompositionDescriptor;
 
 	TSharedRef<FMassEntityManager> EntityManager;
@@ -157,6 +161,24 @@ public:
 	void SetCurrentChunkSerialModificationNumber(const int32 SerialModificationNumber) { ChunkSerialModificationNumber = SerialModificationNumber; }
 	int32 GetChunkSerialModificationNumber() const { return ChunkSerialModificationNumber; }
 
+	/** Change version related operations */
+	void SetCurrentChangeVersion(const uint32 ChangeVersion) { CurrentChangeVersion = ChangeVersion; }
+	uint32 GetCurrentChangeVersion() const { return CurrentChangeVersion; }
+
+	/** @return the version at which FragmentType was last written in the current chunk, 0 if not bound or never written */
+	uint32 GetChunkChangeVersion(const UScriptStruct* FragmentType) const
+	{
+		const FFragmentView* View = FragmentViews.FindByPredicate([FragmentType](const FFragmentView& Element) { return Element.Requirement.StructType == FragmentType; });
+		return View && View->ChangeVersion ? *View->ChangeVersion : 0;
+	}
+
+	template<typename T>
+	uint32 GetChunkChangeVersion() const
+	{
+		static_assert(TIsDerivedFrom<T, FMassFragment>::IsDerived, "Given struct is not of a valid fragment type.");
+		return GetChunkChangeVersion(T::StaticStruct());
+	}
+
 	template<typename T>
 	T* GetMutableChunkFragmentPtr()
 	{
@@ -165,6 +187,10 @@ public:
 		const UScriptStruct* Type = T::StaticStruct();
 		FChunkFragmentView* FoundChunkFragmentData = ChunkFragmentViews.FindByPredicate([Type](const FChunkFragmentView& Element) { return Element.Requirement.StructType == Type; } );
 		CHECK_IF_READWRITE(FoundChunkFragmentData);
+		if (FoundChunkFragmentData)
+		{
+			MarkChanged(*FoundChunkFragmentData);
+		}
 		return FoundChunkFragmentData ? FoundChunkFragmentData->FragmentView.GetPtr<T>() : static_cast<T*>(nullptr);
 	}
 	
@@ -261,6 +287,7 @@ public:
 		const FFragmentView* View = FragmentViews.FindByPredicate([FragmentType](const FFragmentView& Element) { return Element.Requirement.StructType == FragmentType; });
 		CHECK_IF_VALID(View, FragmentType);
 		CHECK_IF_READWRITE(View);
+		MarkChanged(*View);
 		return MakeArrayView<TFragment>((TFragment*)View->FragmentView.GetData(), View->FragmentView.Num());
 	}
 
@@ -285,6 +312,7 @@ public:
 		const FFragmentView* View = FragmentViews.FindByPredicate([FragmentType](const FFragmentView& Element) { return Element.Requirement.StructType == FragmentType; });
 		CHECK_IF_VALID(View, FragmentType);
 		CHECK_IF_READWRITE(View);
+		MarkChanged(*View);
 		return View->FragmentView;
 	}
 
@@ -376,15 +404,26 @@ protected:
 
 	void SetFragmentRequirements(const FMassFragmentRequirements& FragmentRequirements);
 
+	template<typename ViewType>
+	void MarkChanged(const TFragmentView<ViewType>& View) const
+	{
+		if (View.ChangeVersion && CurrentChangeVersion)
+		{
+			*View.ChangeVersion = CurrentChangeVersion;
+		}
+	}
+
 	void ClearFragmentViews()
 	{
 		for (FFragmentView& View : FragmentViews)
 		{
 			View.FragmentView = TArrayView<FMassFragment>();
+			View.ChangeVersion = nullptr;
 		}
 		for (FChunkFragmentView& View : ChunkFragmentViews)
 		{
 			View.FragmentView.Reset();
+			View.ChangeVersion = nullptr;
 		}
 		for (FConstSharedFragmentView& View : ConstSharedFragmentViews)
 		{
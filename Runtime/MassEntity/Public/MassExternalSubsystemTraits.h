@@ -70,3 +70,19 @@ struct TMassSharedFragmentTraits final
 		GameThreadOnly = false,
 	};
 };
+
+/** 
+ * Fragments' traits.
+ * ColdStorage - opt-in for rarely accessed fragments. Cold fragments are stored in a side chunk that parallels the 
+ *	regular chunk and is addressed by the same entity index, so that processors iterating hot fragments don't pull cold 
+ *	data into the cache. Accessing a cold fragment costs an extra chunk lookup.
+ * @see FMassArchetypeCreationParams::ColdFragments
+ */
+template <typename T>
+struct TMassFragmentTraits final
+{
+	enum
+	{
+		ColdStorage = false,
+	};
+};
@@ -7,6 +7,7 @@
 #include "MassProcessingTypes.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "MassCommandBuffer.h"
+#include "MassProcessorScheduler.h"
 #include "MassProcessor.generated.h"
 
 
@@ -56,8 +57,18 @@ public:
 
 	/** Whether this processor should execute according the CurrentExecutionFlags parameters */
 	bool ShouldExecute(const EProcessorExecutionFlags CurrentExecutionFlags) const;
+	/** 
+	 * Advances the entity manager's change version, sets it as the context's current change version and calls Execute.
+	 * Once done the version is stored as LastRunChangeVersion.
+	 */
 	void CallExecute(FMassEntityManager& EntityManager, FMassExecutionContext& Context);
 
+	/** 
+	 * The change version of the last completed execution, 0 if the processor has not been executed yet. Pass it to 
+	 * FMassEntityQuery::SetChangedSince to only process chunks written since this processor last ran.
+	 */
+	uint32 GetLastRunChangeVersion() const { return LastRunChangeVersion; }
+
 	/** 
 	 * Controls whether there can be multiple instances of a given class in a single FMassRuntimePipeline and during 
 	 * dependency solving. 
@@ -180,6 +191,9 @@ private:
 	 *  @note that it's safe to store pointers here since RegisterQuery does verify that a given registered query is 
 	 *  a member variable of a given processor */
 	TArray<FMassEntityQuery*> OwnedQueries;
+
+	/** @see GetLastRunChangeVersion */
+	uint32 LastRunChangeVersion = 0;
 };
 
 
@@ -219,6 +233,15 @@ public:
 	 */
 	virtual void BuildFlatProcessingGraph(TConstArrayView<FMassProcessorOrderInfo> SortedProcessors);
 
+	/**
+	 * Rebuilds FrameSchedule from FlatProcessingGraph using the archetypes hosted processors match right now. Called
+	 * by DispatchProcessorTasks when the entity manager's archetype data version changed since the last build.
+	 * @see FMassProcessorScheduler
+	 */
+	void BuildFrameSchedule(const FMassEntityManager& EntityManager);
+
+	const FMassProcessorSchedule& GetFrameSchedule() const { return FrameSchedule; }
+
 	/**
 	 * Adds processors in InOutOrderedProcessors to ChildPipeline. 
 	 * Note that this operation is non-destructive for the existing processors - the ones of classes found in InOutOrderedProcessors 
@@ -261,6 +284,12 @@ protected:
 
 	TArray<FDependencyNode> FlatProcessingGraph;
 
+	/** Per-frame view of FlatProcessingGraph, with dependencies limited to actual archetype and fragment conflicts */
+	TArray<FMassProcessorScheduleNode> ScheduleNodes;
+	FMassProcessorSchedule FrameSchedule;
+	/** Archetype data version FrameSchedule was built for */
+	uint32 FrameScheduleArchetypeDataVersion = 0;
+
 	struct FProcessorCompletion
 	{
 		FGraphEventRef CompletionEvent;
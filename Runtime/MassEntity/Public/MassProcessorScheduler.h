@@ -0,0 +1,195 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "MassProcessorDependencySolver.h"
+#include "MassArchetypeTypes.h"
+#include "Containers/Set.h"
+#include "Misc/OutputDevice.h"
+
+
+class UMassProcessor;
+struct FMassEntityManager;
+
+/** Everything the scheduler needs to know about a single processor for the current frame. */
+struct FMassProcessorScheduleNode
+{
+	UMassProcessor* Processor = nullptr;
+	FName Name;
+	/** Read/write sets exported by the processor's queries and processor requirements. */
+	FMassExecutionRequirements Requirements;
+	/** Archetypes the processor's queries match this frame. */
+	TArray<FMassArchetypeHandle> Archetypes;
+	/** Indices of earlier nodes this node has to wait for regardless of data access, i.e. ExecuteBefore/ExecuteAfter. */
+	TArray<int32> ExplicitDependencies;
+};
+
+/** Per-frame task graph produced by FMassProcessorScheduler::BuildSchedule. Tasks are in the same order as the nodes. */
+struct FMassProcessorSchedule
+{
+	struct FTask
+	{
+		TArray<int32> Dependencies;
+		/** Length of the longest dependency chain leading to this task. Tasks sharing a wave can run concurrently. */
+		int32 Wave = 0;
+	};
+
+	TArray<FTask> Tasks;
+	int32 NumWaves = 0;
+	int32 MaxWaveWidth = 0;
+	int32 NumDependencies = 0;
+
+	void Reset()
+	{
+		Tasks.Reset();
+		NumWaves = 0;
+		MaxWaveWidth = 0;
+		NumDependencies = 0;
+	}
+
+	/** Average number of tasks that could run at the same time if all tasks took equally long. */
+	float GetAverageParallelism() const
+	{
+		return NumWaves > 0 ? float(Tasks.Num()) / float(NumWaves) : 0.f;
+	}
+};
+
+/**
+ * Builds a per-frame task graph for a set of processors that were already ordered by FMassProcessorDependencySolver.
+ *
+ * The dependency solver runs once, against the archetypes that existed at the time, and has to assume the worst for
+ * archetypes created later. The scheduler instead looks at the archetypes each processor's queries match this frame.
+ * Two processors only need to be ordered if they were explicitly ordered, if they touch the same archetype with
+ * conflicting fragment or chunk fragment access (at least one writes), or if their archetype independent access conflicts.
+ * Shared fragment instances and external subsystems are referenced from many archetypes, so conflicting access to them
+ * orders the processors no matter which archetypes they match. Processors that only read a fragment, or touch disjoint
+ * archetypes, end up in the same wave and run concurrently.
+ */
+struct FMassProcessorScheduler
+{
+	/**
+	 * @return whether A and B access data stored per archetype (fragments and chunk fragments) in a way that requires
+	 * ordering (write-read, read-write or write-write). Only matters if the processors share an archetype.
+	 */
+	static bool DoArchetypeAccessesConflict(const FMassExecutionRequirements& A, const FMassExecutionRequirements& B)
+	{
+		return DoAccessesConflict(A.Fragments, B.Fragments)
+			|| DoAccessesConflict(A.ChunkFragments, B.ChunkFragments);
+	}
+
+	/**
+	 * @return whether A and B access data that is not owned by a single archetype in a way that requires ordering:
+	 * external subsystems and shared fragments, whose instances are referenced by entities in many archetypes.
+	 * Const shared fragments are read only, so they never conflict.
+	 */
+	static bool DoArchetypeIndependentAccessesConflict(const FMassExecutionRequirements& A, const FMassExecutionRequirements& B)
+	{
+		return DoAccessesConflict(A.RequiredSubsystems, B.RequiredSubsystems)
+			|| DoAccessesConflict(A.SharedFragments, B.SharedFragments);
+	}
+
+	static bool DoArchetypesOverlap(const TSet<FMassArchetypeHandle>& A, const TSet<FMassArchetypeHandle>& B)
+	{
+		const TSet<FMassArchetypeHandle>& Smaller = A.Num() <= B.Num() ? A : B;
+		const TSet<FMassArchetypeHandle>& Larger = A.Num() <= B.Num() ? B : A;
+		for (const FMassArchetypeHandle& Archetype : Smaller)
+		{
+			if (Larger.Contains(Archetype))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Builds OutSchedule from Nodes, which are expected in the order produced by the dependency solver. */
+	static void BuildSchedule(TConstArrayView<FMassProcessorScheduleNode> Nodes, FMassProcessorSchedule& OutSchedule)
+	{
+		OutSchedule.Reset();
+		OutSchedule.Tasks.SetNum(Nodes.Num());
+
+		TArray<TSet<FMassArchetypeHandle>> ArchetypeSets;
+		ArchetypeSets.SetNum(Nodes.Num());
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+		{
+			ArchetypeSets[NodeIndex].Append(Nodes[NodeIndex].Archetypes);
+		}
+
+		TArray<int32> WaveWidths;
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+		{
+			const FMassProcessorScheduleNode& Node = Nodes[NodeIndex];
+			FMassProcessorSchedule::FTask& Task = OutSchedule.Tasks[NodeIndex];
+
+			for (int32 EarlierIndex = 0; EarlierIndex < NodeIndex; ++EarlierIndex)
+			{
+				const FMassProcessorScheduleNode& EarlierNode = Nodes[EarlierIndex];
+				const bool bMustWait = Node.ExplicitDependencies.Contains(EarlierIndex)
+					|| DoArchetypeIndependentAccessesConflict(Node.Requirements, EarlierNode.Requirements)
+					|| (DoArchetypeAccessesConflict(Node.Requirements, EarlierNode.Requirements) && DoArchetypesOverlap(ArchetypeSets[NodeIndex], ArchetypeSets[EarlierIndex]));
+
+				if (bMustWait)
+				{
+					Task.Dependencies.Add(EarlierIndex);
+					Task.Wave = FMath::Max(Task.Wave, OutSchedule.Tasks[EarlierIndex].Wave + 1);
+				}
+			}
+
+			OutSchedule.NumDependencies += Task.Dependencies.Num();
+			if (WaveWidths.Num() <= Task.Wave)
+			{
+				WaveWidths.SetNumZeroed(Task.Wave + 1);
+			}
+			++WaveWidths[Task.Wave];
+		}
+
+		OutSchedule.NumWaves = WaveWidths.Num();
+		for (const int32 Width : WaveWidths)
+		{
+			OutSchedule.MaxWaveWidth = FMath::Max(OutSchedule.MaxWaveWidth, Width);
+		}
+	}
+
+	/**
+	 * Fills OutNodes from a composite processor's flat processing graph, fetching requirements and currently matching
+	 * archetypes from each processor and translating ExecuteBefore/ExecuteAfter into explicit dependencies.
+	 */
+	MASSENTITY_API static void GatherNodes(TConstArrayView<UMassProcessor*> OrderedProcessors, const FMassEntityManager& EntityManager, TArray<FMassProcessorScheduleNode>& OutNodes);
+
+	/** Writes the waves of Schedule and a summary of the achieved parallelism to Ar. */
+	static void DumpSchedule(TConstArrayView<FMassProcessorScheduleNode> Nodes, const FMassProcessorSchedule& Schedule, FOutputDevice& Ar)
+	{
+		check(Nodes.Num() == Schedule.Tasks.Num());
+		Ar.Logf(TEXT("Mass schedule: %d processors, %d dependencies, %d waves, max width %d, average parallelism %.2f")
+			, Schedule.Tasks.Num(), Schedule.NumDependencies, Schedule.NumWaves, Schedule.MaxWaveWidth, Schedule.GetAverageParallelism());
+
+		for (int32 Wave = 0; Wave < Schedule.NumWaves; ++Wave)
+		{
+			Ar.Logf(TEXT("  Wave %d:"), Wave);
+			for (int32 TaskIndex = 0; TaskIndex < Schedule.Tasks.Num(); ++TaskIndex)
+			{
+				const FMassProcessorSchedule::FTask& Task = Schedule.Tasks[TaskIndex];
+				if (Task.Wave != Wave)
+				{
+					continue;
+				}
+
+				FString DependencyNames;
+				for (const int32 DependencyIndex : Task.Dependencies)
+				{
+					DependencyNames += DependencyNames.IsEmpty() ? TEXT("") : TEXT(", ");
+					DependencyNames += Nodes[DependencyIndex].Name.ToString();
+				}
+				Ar.Logf(TEXT("    %s (%d archetypes)%s%s"), *Nodes[TaskIndex].Name.ToString(), Nodes[TaskIndex].Archetypes.Num()
+					, DependencyNames.IsEmpty() ? TEXT("") : TEXT(" after "), *DependencyNames);
+			}
+		}
+	}
+
+private:
+	template<typename TBitSet>
+	static bool DoAccessesConflict(const TMassExecutionAccess<TBitSet>& A, const TMassExecutionAccess<TBitSet>& B)
+	{
+		return A.Write.HasAny(B.Read) || A.Write.HasAny(B.Write) || B.Write.HasAny(A.Read);
+	}
+};
@@ -0,0 +1,524 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Algo/Sort.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "Containers/UnrealString.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "UObject/NameTypes.h"
+#include <atomic>
+
+#if !defined(UE_NET_OBJECT_COST_PROFILER_ENABLED)
+#	if !(UE_BUILD_SHIPPING)
+#		define UE_NET_OBJECT_COST_PROFILER_ENABLED 1
+#	else
+#		define UE_NET_OBJECT_COST_PROFILER_ENABLED 0
+#	endif
+#endif
+
+#if UE_NET_OBJECT_COST_PROFILER_ENABLED
+
+namespace UE::Net
+{
+
+/** The parts of the replication cost of an object that are attributed separately. */
+enum class ENetObjectCostPhase : uint8
+{
+	/** Comparing the object against its shadow state, or polling it for dirty state. */
+	Compare,
+	/** Copying and quantizing dirty state into the internal representation. */
+	Quantize,
+	/** Writing the object to a packet for a connection. */
+	Serialize,
+	/** Relevancy, dormancy and filtering of the object for a connection. */
+	Filter,
+
+	Count
+};
+
+inline const TCHAR* LexToString(ENetObjectCostPhase Phase)
+{
+	switch (Phase)
+	{
+		case ENetObjectCostPhase::Compare: return TEXT("Compare");
+		case ENetObjectCostPhase::Quantize: return TEXT("Quantize");
+		case ENetObjectCostPhase::Serialize: return TEXT("Serialize");
+		case ENetObjectCostPhase::Filter: return TEXT("Filter");
+		default: return TEXT("Unknown");
+	}
+}
+
+/** Estimated cost of a class or an object. Values are scaled by the sample interval they were recorded with. */
+struct FNetObjectCost
+{
+	static constexpr int32 PhaseCount = static_cast<int32>(ENetObjectCostPhase::Count);
+
+	uint64 Cycles[PhaseCount] = {};
+	uint64 Bits = 0;
+	uint32 SampleCount = 0;
+
+	uint64 GetTotalCycles() const
+	{
+		uint64 Total = 0;
+		for (const uint64 PhaseCycles : Cycles)
+		{
+			Total += PhaseCycles;
+		}
+		return Total;
+	}
+
+	void Accumulate(const FNetObjectCost& Other)
+	{
+		for (int32 PhaseIt = 0; PhaseIt < PhaseCount; ++PhaseIt)
+		{
+			Cycles[PhaseIt] += Other.Cycles[PhaseIt];
+		}
+		Bits += Other.Bits;
+		SampleCount += Other.SampleCount;
+	}
+};
+
+/** Cost of one class, as reported by FNetObjectCostProfiler. */
+struct FNetObjectClassCostReport
+{
+	FName ClassName;
+	FNetObjectCost Cost;
+
+	/** Number of distinct objects of the class that were sampled since the last Reset(), including untracked ones. */
+	uint32 ObjectCount = 0;
+};
+
+/** Cost of one object, as reported by FNetObjectCostProfiler. */
+struct FNetObjectCostReport
+{
+	FName ClassName;
+	uint64 ObjectId = 0;
+	FNetObjectCost Cost;
+};
+
+/**
+ * Attributes the CPU time spent comparing, quantizing, serializing and filtering replicated objects, and the bits they
+ * write, to their class and to the object itself. Works for both Iris (ObjectId is the NetRefHandle id) and the generic
+ * replication path (ObjectId is the NetGUID value).
+ *
+ * On average one in SampleInterval scopes is timed, so the cost of a scope that isn't sampled is an atomic decrement.
+ * The gap to the next sampled scope is randomized around the interval, so work that repeats with a fixed period (e.g. the
+ * same objects being visited in the same order every frame) isn't always sampled at the same point. Sampled costs are
+ * scaled by the interval, so totals are unbiased estimates that converge over many frames.
+ *
+ * Once per frame EndFrame() publishes the frame's per class cost as Trace counters and, while a CSV capture is running,
+ * as CSV stats for the most expensive classes. Sampled scopes also emit a CPU profiler event named after the class,
+ * so the cost shows up in the Insights timing view. Totals over the whole capture are kept and can be written out as
+ * CSV with WriteClassSummaryCsv() and WriteObjectSummaryCsv().
+ *
+ * The profiler is owned by whatever drives replication, typically the net driver, and can be used from several threads.
+ */
+class FNetObjectCostProfiler
+{
+public:
+	/** Number of classes reported as CSV stats each frame. */
+	static constexpr int32 MaxCsvClassesPerFrame = 16;
+
+	/** Objects tracked individually over a capture. Further objects are only attributed to their class. */
+	static constexpr int32 MaxTrackedObjects = 8192;
+
+	/** Times one in SampleInterval scopes on average. 0 disables the profiler. */
+	void SetSampleInterval(uint32 InSampleInterval)
+	{
+		SampleInterval.store(InSampleInterval, std::memory_order_relaxed);
+
+		// Don't wait out a gap drawn for the previous interval
+		ScopesUntilSample.store(0, std::memory_order_relaxed);
+	}
+
+	uint32 GetSampleInterval() const
+	{
+		return SampleInterval.load(std::memory_order_relaxed);
+	}
+
+	bool IsEnabled() const
+	{
+		return GetSampleInterval() != 0U;
+	}
+
+	/** Returns whether the calling thread should time its next scope. */
+	bool ShouldSample()
+	{
+		const uint32 Interval = GetSampleInterval();
+		if (Interval == 0U)
+		{
+			return false;
+		}
+
+		const int32 RemainingScopes = ScopesUntilSample.fetch_sub(1, std::memory_order_relaxed) - 1;
+		if (RemainingScopes > 0)
+		{
+			return false;
+		}
+
+		// Only the thread that starts the next gap takes the sample. If another thread counted in between, the exchange fails
+		// and the next scope on any thread tries again.
+		int32 Expected = RemainingScopes;
+		return ScopesUntilSample.compare_exchange_strong(Expected, GetNextSampleGap(Interval), std::memory_order_relaxed);
+	}
+
+	/** Records a sampled scope. Cycles and Bits are scaled by the current sample interval. */
+	void AddSample(FName ClassName, uint64 ObjectId, ENetObjectCostPhase Phase, uint64 Cycles, uint32 Bits)
+	{
+		const uint64 Scale = FMath::Max(GetSampleInterval(), 1U);
+		FNetObjectCost Sample;
+		Sample.Cycles[static_cast<int32>(Phase)] = Cycles * Scale;
+		Sample.Bits = uint64(Bits) * Scale;
+		Sample.SampleCount = 1U;
+
+		FScopeLock ScopeLock(&Lock);
+
+		FClassEntry* ClassPtr = Classes.Find(ClassName);
+		FClassEntry& Class = (ClassPtr != nullptr) ? *ClassPtr : Classes.Add(ClassName, FClassEntry(ClassName));
+		Class.FrameCost.Accumulate(Sample);
+		Class.TotalCost.Accumulate(Sample);
+
+		// Counted separately from Objects, so that classes keep an exact count once the tracking limit is reached
+		Class.SampledObjectIds.Add(ObjectId);
+
+		FObjectEntry* Object = Objects.Find(ObjectId);
+		if (Object == nullptr && Objects.Num() < MaxTrackedObjects)
+		{
+			Object = &Objects.Add(ObjectId, FObjectEntry{ClassName});
+		}
+		if (Object != nullptr)
+		{
+			Object->TotalCost.Accumulate(Sample);
+		}
+	}
+
+	/**
+	 * Publishes the cost of the frame to Trace and CSV and starts a new frame. Call once per frame from the game thread,
+	 * after all replication work of the frame has finished.
+	 */
+	void EndFrame()
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		FrameClasses.Reset();
+		for (TPair<FName, FClassEntry>& Pair : Classes)
+		{
+			FClassEntry& Class = Pair.Value;
+#if COUNTERSTRACE_ENABLED
+			TraceClassCounters(Pair.Key, Class);
+#endif
+			if (Class.FrameCost.SampleCount > 0U)
+			{
+				FrameClasses.Add(FNetObjectClassCostReport{Pair.Key, Class.FrameCost, static_cast<uint32>(Class.SampledObjectIds.Num())});
+			}
+			Class.FrameCost = FNetObjectCost();
+		}
+
+#if CSV_PROFILER
+		if (FrameClasses.Num() > 0 && FCsvProfiler::Get()->IsCapturing())
+		{
+			Algo::Sort(FrameClasses, [](const FNetObjectClassCostReport& A, const FNetObjectClassCostReport& B) { return A.Cost.GetTotalCycles() > B.Cost.GetTotalCycles(); });
+
+			const int32 CategoryIndex = GetCsvCategoryIndex();
+			for (int32 ClassIt = 0, ClassEndIt = FMath::Min(FrameClasses.Num(), MaxCsvClassesPerFrame); ClassIt < ClassEndIt; ++ClassIt)
+			{
+				const FNetObjectClassCostReport& Report = FrameClasses[ClassIt];
+				const FClassEntry& Class = Classes.FindChecked(Report.ClassName);
+				FCsvProfiler::RecordCustomStat(Class.CsvMsStatName, CategoryIndex, CyclesToMs(Report.Cost.GetTotalCycles()), ECsvCustomStatOp::Set);
+				FCsvProfiler::RecordCustomStat(Class.CsvBytesStatName, CategoryIndex, static_cast<int32>(Report.Cost.Bits / 8U), ECsvCustomStatOp::Set);
+			}
+		}
+#endif
+	}
+
+	/** Returns the cost of each class that was sampled during the last frame passed to EndFrame(). */
+	TArray<FNetObjectClassCostReport> GetLastFrameClassCosts() const
+	{
+		FScopeLock ScopeLock(&Lock);
+		return FrameClasses;
+	}
+
+	/** Returns the cost of each class since the last Reset(), most expensive first. */
+	TArray<FNetObjectClassCostReport> GetClassCosts() const
+	{
+		TArray<FNetObjectClassCostReport> Reports;
+		{
+			FScopeLock ScopeLock(&Lock);
+			Reports.Reserve(Classes.Num());
+			for (const TPair<FName, FClassEntry>& Pair : Classes)
+			{
+				Reports.Add(FNetObjectClassCostReport{Pair.Key, Pair.Value.TotalCost, static_cast<uint32>(Pair.Value.SampledObjectIds.Num())});
+			}
+		}
+
+		Algo::Sort(Reports, [](const FNetObjectClassCostReport& A, const FNetObjectClassCostReport& B) { return A.Cost.GetTotalCycles() > B.Cost.GetTotalCycles(); });
+		return Reports;
+	}
+
+	/** Returns the cost of the MaxCount most expensive tracked objects since the last Reset(), most expensive first. */
+	TArray<FNetObjectCostReport> GetObjectCosts(int32 MaxCount) const
+	{
+		TArray<FNetObjectCostReport> Reports;
+		{
+			FScopeLock ScopeLock(&Lock);
+			Reports.Reserve(Objects.Num());
+			for (const TPair<uint64, FObjectEntry>& Pair : Objects)
+			{
+				Reports.Add(FNetObjectCostReport{Pair.Value.ClassName, Pair.Key, Pair.Value.TotalCost});
+			}
+		}
+
+		Algo::Sort(Reports, [](const FNetObjectCostReport& A, const FNetObjectCostReport& B) { return A.Cost.GetTotalCycles() > B.Cost.GetTotalCycles(); });
+		if (Reports.Num() > MaxCount)
+		{
+			Reports.SetNum(FMath::Max(MaxCount, 0));
+		}
+		return Reports;
+	}
+
+	/** Appends the per class totals since the last Reset() as CSV, one row per class, most expensive first. */
+	void WriteClassSummaryCsv(FString& Out) const
+	{
+		Out += TEXT("Class,Objects,Samples,TotalMs");
+		AppendPhaseColumnNames(Out);
+		Out += TEXT(",Bytes\n");
+
+		for (const FNetObjectClassCostReport& Report : GetClassCosts())
+		{
+			Out += FString::Printf(TEXT("%s,%u,%u,%.3f"), *Report.ClassName.ToString(), Report.ObjectCount, Report.Cost.SampleCount, CyclesToMs(Report.Cost.GetTotalCycles()));
+			AppendPhaseColumns(Out, Report.Cost);
+			Out += FString::Printf(TEXT(",%llu\n"), Report.Cost.Bits / 8U);
+		}
+	}
+
+	/** Appends the totals of the MaxCount most expensive objects since the last Reset() as CSV, one row per object. */
+	void WriteObjectSummaryCsv(FString& Out, int32 MaxCount) const
+	{
+		Out += TEXT("ObjectId,Class,Samples,TotalMs");
+		AppendPhaseColumnNames(Out);
+		Out += TEXT(",Bytes\n");
+
+		for (const FNetObjectCostReport& Report : GetObjectCosts(MaxCount))
+		{
+			Out += FString::Printf(TEXT("%llu,%s,%u,%.3f"), Report.ObjectId, *Report.ClassName.ToString(), Report.Cost.SampleCount, CyclesToMs(Report.Cost.GetTotalCycles()));
+			AppendPhaseColumns(Out, Report.Cost);
+			Out += FString::Printf(TEXT(",%llu\n"), Report.Cost.Bits / 8U);
+		}
+	}
+
+	/** Forgets all costs, e.g. when a new capture starts. Trace counters that were already created are kept. */
+	void Reset()
+	{
+		FScopeLock ScopeLock(&Lock);
+		for (TPair<FName, FClassEntry>& Pair : Classes)
+		{
+			Pair.Value.FrameCost = FNetObjectCost();
+			Pair.Value.TotalCost = FNetObjectCost();
+			Pair.Value.SampledObjectIds.Reset();
+		}
+		Objects.Reset();
+		FrameClasses.Reset();
+	}
+
+	/**
+	 * Times a replication phase of an object if the profiler decides to sample it.
+	 * The bits written during the scope can be attributed with SetBits().
+	 */
+	class FScope
+	{
+	public:
+		FScope(FNetObjectCostProfiler* InProfiler, FName InClassName, uint64 InObjectId, ENetObjectCostPhase InPhase)
+			: Profiler((InProfiler != nullptr && InProfiler->ShouldSample()) ? InProfiler : nullptr)
+		{
+			if (Profiler == nullptr)
+			{
+				return;
+			}
+
+			ClassName = InClassName;
+			ObjectId = InObjectId;
+			Phase = InPhase;
+#if CPUPROFILERTRACE_ENABLED
+			bTraceEvent = UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel);
+			if (bTraceEvent)
+			{
+				FCpuProfilerTrace::OutputBeginDynamicEvent(ClassName);
+			}
+#endif
+			StartCycles = FPlatformTime::Cycles64();
+		}
+
+		~FScope()
+		{
+			if (Profiler == nullptr)
+			{
+				return;
+			}
+
+			const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+#if CPUPROFILERTRACE_ENABLED
+			if (bTraceEvent)
+			{
+				FCpuProfilerTrace::OutputEndEvent();
+			}
+#endif
+			Profiler->AddSample(ClassName, ObjectId, Phase, Cycles, Bits);
+		}
+
+		/** Whether this scope is sampled. Lets the caller skip work that is only needed for the profiler. */
+		bool IsSampled() const { return Profiler != nullptr; }
+
+		void SetBits(uint32 InBits) { Bits = InBits; }
+
+	private:
+		FNetObjectCostProfiler* Profiler;
+		FName ClassName;
+		uint64 ObjectId = 0;
+		uint64 StartCycles = 0;
+		uint32 Bits = 0;
+		ENetObjectCostPhase Phase = ENetObjectCostPhase::Compare;
+		bool bTraceEvent = false;
+	};
+
+private:
+	struct FClassEntry
+	{
+		FClassEntry() = default;
+
+		explicit FClassEntry(FName ClassName)
+		{
+#if CSV_PROFILER
+			CsvMsStatName = FName(*FString::Printf(TEXT("%s_Ms"), *ClassName.ToString()));
+			CsvBytesStatName = FName(*FString::Printf(TEXT("%s_Bytes"), *ClassName.ToString()));
+#endif
+		}
+
+		FNetObjectCost FrameCost;
+		FNetObjectCost TotalCost;
+		TSet<uint64> SampledObjectIds;
+#if CSV_PROFILER
+		FName CsvMsStatName;
+		FName CsvBytesStatName;
+#endif
+#if COUNTERSTRACE_ENABLED
+		/** Trace counter ids for the total time, each phase and the bytes. 0 until the counters are created. */
+		uint16 CounterIds[FNetObjectCost::PhaseCount + 2] = {};
+#endif
+	};
+
+	struct FObjectEntry
+	{
+		FName ClassName;
+		FNetObjectCost TotalCost;
+	};
+
+	/** Returns a gap uniformly distributed over [1, 2*Interval - 1], so its mean is Interval */
+	int32 GetNextSampleGap(uint32 Interval)
+	{
+		// Weyl sequence hashed with the MurmurHash3 finalizer, cheap and safe to call from several threads
+		uint32 Hash = SampleGapSeed.fetch_add(0x9e3779b9U, std::memory_order_relaxed);
+		Hash ^= Hash >> 16;
+		Hash *= 0x85ebca6bU;
+		Hash ^= Hash >> 13;
+		Hash *= 0xc2b2ae35U;
+		Hash ^= Hash >> 16;
+
+		const uint64 GapRange = 2ULL*FMath::Min(Interval, uint32(MAX_int32/2)) - 1ULL;
+		return static_cast<int32>(1ULL + Hash % GapRange);
+	}
+
+	static double CyclesToMs(uint64 Cycles)
+	{
+		return FPlatformTime::ToMilliseconds64(Cycles);
+	}
+
+	static void AppendPhaseColumnNames(FString& Out)
+	{
+		for (int32 PhaseIt = 0; PhaseIt < FNetObjectCost::PhaseCount; ++PhaseIt)
+		{
+			Out += FString::Printf(TEXT(",%sMs"), LexToString(static_cast<ENetObjectCostPhase>(PhaseIt)));
+		}
+	}
+
+	static void AppendPhaseColumns(FString& Out, const FNetObjectCost& Cost)
+	{
+		for (const uint64 PhaseCycles : Cost.Cycles)
+		{
+			Out += FString::Printf(TEXT(",%.3f"), CyclesToMs(PhaseCycles));
+		}
+	}
+
+#if CSV_PROFILER
+	static int32 GetCsvCategoryIndex()
+	{
+		static const int32 CategoryIndex = FCsvProfiler::RegisterCategory(TEXT("NetObjectCost"), true, false);
+		return CategoryIndex;
+	}
+#endif
+
+#if COUNTERSTRACE_ENABLED
+	static void TraceClassCounters(FName ClassName, FClassEntry& Class)
+	{
+		if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(CountersChannel))
+		{
+			return;
+		}
+
+		constexpr int32 TotalCounter = FNetObjectCost::PhaseCount;
+		constexpr int32 BytesCounter = FNetObjectCost::PhaseCount + 1;
+		if (Class.CounterIds[0] == 0)
+		{
+			const FString Prefix = FString::Printf(TEXT("Net/ObjectCost/%s/"), *ClassName.ToString());
+			for (int32 PhaseIt = 0; PhaseIt < FNetObjectCost::PhaseCount; ++PhaseIt)
+			{
+				Class.CounterIds[PhaseIt] = FCountersTrace::OutputInitCounter(*(Prefix + LexToString(static_cast<ENetObjectCostPhase>(PhaseIt)) + TEXT("Ms")), TraceCounterType_Float, TraceCounterDisplayHint_None);
+			}
+			Class.CounterIds[TotalCounter] = FCountersTrace::OutputInitCounter(*(Prefix + TEXT("TotalMs")), TraceCounterType_Float, TraceCounterDisplayHint_None);
+			Class.CounterIds[BytesCounter] = FCountersTrace::OutputInitCounter(*(Prefix + TEXT("Bytes")), TraceCounterType_Int, TraceCounterDisplayHint_Memory);
+		}
+
+		const FNetObjectCost& Cost = Class.FrameCost;
+		for (int32 PhaseIt = 0; PhaseIt < FNetObjectCost::PhaseCount; ++PhaseIt)
+		{
+			FCountersTrace::OutputSetValue(Class.CounterIds[PhaseIt], CyclesToMs(Cost.Cycles[PhaseIt]));
+		}
+		FCountersTrace::OutputSetValue(Class.CounterIds[TotalCounter], CyclesToMs(Cost.GetTotalCycles()));
+		FCountersTrace::OutputSetValue(Class.CounterIds[BytesCounter], static_cast<int64>(Cost.Bits / 8U));
+	}
+#endif
+
+	mutable FCriticalSection Lock;
+	TMap<FName, FClassEntry> Classes;
+	TMap<uint64, FObjectEntry> Objects;
+	TArray<FNetObjectClassCostReport> FrameClasses;
+	std::atomic<uint32> SampleInterval = 0U;
+
+	/** Scopes left until the next sampled one, shared by all threads using this profiler */
+	std::atomic<int32> ScopesUntilSample = 0;
+	std::atomic<uint32> SampleGapSeed = 0U;
+};
+
+}
+
+/** Times Phase of the object for the profiler, if it's not null and decides to sample the scope. */
+#define UE_NET_OBJECT_COST_SCOPE(ScopeName, Profiler, ClassName, ObjectId, Phase) UE::Net::FNetObjectCostProfiler::FScope ScopeName(Profiler, ClassName, ObjectId, UE::Net::ENetObjectCostPhase::Phase)
+
+/** Attributes the bits written during a scope created with UE_NET_OBJECT_COST_SCOPE. */
+#define UE_NET_OBJECT_COST_SET_BITS(ScopeName, Bits) ScopeName.SetBits(Bits)
+
+#else
+
+#define UE_NET_OBJECT_COST_SCOPE(...)
+#define UE_NET_OBJECT_COST_SET_BITS(...)
+
+#endif
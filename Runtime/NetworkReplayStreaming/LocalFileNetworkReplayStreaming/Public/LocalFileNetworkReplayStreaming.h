@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
 #include "NetworkReplayStreaming.h"
 #include "Stats/Stats.h"
 #include "Tickable.h"
@@ -50,6 +51,7 @@ enum class ELocalFileChunkType : uint32
 	ReplayData,
 	Checkpoint,
 	Event,
+	TableOfContents,
 	Unknown = 0xFFFFFFFF
 };
 
@@ -168,9 +170,171 @@ struct FLocalFileReplayInfo
 	TArray<FLocalFileEventInfo> Events;
 	TArray<FLocalFileReplayDataInfo> DataChunks;
 
+	/** Returns the index of the last checkpoint taken at or before TimeInMS, or INDEX_NONE. Checkpoints are stored in time order. */
+	int32 FindCheckpointIndexForTime(const uint32 TimeInMS) const
+	{
+		return Algo::UpperBoundBy(Checkpoints, TimeInMS, &FLocalFileEventInfo::Time1) - 1;
+	}
+
+	/** Returns the index of the first data chunk that ends at or after TimeInMS, or INDEX_NONE. Data chunks are stored in time order. */
+	int32 FindDataChunkIndexForTime(const uint32 TimeInMS) const
+	{
+		const int32 DataChunkIndex = Algo::LowerBoundBy(DataChunks, TimeInMS, &FLocalFileReplayDataInfo::Time2);
+		return DataChunks.IsValidIndex(DataChunkIndex) ? DataChunkIndex : INDEX_NONE;
+	}
+
 	void CountBytes(FArchive& Ar) const;
 };
 
+/** Struct to hold the time range of a checkpoint or data chunk in the table of contents */
+struct FLocalFileTimeIndexEntry
+{
+	/** Size of an entry in an archive */
+	static constexpr int64 SerializedSize = sizeof(int32) + 2*sizeof(uint32);
+
+	int32 ChunkIndex = INDEX_NONE;
+	uint32 Time1 = 0;
+	uint32 Time2 = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FLocalFileTimeIndexEntry& Entry)
+	{
+		Ar << Entry.ChunkIndex;
+		Ar << Entry.Time1;
+		Ar << Entry.Time2;
+		return Ar;
+	}
+};
+
+/**
+ * Time indexed table of contents of a replay file, to be written as a TableOfContents chunk when recording stops.
+ * No replay version writes it yet; FLocalFileReplayCustomVersion only gets a new version once the streamer writes and reads the chunk.
+ *
+ * Holds the location of every chunk, so reading the replay info doesn't need to walk all chunk headers of the file,
+ * and the time ranges of checkpoints and data chunks, so seeking is a binary search rather than a linear scan.
+ * Only the chunks written before the table of contents are covered; chunks appended later are found by walking on from there.
+ */
+struct FLocalFileReplayTableOfContents
+{
+	TArray<FLocalFileChunkInfo> Chunks;
+	TArray<FLocalFileTimeIndexEntry> Checkpoints;
+	TArray<FLocalFileTimeIndexEntry> DataChunks;
+
+	void Build(const FLocalFileReplayInfo& ReplayInfo)
+	{
+		Chunks = ReplayInfo.Chunks;
+
+		Checkpoints.Reset(ReplayInfo.Checkpoints.Num());
+		for (const FLocalFileEventInfo& Checkpoint : ReplayInfo.Checkpoints)
+		{
+			Checkpoints.Add({ Checkpoint.ChunkIndex, Checkpoint.Time1, Checkpoint.Time2 });
+		}
+
+		DataChunks.Reset(ReplayInfo.DataChunks.Num());
+		for (const FLocalFileReplayDataInfo& DataChunk : ReplayInfo.DataChunks)
+		{
+			DataChunks.Add({ DataChunk.ChunkIndex, DataChunk.Time1, DataChunk.Time2 });
+		}
+	}
+
+	/** Returns the chunk index of the last checkpoint taken at or before TimeInMS, or INDEX_NONE */
+	int32 FindCheckpointChunkForTime(const uint32 TimeInMS) const
+	{
+		const int32 CheckpointIndex = Algo::UpperBoundBy(Checkpoints, TimeInMS, &FLocalFileTimeIndexEntry::Time1) - 1;
+		return Checkpoints.IsValidIndex(CheckpointIndex) ? Checkpoints[CheckpointIndex].ChunkIndex : INDEX_NONE;
+	}
+
+	/** Returns the chunk index of the first data chunk that ends at or after TimeInMS, or INDEX_NONE */
+	int32 FindDataChunkForTime(const uint32 TimeInMS) const
+	{
+		const int32 DataChunkIndex = Algo::LowerBoundBy(DataChunks, TimeInMS, &FLocalFileTimeIndexEntry::Time2);
+		return DataChunks.IsValidIndex(DataChunkIndex) ? DataChunks[DataChunkIndex].ChunkIndex : INDEX_NONE;
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FLocalFileReplayTableOfContents& TableOfContents)
+	{
+		// Chunk type, size and offsets
+		constexpr int64 SerializedChunkSize = sizeof(uint32) + sizeof(int32) + 2*sizeof(int64);
+
+		int32 NumChunks = TableOfContents.Chunks.Num();
+		if (!SerializeNum(Ar, NumChunks, SerializedChunkSize))
+		{
+			return Ar;
+		}
+
+		if (Ar.IsLoading())
+		{
+			TableOfContents.Chunks.Reset(NumChunks);
+			TableOfContents.Chunks.AddDefaulted(NumChunks);
+		}
+
+		for (FLocalFileChunkInfo& Chunk : TableOfContents.Chunks)
+		{
+			uint32 ChunkType = static_cast<uint32>(Chunk.ChunkType);
+			Ar << ChunkType;
+			Chunk.ChunkType = static_cast<ELocalFileChunkType>(ChunkType);
+
+			Ar << Chunk.SizeInBytes;
+			Ar << Chunk.TypeOffset;
+			Ar << Chunk.DataOffset;
+		}
+
+		SerializeTimeIndex(Ar, TableOfContents.Checkpoints);
+		SerializeTimeIndex(Ar, TableOfContents.DataChunks);
+		return Ar;
+	}
+
+	void CountBytes(FArchive& Ar) const
+	{
+		Chunks.CountBytes(Ar);
+		Checkpoints.CountBytes(Ar);
+		DataChunks.CountBytes(Ar);
+	}
+
+private:
+	/**
+	 * Serializes an element count. When loading, a count that the rest of the archive can't hold is rejected before anything
+	 * is allocated for it, so a corrupt or malicious file can't cause a huge allocation.
+	 *
+	 * @return	False if the count was invalid, in which case the archive is set to error
+	 */
+	static bool SerializeNum(FArchive& Ar, int32& Num, const int64 SerializedElementSize)
+	{
+		Ar << Num;
+
+		if (Ar.IsLoading())
+		{
+			const int64 RemainingBytes = Ar.TotalSize() - Ar.Tell();
+			if (Ar.IsError() || Num < 0 || int64(Num)*SerializedElementSize > RemainingBytes)
+			{
+				Ar.SetError();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static void SerializeTimeIndex(FArchive& Ar, TArray<FLocalFileTimeIndexEntry>& Entries)
+	{
+		int32 NumEntries = Entries.Num();
+		if (!SerializeNum(Ar, NumEntries, FLocalFileTimeIndexEntry::SerializedSize))
+		{
+			return;
+		}
+
+		if (Ar.IsLoading())
+		{
+			Entries.Reset(NumEntries);
+			Entries.AddDefaulted(NumEntries);
+		}
+
+		for (FLocalFileTimeIndexEntry& Entry : Entries)
+		{
+			Ar << Entry;
+		}
+	}
+};
+
 /** Archive to wrap the file reader and respect chunk boundaries */
 class FLocalFileStreamFArchive : public FArchive
 {
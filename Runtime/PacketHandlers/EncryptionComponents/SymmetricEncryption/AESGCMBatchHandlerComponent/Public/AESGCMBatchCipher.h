@@ -0,0 +1,1249 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/ArrayView.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/ByteSwap.h"
+
+/**
+ * AES-NI and PCLMULQDQ are compiled in on x86 platforms with CPUID and selected at runtime. Other CPUs use a bitsliced
+ * implementation that is slower but also constant time; there is deliberately no table based fallback, as table lookups
+ * indexed by key dependent values leak timing.
+ */
+#if !defined(UE_AESGCM_BATCH_WITH_AESNI)
+	#define UE_AESGCM_BATCH_WITH_AESNI (PLATFORM_CPU_X86_FAMILY && PLATFORM_HAS_CPUID)
+#endif
+
+#if UE_AESGCM_BATCH_WITH_AESNI
+	#include <wmmintrin.h>	// AES-NI and PCLMULQDQ
+	#include <smmintrin.h>	// SSSE3 byte shuffle and SSE4.1 insert
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+		// MSVC allows the intrinsics in any function
+		#define UE_AESGCM_AESNI_FUNCTION
+	#else
+		#include <cpuid.h>
+		// Allows the intrinsics without building the whole module with -maes, callers must check IsSupported first
+		#define UE_AESGCM_AESNI_FUNCTION __attribute__((target("aes,pclmul,ssse3,sse4.1")))
+	#endif
+#endif
+
+#if PLATFORM_WINDOWS
+	#include "Windows/WindowsHWrapper.h"
+	#include "Windows/AllowWindowsPlatformTypes.h"
+	#include <bcrypt.h>
+	#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_APPLE || PLATFORM_ANDROID
+	#include <stdlib.h>
+#elif PLATFORM_UNIX
+	#include <errno.h>
+	#include <sys/random.h>
+#endif
+
+/**
+ * One packet of a batch processed by FAESGCMBatchCipher. The packet data is encrypted or decrypted in place.
+ */
+struct FAESGCMPacketRef
+{
+	/** The packet data */
+	uint8* Data = nullptr;
+
+	/** The size of the packet data in bytes */
+	int32 Count = 0;
+
+	/** The 96 bit IV of the packet. Must never be reused with the same key */
+	const uint8* IV = nullptr;
+
+	/** The 128 bit authentication tag of the packet. Written by encryption, verified by decryption */
+	uint8* Tag = nullptr;
+};
+
+namespace UE::Handler::AESGCM::Private
+{
+	/**
+	 * Fills Out with bytes from the operating system's cryptographically secure random number generator.
+	 *
+	 * @return	False if the platform has no such generator or it failed, in which case Out must not be used
+	 */
+	inline bool GetSecureRandomBytes(TArrayView<uint8> Out)
+	{
+#if PLATFORM_WINDOWS
+		return BCRYPT_SUCCESS(BCryptGenRandom(nullptr, Out.GetData(), static_cast<ULONG>(Out.Num()), BCRYPT_USE_SYSTEM_PREFERRED_RNG));
+#elif PLATFORM_APPLE || PLATFORM_ANDROID
+		arc4random_buf(Out.GetData(), Out.Num());
+		return true;
+#elif PLATFORM_UNIX
+		int32 Offset = 0;
+		while (Offset < Out.Num())
+		{
+			const ssize_t Result = getrandom(Out.GetData() + Offset, Out.Num() - Offset, 0);
+			if (Result < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				return false;
+			}
+			Offset += static_cast<int32>(Result);
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	inline uint32 LoadLittleEndian32(const uint8* Bytes)
+	{
+		return uint32(Bytes[0]) | (uint32(Bytes[1]) << 8) | (uint32(Bytes[2]) << 16) | (uint32(Bytes[3]) << 24);
+	}
+
+	inline void StoreLittleEndian32(uint8* Bytes, uint32 Value)
+	{
+		Bytes[0] = uint8(Value);
+		Bytes[1] = uint8(Value >> 8);
+		Bytes[2] = uint8(Value >> 16);
+		Bytes[3] = uint8(Value >> 24);
+	}
+
+	inline void StoreBigEndian32(uint8* Bytes, uint32 Value)
+	{
+		Bytes[0] = uint8(Value >> 24);
+		Bytes[1] = uint8(Value >> 16);
+		Bytes[2] = uint8(Value >> 8);
+		Bytes[3] = uint8(Value);
+	}
+
+	inline uint64 LoadBigEndian64(const uint8* Bytes)
+	{
+		return (uint64(Bytes[0]) << 56) | (uint64(Bytes[1]) << 48) | (uint64(Bytes[2]) << 40) | (uint64(Bytes[3]) << 32)
+			| (uint64(Bytes[4]) << 24) | (uint64(Bytes[5]) << 16) | (uint64(Bytes[6]) << 8) | uint64(Bytes[7]);
+	}
+
+	inline void StoreBigEndian64(uint8* Bytes, uint64 Value)
+	{
+		StoreBigEndian32(Bytes, uint32(Value >> 32));
+		StoreBigEndian32(Bytes + 4, uint32(Value));
+	}
+
+	/**
+	 * Constant time AES-256 for CPUs without AES-NI, following the layout of BearSSL's aes_ct64. Four blocks are bitsliced into
+	 * eight 64 bit words and the S-box is evaluated as a boolean circuit (Boyar and Peralta), so no memory access or branch
+	 * depends on the key or the data.
+	 */
+	struct FBitslicedAES256
+	{
+		static constexpr int32 NumRounds = 14;
+
+		/** Bitsliced round keys, eight words per round */
+		uint64 RoundKeys[(NumRounds + 1) * 8];
+
+		void SetKey(const uint8* Key)
+		{
+			static constexpr uint8 RoundConstants[7] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40 };
+			constexpr int32 KeyWords = 8;
+			constexpr int32 ScheduleWords = (NumRounds + 1) * 4;
+
+			// FIPS-197 section 5.2, on little endian words
+			uint32 Schedule[ScheduleWords];
+			for (int32 WordIt = 0; WordIt < KeyWords; ++WordIt)
+			{
+				Schedule[WordIt] = LoadLittleEndian32(Key + WordIt*4);
+			}
+
+			uint32 Word = Schedule[KeyWords - 1];
+			for (int32 WordIt = KeyWords; WordIt < ScheduleWords; ++WordIt)
+			{
+				if (WordIt % KeyWords == 0)
+				{
+					Word = SubWord((Word << 24) | (Word >> 8)) ^ RoundConstants[WordIt/KeyWords - 1];
+				}
+				else if (WordIt % KeyWords == 4)
+				{
+					Word = SubWord(Word);
+				}
+				Word ^= Schedule[WordIt - KeyWords];
+				Schedule[WordIt] = Word;
+			}
+
+			for (int32 Round = 0; Round <= NumRounds; ++Round)
+			{
+				uint64 Q[8];
+				InterleaveIn(Q[0], Q[4], Schedule + Round*4);
+				Q[1] = Q[2] = Q[3] = Q[0];
+				Q[5] = Q[6] = Q[7] = Q[4];
+				Ortho(Q);
+				FMemory::Memcpy(RoundKeys + Round*8, Q, sizeof(Q));
+				FMemory::Memzero(Q);
+			}
+
+			FMemory::Memzero(Schedule);
+		}
+
+		/** Encrypts four blocks in place */
+		void EncryptBlocks4(uint8 (&Blocks)[4][16]) const
+		{
+			uint32 Words[16];
+			for (int32 WordIt = 0; WordIt < 16; ++WordIt)
+			{
+				Words[WordIt] = LoadLittleEndian32(&Blocks[WordIt / 4][(WordIt % 4)*4]);
+			}
+
+			uint64 Q[8];
+			for (int32 BlockIt = 0; BlockIt < 4; ++BlockIt)
+			{
+				InterleaveIn(Q[BlockIt], Q[BlockIt + 4], Words + BlockIt*4);
+			}
+			Ortho(Q);
+
+			AddRoundKey(Q, RoundKeys);
+			for (int32 Round = 1; Round < NumRounds; ++Round)
+			{
+				SubBytes(Q);
+				ShiftRows(Q);
+				MixColumns(Q);
+				AddRoundKey(Q, RoundKeys + Round*8);
+			}
+			SubBytes(Q);
+			ShiftRows(Q);
+			AddRoundKey(Q, RoundKeys + NumRounds*8);
+
+			Ortho(Q);
+			for (int32 BlockIt = 0; BlockIt < 4; ++BlockIt)
+			{
+				InterleaveOut(Words + BlockIt*4, Q[BlockIt], Q[BlockIt + 4]);
+			}
+
+			for (int32 WordIt = 0; WordIt < 16; ++WordIt)
+			{
+				StoreLittleEndian32(&Blocks[WordIt / 4][(WordIt % 4)*4], Words[WordIt]);
+			}
+
+			FMemory::Memzero(Words);
+			FMemory::Memzero(Q);
+		}
+
+	private:
+		/** Applies the S-box to every byte of the bitsliced state */
+		static void SubBytes(uint64 (&Q)[8])
+		{
+			const uint64 X0 = Q[7], X1 = Q[6], X2 = Q[5], X3 = Q[4], X4 = Q[3], X5 = Q[2], X6 = Q[1], X7 = Q[0];
+
+			// Top linear transformation
+			const uint64 Y14 = X3 ^ X5;
+			const uint64 Y13 = X0 ^ X6;
+			const uint64 Y9 = X0 ^ X3;
+			const uint64 Y8 = X0 ^ X5;
+			const uint64 T0 = X1 ^ X2;
+			const uint64 Y1 = T0 ^ X7;
+			const uint64 Y4 = Y1 ^ X3;
+			const uint64 Y12 = Y13 ^ Y14;
+			const uint64 Y2 = Y1 ^ X0;
+			const uint64 Y5 = Y1 ^ X6;
+			const uint64 Y3 = Y5 ^ Y8;
+			const uint64 T1 = X4 ^ Y12;
+			const uint64 Y15 = T1 ^ X5;
+			const uint64 Y20 = T1 ^ X1;
+			const uint64 Y6 = Y15 ^ X7;
+			const uint64 Y10 = Y15 ^ T0;
+			const uint64 Y11 = Y20 ^ Y9;
+			const uint64 Y7 = X7 ^ Y11;
+			const uint64 Y17 = Y10 ^ Y11;
+			const uint64 Y19 = Y10 ^ Y8;
+			const uint64 Y16 = T0 ^ Y11;
+			const uint64 Y21 = Y13 ^ Y16;
+			const uint64 Y18 = X0 ^ Y16;
+
+			// Non-linear section
+			const uint64 T2 = Y12 & Y15;
+			const uint64 T3 = Y3 & Y6;
+			const uint64 T4 = T3 ^ T2;
+			const uint64 T5 = Y4 & X7;
+			const uint64 T6 = T5 ^ T2;
+			const uint64 T7 = Y13 & Y16;
+			const uint64 T8 = Y5 & Y1;
+			const uint64 T9 = T8 ^ T7;
+			const uint64 T10 = Y2 & Y7;
+			const uint64 T11 = T10 ^ T7;
+			const uint64 T12 = Y9 & Y11;
+			const uint64 T13 = Y14 & Y17;
+			const uint64 T14 = T13 ^ T12;
+			const uint64 T15 = Y8 & Y10;
+			const uint64 T16 = T15 ^ T12;
+			const uint64 T17 = T4 ^ T14;
+			const uint64 T18 = T6 ^ T16;
+			const uint64 T19 = T9 ^ T14;
+			const uint64 T20 = T11 ^ T16;
+			const uint64 T21 = T17 ^ Y20;
+			const uint64 T22 = T18 ^ Y19;
+			const uint64 T23 = T19 ^ Y21;
+			const uint64 T24 = T20 ^ Y18;
+
+			const uint64 T25 = T21 ^ T22;
+			const uint64 T26 = T21 & T23;
+			const uint64 T27 = T24 ^ T26;
+			const uint64 T28 = T25 & T27;
+			const uint64 T29 = T28 ^ T22;
+			const uint64 T30 = T23 ^ T24;
+			const uint64 T31 = T22 ^ T26;
+			const uint64 T32 = T31 & T30;
+			const uint64 T33 = T32 ^ T24;
+			const uint64 T34 = T23 ^ T33;
+			const uint64 T35 = T27 ^ T33;
+			const uint64 T36 = T24 & T35;
+			const uint64 T37 = T36 ^ T34;
+			const uint64 T38 = T27 ^ T36;
+			const uint64 T39 = T29 & T38;
+			const uint64 T40 = T25 ^ T39;
+
+			const uint64 T41 = T40 ^ T37;
+			const uint64 T42 = T29 ^ T33;
+			const uint64 T43 = T29 ^ T40;
+			const uint64 T44 = T33 ^ T37;
+			const uint64 T45 = T42 ^ T41;
+			const uint64 Z0 = T44 & Y15;
+			const uint64 Z1 = T37 & Y6;
+			const uint64 Z2 = T33 & X7;
+			const uint64 Z3 = T43 & Y16;
+			const uint64 Z4 = T40 & Y1;
+			const uint64 Z5 = T29 & Y7;
+			const uint64 Z6 = T42 & Y11;
+			const uint64 Z7 = T45 & Y17;
+			const uint64 Z8 = T41 & Y10;
+			const uint64 Z9 = T44 & Y12;
+			const uint64 Z10 = T37 & Y3;
+			const uint64 Z11 = T33 & Y4;
+			const uint64 Z12 = T43 & Y13;
+			const uint64 Z13 = T40 & Y5;
+			const uint64 Z14 = T29 & Y2;
+			const uint64 Z15 = T42 & Y9;
+			const uint64 Z16 = T45 & Y14;
+			const uint64 Z17 = T41 & Y8;
+
+			// Bottom linear transformation
+			const uint64 T46 = Z15 ^ Z16;
+			const uint64 T47 = Z10 ^ Z11;
+			const uint64 T48 = Z5 ^ Z13;
+			const uint64 T49 = Z9 ^ Z10;
+			const uint64 T50 = Z2 ^ Z12;
+			const uint64 T51 = Z2 ^ Z5;
+			const uint64 T52 = Z7 ^ Z8;
+			const uint64 T53 = Z0 ^ Z3;
+			const uint64 T54 = Z6 ^ Z7;
+			const uint64 T55 = Z16 ^ Z17;
+			const uint64 T56 = Z12 ^ T48;
+			const uint64 T57 = T50 ^ T53;
+			const uint64 T58 = Z4 ^ T46;
+			const uint64 T59 = Z3 ^ T54;
+			const uint64 T60 = T46 ^ T57;
+			const uint64 T61 = Z14 ^ T57;
+			const uint64 T62 = T52 ^ T58;
+			const uint64 T63 = T49 ^ T58;
+			const uint64 T64 = Z4 ^ T59;
+			const uint64 T65 = T61 ^ T62;
+			const uint64 T66 = Z1 ^ T63;
+			const uint64 S0 = T59 ^ T63;
+			const uint64 S6 = T56 ^ ~T62;
+			const uint64 S7 = T48 ^ ~T60;
+			const uint64 T67 = T64 ^ T65;
+			const uint64 S3 = T53 ^ T66;
+			const uint64 S4 = T51 ^ T66;
+			const uint64 S5 = T47 ^ T65;
+			const uint64 S1 = T64 ^ ~S3;
+			const uint64 S2 = T55 ^ ~T67;
+
+			Q[7] = S0;
+			Q[6] = S1;
+			Q[5] = S2;
+			Q[4] = S3;
+			Q[3] = S4;
+			Q[2] = S5;
+			Q[1] = S6;
+			Q[0] = S7;
+		}
+
+		static FORCEINLINE void SwapBits(uint64& A, uint64& B, uint64 LowMask, int32 Shift)
+		{
+			const uint64 OldA = A;
+			const uint64 OldB = B;
+			A = (OldA & LowMask) | ((OldB & LowMask) << Shift);
+			B = ((OldA >> Shift) & LowMask) | (OldB & ~LowMask);
+		}
+
+		/** Converts between the interleaved and the bitsliced representation, its own inverse */
+		static void Ortho(uint64 (&Q)[8])
+		{
+			for (int32 It = 0; It < 8; It += 2)
+			{
+				SwapBits(Q[It], Q[It + 1], 0x5555555555555555ULL, 1);
+			}
+			for (int32 It : { 0, 1, 4, 5 })
+			{
+				SwapBits(Q[It], Q[It + 2], 0x3333333333333333ULL, 2);
+			}
+			for (int32 It = 0; It < 4; ++It)
+			{
+				SwapBits(Q[It], Q[It + 4], 0x0F0F0F0F0F0F0F0FULL, 4);
+			}
+		}
+
+		/** Spreads the four words of a block over the even and odd bytes of two words */
+		static void InterleaveIn(uint64& OutQ0, uint64& OutQ1, const uint32* Words)
+		{
+			uint64 X[4];
+			for (int32 It = 0; It < 4; ++It)
+			{
+				X[It] = Words[It];
+				X[It] |= X[It] << 16;
+				X[It] &= 0x0000FFFF0000FFFFULL;
+				X[It] |= X[It] << 8;
+				X[It] &= 0x00FF00FF00FF00FFULL;
+			}
+			OutQ0 = X[0] | (X[2] << 8);
+			OutQ1 = X[1] | (X[3] << 8);
+		}
+
+		static void InterleaveOut(uint32* OutWords, uint64 Q0, uint64 Q1)
+		{
+			uint64 X[4] =
+			{
+				Q0 & 0x00FF00FF00FF00FFULL,
+				Q1 & 0x00FF00FF00FF00FFULL,
+				(Q0 >> 8) & 0x00FF00FF00FF00FFULL,
+				(Q1 >> 8) & 0x00FF00FF00FF00FFULL
+			};
+			for (int32 It = 0; It < 4; ++It)
+			{
+				X[It] |= X[It] >> 8;
+				X[It] &= 0x0000FFFF0000FFFFULL;
+				OutWords[It] = uint32(X[It]) | uint32(X[It] >> 16);
+			}
+		}
+
+		static FORCEINLINE void AddRoundKey(uint64 (&Q)[8], const uint64* Key)
+		{
+			for (int32 It = 0; It < 8; ++It)
+			{
+				Q[It] ^= Key[It];
+			}
+		}
+
+		static void ShiftRows(uint64 (&Q)[8])
+		{
+			for (uint64& X : Q)
+			{
+				X = (X & 0x000000000000FFFFULL)
+					| ((X & 0x00000000FFF00000ULL) >> 4)
+					| ((X & 0x00000000000F0000ULL) << 12)
+					| ((X & 0x0000FF0000000000ULL) >> 8)
+					| ((X & 0x000000FF00000000ULL) << 8)
+					| ((X & 0xF000000000000000ULL) >> 12)
+					| ((X & 0x0FFF000000000000ULL) << 4);
+			}
+		}
+
+		static FORCEINLINE uint64 Rotate32(uint64 X)
+		{
+			return (X << 32) | (X >> 32);
+		}
+
+		static void MixColumns(uint64 (&Q)[8])
+		{
+			uint64 R[8];
+			for (int32 It = 0; It < 8; ++It)
+			{
+				R[It] = (Q[It] >> 16) | (Q[It] << 48);
+			}
+
+			const uint64 Q0 = Q[0], Q1 = Q[1], Q2 = Q[2], Q3 = Q[3], Q4 = Q[4], Q5 = Q[5], Q6 = Q[6], Q7 = Q[7];
+			Q[0] = Q7 ^ R[7] ^ R[0] ^ Rotate32(Q0 ^ R[0]);
+			Q[1] = Q0 ^ R[0] ^ Q7 ^ R[7] ^ R[1] ^ Rotate32(Q1 ^ R[1]);
+			Q[2] = Q1 ^ R[1] ^ R[2] ^ Rotate32(Q2 ^ R[2]);
+			Q[3] = Q2 ^ R[2] ^ Q7 ^ R[7] ^ R[3] ^ Rotate32(Q3 ^ R[3]);
+			Q[4] = Q3 ^ R[3] ^ Q7 ^ R[7] ^ R[4] ^ Rotate32(Q4 ^ R[4]);
+			Q[5] = Q4 ^ R[4] ^ R[5] ^ Rotate32(Q5 ^ R[5]);
+			Q[6] = Q5 ^ R[5] ^ R[6] ^ Rotate32(Q6 ^ R[6]);
+			Q[7] = Q6 ^ R[6] ^ R[7] ^ Rotate32(Q7 ^ R[7]);
+		}
+
+		/** Applies the S-box to each byte of Word, used by the key schedule */
+		static uint32 SubWord(uint32 Word)
+		{
+			uint64 Q[8] = { Word };
+			Ortho(Q);
+			SubBytes(Q);
+			Ortho(Q);
+			const uint32 Result = uint32(Q[0]);
+			FMemory::Memzero(Q);
+			return Result;
+		}
+	};
+
+	/** Carry-less multiplication keeping the low 64 bits. Integer multiplies on operands with holes, so carries never reach a result bit. */
+	inline uint64 CarrylessMul64(uint64 X, uint64 Y)
+	{
+		const uint64 X0 = X & 0x1111111111111111ULL;
+		const uint64 X1 = X & 0x2222222222222222ULL;
+		const uint64 X2 = X & 0x4444444444444444ULL;
+		const uint64 X3 = X & 0x8888888888888888ULL;
+		const uint64 Y0 = Y & 0x1111111111111111ULL;
+		const uint64 Y1 = Y & 0x2222222222222222ULL;
+		const uint64 Y2 = Y & 0x4444444444444444ULL;
+		const uint64 Y3 = Y & 0x8888888888888888ULL;
+		const uint64 Z0 = (X0*Y0) ^ (X1*Y3) ^ (X2*Y2) ^ (X3*Y1);
+		const uint64 Z1 = (X0*Y1) ^ (X1*Y0) ^ (X2*Y3) ^ (X3*Y2);
+		const uint64 Z2 = (X0*Y2) ^ (X1*Y1) ^ (X2*Y0) ^ (X3*Y3);
+		const uint64 Z3 = (X0*Y3) ^ (X1*Y2) ^ (X2*Y1) ^ (X3*Y0);
+		return (Z0 & 0x1111111111111111ULL) | (Z1 & 0x2222222222222222ULL) | (Z2 & 0x4444444444444444ULL) | (Z3 & 0x8888888888888888ULL);
+	}
+
+	inline uint64 ReverseBits64(uint64 X)
+	{
+		X = ((X & 0x5555555555555555ULL) << 1) | ((X >> 1) & 0x5555555555555555ULL);
+		X = ((X & 0x3333333333333333ULL) << 2) | ((X >> 2) & 0x3333333333333333ULL);
+		X = ((X & 0x0F0F0F0F0F0F0F0FULL) << 4) | ((X >> 4) & 0x0F0F0F0F0F0F0F0FULL);
+		X = ((X & 0x00FF00FF00FF00FFULL) << 8) | ((X >> 8) & 0x00FF00FF00FF00FFULL);
+		X = ((X & 0x0000FFFF0000FFFFULL) << 16) | ((X >> 16) & 0x0000FFFF0000FFFFULL);
+		return (X << 32) | (X >> 32);
+	}
+
+	/**
+	 * Hash = (Hash ^ Block) * H in GF(2^128), without tables or carry-less multiply instructions (BearSSL's ghash_ctmul64).
+	 * Field elements are stored as two big endian halves, [0] holding the first eight bytes.
+	 */
+	inline void GHashMultiplyPortable(uint64 (&Hash)[2], const uint64 (&H)[2], const uint8* Block)
+	{
+		const uint64 H1 = H[0];
+		const uint64 H0 = H[1];
+		const uint64 H0R = ReverseBits64(H0);
+		const uint64 H1R = ReverseBits64(H1);
+		const uint64 H2 = H0 ^ H1;
+		const uint64 H2R = H0R ^ H1R;
+
+		const uint64 Y1 = Hash[0] ^ LoadBigEndian64(Block);
+		const uint64 Y0 = Hash[1] ^ LoadBigEndian64(Block + 8);
+		const uint64 Y0R = ReverseBits64(Y0);
+		const uint64 Y1R = ReverseBits64(Y1);
+		const uint64 Y2 = Y0 ^ Y1;
+		const uint64 Y2R = Y0R ^ Y1R;
+
+		// Karatsuba, with the high halves of the products computed on bit reversed operands
+		const uint64 Z0 = CarrylessMul64(Y0, H0);
+		const uint64 Z1 = CarrylessMul64(Y1, H1);
+		uint64 Z2 = CarrylessMul64(Y2, H2);
+		uint64 Z0H = CarrylessMul64(Y0R, H0R);
+		uint64 Z1H = CarrylessMul64(Y1R, H1R);
+		uint64 Z2H = CarrylessMul64(Y2R, H2R);
+		Z2 ^= Z0 ^ Z1;
+		Z2H ^= Z0H ^ Z1H;
+		Z0H = ReverseBits64(Z0H) >> 1;
+		Z1H = ReverseBits64(Z1H) >> 1;
+		Z2H = ReverseBits64(Z2H) >> 1;
+
+		// Shift left by one bit for the reflected bit order, then reduce modulo x^128 + x^7 + x^2 + x + 1
+		uint64 V0 = Z0;
+		uint64 V1 = Z0H ^ Z2;
+		uint64 V2 = Z1 ^ Z2H;
+		uint64 V3 = Z1H;
+		V3 = (V3 << 1) | (V2 >> 63);
+		V2 = (V2 << 1) | (V1 >> 63);
+		V1 = (V1 << 1) | (V0 >> 63);
+		V0 = V0 << 1;
+		V2 ^= V0 ^ (V0 >> 1) ^ (V0 >> 2) ^ (V0 >> 7);
+		V1 ^= (V0 << 63) ^ (V0 << 62) ^ (V0 << 57);
+		V3 ^= V1 ^ (V1 >> 1) ^ (V1 >> 2) ^ (V1 >> 7);
+		V2 ^= (V1 << 63) ^ (V1 << 62) ^ (V1 << 57);
+
+		Hash[0] = V3;
+		Hash[1] = V2;
+	}
+}
+
+/**
+ * AES-256-GCM for packet encryption, with the key schedule and GHASH key powers set up once per key rather than once per packet.
+ *
+ * Packets are processed in place without any allocation, either one at a time or as a batch. With AES-NI the round keys stay in
+ * registers for the whole batch, four counter blocks are encrypted at a time and GHASH uses carry-less multiplication with one
+ * reduction per four blocks. CPUs without AES-NI, PCLMULQDQ and SSE4.1 use the constant time bitsliced AES and GHASH from
+ * UE::Handler::AESGCM::Private instead.
+ *
+ * Only the packet payload is authenticated; there is no additional authenticated data.
+ */
+class FAESGCMBatchCipher
+{
+public:
+	static constexpr int32 KeySizeInBytes = 32;
+	static constexpr int32 IVSizeInBytes = 12;
+	static constexpr int32 TagSizeInBytes = 16;
+	static constexpr int32 BlockSizeInBytes = 16;
+
+	FAESGCMBatchCipher()
+	{
+		Reset();
+	}
+
+	~FAESGCMBatchCipher()
+	{
+		Reset();
+	}
+
+	FAESGCMBatchCipher(const FAESGCMBatchCipher&) = delete;
+	FAESGCMBatchCipher& operator=(const FAESGCMBatchCipher&) = delete;
+
+	/**
+	 * Whether the known answer tests passed for the implementation used on this CPU, AES-NI or the bitsliced fallback.
+	 * Evaluated once and cached.
+	 */
+	static bool IsSupported()
+	{
+		static const bool bSupported = RunKnownAnswerTests(UseAESNI());
+		return bSupported;
+	}
+
+	/** Whether packets are processed with AES-NI and PCLMULQDQ rather than the slower bitsliced implementation */
+	static bool UseAESNI()
+	{
+#if UE_AESGCM_BATCH_WITH_AESNI
+		static const bool bHasAESNI = HasRequiredCPUFeatures();
+		return bHasAESNI;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * Expands the key. Must be called before any packet is processed.
+	 *
+	 * @return	False if the key is not KeySizeInBytes long or the known answer tests failed
+	 */
+	bool SetKey(TArrayView<const uint8> Key)
+	{
+		Reset();
+
+		if (Key.Num() != KeySizeInBytes || !IsSupported())
+		{
+			return false;
+		}
+
+		SetKeyInternal(Key.GetData(), UseAESNI());
+		return true;
+	}
+
+	/** Wipes the key material */
+	void Reset()
+	{
+#if UE_AESGCM_BATCH_WITH_AESNI
+		FMemory::Memzero(RoundKeys);
+		FMemory::Memzero(HashKeyPowers);
+#endif
+		FMemory::Memzero(PortableAES.RoundKeys);
+		FMemory::Memzero(PortableHashKey);
+		bHasKey = false;
+	}
+
+	bool HasKey() const
+	{
+		return bHasKey;
+	}
+
+	/** Encrypts Packet.Data in place and writes its tag */
+	void Encrypt(const FAESGCMPacketRef& Packet) const
+	{
+		EncryptPackets(MakeArrayView(&Packet, 1));
+	}
+
+	/**
+	 * Verifies the tag of Packet and decrypts Packet.Data in place if it matches. Data is left untouched if it doesn't.
+	 *
+	 * @return	Whether the tag matched
+	 */
+	bool Decrypt(const FAESGCMPacketRef& Packet) const
+	{
+		bool bSuccess = false;
+		DecryptPackets(MakeArrayView(&Packet, 1), MakeArrayView(&bSuccess, 1));
+		return bSuccess;
+	}
+
+	/** Encrypts a batch of packets, e.g. everything a connection sends in one tick */
+	void EncryptPackets(TArrayView<const FAESGCMPacketRef> Packets) const
+	{
+		check(bHasKey);
+
+		if (bUseAESNI)
+		{
+#if UE_AESGCM_BATCH_WITH_AESNI
+			EncryptPacketsAESNI(Packets);
+#endif
+		}
+		else
+		{
+			EncryptPacketsPortable(Packets);
+		}
+	}
+
+	/**
+	 * Verifies and decrypts a batch of packets. Packets that fail verification are left untouched.
+	 *
+	 * @param OutSuccess	Receives whether each packet was authentic, must have as many entries as Packets
+	 */
+	void DecryptPackets(TArrayView<const FAESGCMPacketRef> Packets, TArrayView<bool> OutSuccess) const
+	{
+		check(bHasKey);
+		check(OutSuccess.Num() == Packets.Num());
+
+		if (bUseAESNI)
+		{
+#if UE_AESGCM_BATCH_WITH_AESNI
+			DecryptPacketsAESNI(Packets, OutSuccess);
+#endif
+		}
+		else
+		{
+			DecryptPacketsPortable(Packets, OutSuccess);
+		}
+	}
+
+private:
+	/**
+	 * Checks the implementation against AES-256 test cases 13 to 15 of the GCM specification (McGrew and Viega), including
+	 * rejection of a tampered packet. Encryption is refused if this fails.
+	 */
+	static bool RunKnownAnswerTests(bool bWithAESNI)
+	{
+		static constexpr uint8 Key15[KeySizeInBytes] =
+		{
+			0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+			0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08
+		};
+		static constexpr uint8 IV15[IVSizeInBytes] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+		static constexpr uint8 Plaintext15[64] =
+		{
+			0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5, 0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+			0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda, 0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+			0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53, 0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+			0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57, 0xba, 0x63, 0x7b, 0x39, 0x1a, 0xaf, 0xd2, 0x55
+		};
+		static constexpr uint8 Ciphertext15[64] =
+		{
+			0x52, 0x2d, 0xc1, 0xf0, 0x99, 0x56, 0x7d, 0x07, 0xf4, 0x7f, 0x37, 0xa3, 0x2a, 0x84, 0x42, 0x7d,
+			0x64, 0x3a, 0x8c, 0xdc, 0xbf, 0xe5, 0xc0, 0xc9, 0x75, 0x98, 0xa2, 0xbd, 0x25, 0x55, 0xd1, 0xaa,
+			0x8c, 0xb0, 0x8e, 0x48, 0x59, 0x0d, 0xbb, 0x3d, 0xa7, 0xb0, 0x8b, 0x10, 0x56, 0x82, 0x88, 0x38,
+			0xc5, 0xf6, 0x1e, 0x63, 0x93, 0xba, 0x7a, 0x0a, 0xbc, 0xc9, 0xf6, 0x62, 0x89, 0x80, 0x15, 0xad
+		};
+		static constexpr uint8 Tag15[TagSizeInBytes] = { 0xb0, 0x94, 0xda, 0xc5, 0xd9, 0x34, 0x71, 0xbd, 0xec, 0x1a, 0x50, 0x22, 0x70, 0xe3, 0xcc, 0x6c };
+
+		// Test cases 13 and 14 use an all zero key and IV, and an empty or single zero block plaintext
+		static constexpr uint8 Ciphertext14[16] = { 0xce, 0xa7, 0x40, 0x3d, 0x4d, 0x60, 0x6b, 0x6e, 0x07, 0x4e, 0xc5, 0xd3, 0xba, 0xf3, 0x9d, 0x18 };
+		static constexpr uint8 Tag14[TagSizeInBytes] = { 0xd0, 0xd1, 0xc8, 0xa7, 0x99, 0x99, 0x6b, 0xf0, 0x26, 0x5b, 0x98, 0xb5, 0xd4, 0x8a, 0xb9, 0x19 };
+		static constexpr uint8 Tag13[TagSizeInBytes] = { 0x53, 0x0f, 0x8a, 0xfb, 0xc7, 0x45, 0x36, 0xb9, 0xa9, 0x63, 0xb4, 0xf1, 0xc4, 0xcb, 0x73, 0x8b };
+
+		auto Equals = [](const uint8* A, const uint8* B, int32 Count)
+		{
+			return FMemory::Memcmp(A, B, Count) == 0;
+		};
+
+		FAESGCMBatchCipher Cipher;
+		uint8 Tag[TagSizeInBytes];
+		bool bSuccess = false;
+
+		const uint8 ZeroKey[KeySizeInBytes] = {};
+		const uint8 ZeroIV[IVSizeInBytes] = {};
+		Cipher.SetKeyInternal(ZeroKey, bWithAESNI);
+
+		const FAESGCMPacketRef Packet13{nullptr, 0, ZeroIV, Tag};
+		Cipher.EncryptPackets(MakeArrayView(&Packet13, 1));
+		if (!Equals(Tag, Tag13, TagSizeInBytes))
+		{
+			return false;
+		}
+
+		uint8 Block[16] = {};
+		const FAESGCMPacketRef Packet14{Block, 16, ZeroIV, Tag};
+		Cipher.EncryptPackets(MakeArrayView(&Packet14, 1));
+		if (!Equals(Block, Ciphertext14, 16) || !Equals(Tag, Tag14, TagSizeInBytes))
+		{
+			return false;
+		}
+
+		Cipher.SetKeyInternal(Key15, bWithAESNI);
+
+		uint8 Data[64];
+		FMemory::Memcpy(Data, Plaintext15, sizeof(Data));
+		const FAESGCMPacketRef Packet15{Data, 64, IV15, Tag};
+		Cipher.EncryptPackets(MakeArrayView(&Packet15, 1));
+		if (!Equals(Data, Ciphertext15, 64) || !Equals(Tag, Tag15, TagSizeInBytes))
+		{
+			return false;
+		}
+
+		// Decrypting a tampered packet must fail and leave it untouched
+		Data[17] ^= 0x01;
+		Cipher.DecryptPackets(MakeArrayView(&Packet15, 1), MakeArrayView(&bSuccess, 1));
+		Data[17] ^= 0x01;
+		if (bSuccess || !Equals(Data, Ciphertext15, 64))
+		{
+			return false;
+		}
+
+		Cipher.DecryptPackets(MakeArrayView(&Packet15, 1), MakeArrayView(&bSuccess, 1));
+		return bSuccess && Equals(Data, Plaintext15, 64);
+	}
+
+	/** Selects the implementation and expands the key for it, without checking support */
+	void SetKeyInternal(const uint8* Key, bool bWithAESNI)
+	{
+		bUseAESNI = bWithAESNI;
+		if (bUseAESNI)
+		{
+#if UE_AESGCM_BATCH_WITH_AESNI
+			SetKeyAESNI(Key);
+#endif
+		}
+		else
+		{
+			SetKeyPortable(Key);
+		}
+		bHasKey = true;
+	}
+
+	void SetKeyPortable(const uint8* Key)
+	{
+		using namespace UE::Handler::AESGCM::Private;
+
+		PortableAES.SetKey(Key);
+
+		// Hash subkey H = E(K, 0^128)
+		uint8 Blocks[4][16] = {};
+		PortableAES.EncryptBlocks4(Blocks);
+		PortableHashKey[0] = LoadBigEndian64(Blocks[0]);
+		PortableHashKey[1] = LoadBigEndian64(Blocks[0] + 8);
+		FMemory::Memzero(Blocks);
+	}
+
+	void EncryptPacketsPortable(TArrayView<const FAESGCMPacketRef> Packets) const
+	{
+		for (const FAESGCMPacketRef& Packet : Packets)
+		{
+			ApplyKeyStreamPortable(Packet.IV, Packet.Data, Packet.Count);
+			WriteTagPortable(Packet.IV, Packet.Data, Packet.Count, Packet.Tag);
+		}
+	}
+
+	void DecryptPacketsPortable(TArrayView<const FAESGCMPacketRef> Packets, TArrayView<bool> OutSuccess) const
+	{
+		uint8 ExpectedTag[TagSizeInBytes];
+
+		for (int32 PacketIt = 0; PacketIt < Packets.Num(); ++PacketIt)
+		{
+			const FAESGCMPacketRef& Packet = Packets[PacketIt];
+
+			// The tag covers the ciphertext, so it's checked before anything is decrypted
+			WriteTagPortable(Packet.IV, Packet.Data, Packet.Count, ExpectedTag);
+
+			uint8 Difference = 0;
+			for (int32 ByteIt = 0; ByteIt < TagSizeInBytes; ++ByteIt)
+			{
+				Difference |= ExpectedTag[ByteIt] ^ Packet.Tag[ByteIt];
+			}
+
+			OutSuccess[PacketIt] = (Difference == 0);
+			if (Difference == 0)
+			{
+				ApplyKeyStreamPortable(Packet.IV, Packet.Data, Packet.Count);
+			}
+		}
+	}
+
+	/** Fills Blocks with the counter blocks IV || Counter to IV || Counter + 3 and encrypts them */
+	void EncryptCounterBlocksPortable(const uint8* IV, uint32 Counter, uint8 (&Blocks)[4][16]) const
+	{
+		for (int32 BlockIt = 0; BlockIt < 4; ++BlockIt)
+		{
+			FMemory::Memcpy(Blocks[BlockIt], IV, IVSizeInBytes);
+			UE::Handler::AESGCM::Private::StoreBigEndian32(Blocks[BlockIt] + IVSizeInBytes, Counter + BlockIt);
+		}
+		PortableAES.EncryptBlocks4(Blocks);
+	}
+
+	/** XORs Data with the CTR key stream, starting at counter 2 */
+	void ApplyKeyStreamPortable(const uint8* IV, uint8* Data, int32 Count) const
+	{
+		uint8 KeyStream[4][16];
+		uint32 Counter = 2;
+		for (int32 Offset = 0; Offset < Count; Offset += 4*BlockSizeInBytes, Counter += 4)
+		{
+			EncryptCounterBlocksPortable(IV, Counter, KeyStream);
+
+			const uint8* KeyStreamBytes = KeyStream[0];
+			const int32 ByteCount = (Count - Offset < 4*BlockSizeInBytes) ? Count - Offset : 4*BlockSizeInBytes;
+			for (int32 ByteIt = 0; ByteIt < ByteCount; ++ByteIt)
+			{
+				Data[Offset + ByteIt] ^= KeyStreamBytes[ByteIt];
+			}
+		}
+		FMemory::Memzero(KeyStream);
+	}
+
+	/** Tag = E(K, IV || 1) ^ GHASH(ciphertext, length block) */
+	void WriteTagPortable(const uint8* IV, const uint8* Data, int32 Count, uint8* OutTag) const
+	{
+		using namespace UE::Handler::AESGCM::Private;
+
+		uint64 Hash[2] = {};
+		int32 Offset = 0;
+		for (; Offset + BlockSizeInBytes <= Count; Offset += BlockSizeInBytes)
+		{
+			GHashMultiplyPortable(Hash, PortableHashKey, Data + Offset);
+		}
+
+		uint8 Block[16] = {};
+		if (Offset < Count)
+		{
+			FMemory::Memcpy(Block, Data + Offset, Count - Offset);
+			GHashMultiplyPortable(Hash, PortableHashKey, Block);
+		}
+
+		// len(A) || len(C) in bits
+		StoreBigEndian64(Block, 0);
+		StoreBigEndian64(Block + 8, uint64(Count)*8);
+		GHashMultiplyPortable(Hash, PortableHashKey, Block);
+
+		uint8 TagMask[4][16];
+		EncryptCounterBlocksPortable(IV, 1, TagMask);
+		StoreBigEndian64(OutTag, Hash[0]);
+		StoreBigEndian64(OutTag + 8, Hash[1]);
+		for (int32 ByteIt = 0; ByteIt < TagSizeInBytes; ++ByteIt)
+		{
+			OutTag[ByteIt] ^= TagMask[0][ByteIt];
+		}
+		FMemory::Memzero(TagMask);
+	}
+
+#if UE_AESGCM_BATCH_WITH_AESNI
+	struct FRoundKeyRegisters
+	{
+		__m128i Keys[15];
+	};
+
+	/** Checks for AES-NI, PCLMULQDQ, SSSE3 and SSE4.1 */
+	static bool HasRequiredCPUFeatures()
+	{
+		uint32 FeatureBits = 0;
+#if defined(_MSC_VER) && !defined(__clang__)
+		int32 Info[4];
+		__cpuid(Info, 1);
+		FeatureBits = uint32(Info[2]);
+#else
+		uint32 Eax, Ebx, Edx;
+		if (!__get_cpuid(1, &Eax, &Ebx, &FeatureBits, &Edx))
+		{
+			return false;
+		}
+#endif
+		constexpr uint32 PCLMULQDQBit = 1U << 1;
+		constexpr uint32 SSSE3Bit = 1U << 9;
+		constexpr uint32 SSE41Bit = 1U << 19;
+		constexpr uint32 AESNIBit = 1U << 25;
+		constexpr uint32 RequiredBits = PCLMULQDQBit | SSSE3Bit | SSE41Bit | AESNIBit;
+		return (FeatureBits & RequiredBits) == RequiredBits;
+	}
+
+	static UE_AESGCM_AESNI_FUNCTION FORCEINLINE __m128i ByteSwapMask()
+	{
+		return _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	}
+
+	/** Returns Key ^ (Key << 32) ^ (Key << 64) ^ (Key << 96), the running XOR of the previous round key's words */
+	static UE_AESGCM_AESNI_FUNCTION FORCEINLINE __m128i XorShiftedWords(__m128i Key)
+	{
+		Key = _mm_xor_si128(Key, _mm_slli_si128(Key, 4));
+		return _mm_xor_si128(Key, _mm_slli_si128(Key, 8));
+	}
+
+	/** Derives the next pair of AES-256 round keys, FIPS-197 section 5.2 */
+	template<int32 RoundConstant>
+	static UE_AESGCM_AESNI_FUNCTION FORCEINLINE void ExpandRoundKeyPair(__m128i (&Keys)[15], int32 Index)
+	{
+		Keys[Index] = _mm_xor_si128(XorShiftedWords(Keys[Index - 2]), _mm_shuffle_epi32(_mm_aeskeygenassist_si128(Keys[Index - 1], RoundConstant), 0xff));
+		if (Index + 1 < 15)
+		{
+			Keys[Index + 1] = _mm_xor_si128(XorShiftedWords(Keys[Index - 1]), _mm_shuffle_epi32(_mm_aeskeygenassist_si128(Keys[Index], 0x00), 0xaa));
+		}
+	}
+
+	/** Expands the key and derives the GHASH key powers */
+	UE_AESGCM_AESNI_FUNCTION void SetKeyAESNI(const uint8* Key)
+	{
+		__m128i Keys[15];
+		Keys[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Key));
+		Keys[1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Key + 16));
+		ExpandRoundKeyPair<0x01>(Keys, 2);
+		ExpandRoundKeyPair<0x02>(Keys, 4);
+		ExpandRoundKeyPair<0x04>(Keys, 6);
+		ExpandRoundKeyPair<0x08>(Keys, 8);
+		ExpandRoundKeyPair<0x10>(Keys, 10);
+		ExpandRoundKeyPair<0x20>(Keys, 12);
+		ExpandRoundKeyPair<0x40>(Keys, 14);
+
+		for (int32 Round = 0; Round < 15; ++Round)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(RoundKeys[Round]), Keys[Round]);
+		}
+
+		// Hash subkey H = E(K, 0^128)
+		FRoundKeyRegisters KeyRegisters;
+		LoadRoundKeys(KeyRegisters);
+		const __m128i H = _mm_shuffle_epi8(EncryptBlock(KeyRegisters, _mm_setzero_si128()), ByteSwapMask());
+		HashKeyPowers[0] = H;
+		for (int32 PowerIt = 1; PowerIt < 4; ++PowerIt)
+		{
+			HashKeyPowers[PowerIt] = GFMul(HashKeyPowers[PowerIt - 1], H);
+		}
+
+		FMemory::Memzero(Keys);
+		FMemory::Memzero(KeyRegisters);
+	}
+
+	UE_AESGCM_AESNI_FUNCTION void EncryptPacketsAESNI(TArrayView<const FAESGCMPacketRef> Packets) const
+	{
+		FRoundKeyRegisters Keys;
+		LoadRoundKeys(Keys);
+		for (const FAESGCMPacketRef& Packet : Packets)
+		{
+			const __m128i Counter0 = LoadCounterBase(Packet.IV);
+			ApplyKeyStream(Keys, Counter0, Packet.Data, Packet.Count);
+			WriteTag(Keys, Counter0, GHash(Packet.Data, Packet.Count), Packet.Tag);
+		}
+	}
+
+	UE_AESGCM_AESNI_FUNCTION void DecryptPacketsAESNI(TArrayView<const FAESGCMPacketRef> Packets, TArrayView<bool> OutSuccess) const
+	{
+		uint8 ExpectedTag[TagSizeInBytes];
+
+		FRoundKeyRegisters Keys;
+		LoadRoundKeys(Keys);
+
+		for (int32 PacketIt = 0; PacketIt < Packets.Num(); ++PacketIt)
+		{
+			const FAESGCMPacketRef& Packet = Packets[PacketIt];
+
+			// The tag covers the ciphertext, so it's checked before anything is decrypted
+			const __m128i Counter0 = LoadCounterBase(Packet.IV);
+			WriteTag(Keys, Counter0, GHash(Packet.Data, Packet.Count), ExpectedTag);
+
+			uint8 Difference = 0;
+			for (int32 ByteIt = 0; ByteIt < TagSizeInBytes; ++ByteIt)
+			{
+				Difference |= ExpectedTag[ByteIt] ^ Packet.Tag[ByteIt];
+			}
+
+			OutSuccess[PacketIt] = (Difference == 0);
+			if (Difference == 0)
+			{
+				ApplyKeyStream(Keys, Counter0, Packet.Data, Packet.Count);
+			}
+		}
+	}
+
+	UE_AESGCM_AESNI_FUNCTION FORCEINLINE void LoadRoundKeys(FRoundKeyRegisters& Out) const
+	{
+		for (int32 Round = 0; Round < 15; ++Round)
+		{
+			Out.Keys[Round] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(RoundKeys[Round]));
+		}
+	}
+
+	/** Returns the counter block IV || 0^32, the 32 bit counter is inserted per block */
+	static UE_AESGCM_AESNI_FUNCTION FORCEINLINE __m128i LoadCounterBase(const uint8* IV)
+	{
+		uint8 Block[16] = {};
+		FMemory::Memcpy(Block, IV, IVSizeInBytes);
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block));
+	}
+
+	static UE_AESGCM_AESNI_FUNCTION FORCEINLINE __m128i MakeCounterBlock(__m128i Counter0, uint32 Counter)
+	{
+		return _mm_insert_epi32(Counter0, int32(BYTESWAP_ORDER32(Counter)), 3);
+	}
+
+	static UE_AESGCM_AESNI_FUNCTION FORCEINLINE __m128i EncryptBlock(const FRoundKeyRegisters& Keys, __m128i Block)
+	{
+		Block = _mm_xor_si128(Block, Keys.Keys[0]);
+		for (int32 Round = 1; Round < 14; ++Round)
+		{
+			Block = _mm_aesenc_si128(Block, Keys.Keys[Round]);
+		}
+		return _mm_aesenclast_si128(Block, Keys.Keys[14]);
+	}
+
+	static UE_AESGCM_AESNI_FUNCTION FORCEINLINE void EncryptBlocks4(const FRoundKeyRegisters& Keys, __m128i& B0, __m128i& B1, __m128i& B2, __m128i& B3)
+	{
+		B0 = _mm_xor_si128(B0, Keys.Keys[0]);
+		B1 = _mm_xor_si128(B1, Keys.Keys[0]);
+		B2 = _mm_xor_si128(B2, Keys.Keys[0]);
+		B3 = _mm_xor_si128(B3, Keys.Keys[0]);
+		for (int32 Round = 1; Round < 14; ++Round)
+		{
+			B0 = _mm_aesenc_si128(B0, Keys.Keys[Round]);
+			B1 = _mm_aesenc_si128(B1, Keys.Keys[Round]);
+			B2 = _mm_aesenc_si128(B2, Keys.Keys[Round]);
+			B3 = _mm_aesenc_si128(B3, Keys.Keys[Round]);
+		}
+		B0 = _mm_aesenclast_si128(B0, Keys.Keys[14]);
+		B1 = _mm_aesenclast_si128(B1, Keys.Keys[14]);
+		B2 = _mm_aesenclast_si128(B2, Keys.Keys[14]);
+		B3 = _mm_aesenclast_si128(B3, Keys.Keys[14]);
+	}
+
+	/** XORs Data with the CTR key stream, starting at counter 2 */
+	static UE_AESGCM_AESNI_FUNCTION void ApplyKeyStream(const FRoundKeyRegisters& Keys, __m128i Counter0, uint8* Data, int32 Count)
+	{
+		uint32 Counter = 2;
+		int32 Offset = 0;
+		for (; Offset + 4*BlockSizeInBytes <= Count; Offset += 4*BlockSizeInBytes, Counter += 4)
+		{
+			__m128i B0 = MakeCounterBlock(Counter0, Counter);
+			__m128i B1 = MakeCounterBlock(Counter0, Counter + 1);
+			__m128i B2 = MakeCounterBlock(Counter0, Counter + 2);
+			__m128i B3 = MakeCounterBlock(Counter0, Counter + 3);
+			EncryptBlocks4(Keys, B0, B1, B2, B3);
+
+			__m128i* Blocks = reinterpret_cast<__m128i*>(Data + Offset);
+			_mm_storeu_si128(Blocks + 0, _mm_xor_si128(_mm_loadu_si128(Blocks + 0), B0));
+			_mm_storeu_si128(Blocks + 1, _mm_xor_si128(_mm_loadu_si128(Blocks + 1), B1));
+			_mm_storeu_si128(Blocks + 2, _mm_xor_si128(_mm_loadu_si128(Blocks + 2), B2));
+			_mm_storeu_si128(Blocks + 3, _mm_xor_si128(_mm_loadu_si128(Blocks + 3), B3));
+		}
+
+		for (; Offset + BlockSizeInBytes <= Count; Offset += BlockSizeInBytes, ++Counter)
+		{
+			__m128i* Block = reinterpret_cast<__m128i*>(Data + Offset);
+			_mm_storeu_si128(Block, _mm_xor_si128(_mm_loadu_si128(Block), EncryptBlock(Keys, MakeCounterBlock(Counter0, Counter))));
+		}
+
+		if (Offset < Count)
+		{
+			alignas(16) uint8 KeyStream[16];
+			_mm_store_si128(reinterpret_cast<__m128i*>(KeyStream), EncryptBlock(Keys, MakeCounterBlock(Counter0, Counter)));
+			for (int32 ByteIt = 0; Offset + ByteIt < Count; ++ByteIt)
+			{
+				Data[Offset + ByteIt] ^= KeyStream[ByteIt];
+			}
+		}
+	}
+
+	/** Carry-less multiplication of two byte swapped field elements, returning the unreduced 256 bit product */
+	static UE_AESGCM_AESNI_FUNCTION FORCEINLINE void GFMulUnreduced(__m128i A, __m128i B, __m128i& OutLow, __m128i& OutHigh)
+	{
+		__m128i Low = _mm_clmulepi64_si128(A, B, 0x00);
+		__m128i Middle = _mm_xor_si128(_mm_clmulepi64_si128(A, B, 0x10), _mm_clmulepi64_si128(A, B, 0x01));
+		__m128i High = _mm_clmulepi64_si128(A, B, 0x11);
+		OutLow = _mm_xor_si128(Low, _mm_slli_si128(Middle, 8));
+		OutHigh = _mm_xor_si128(High, _mm_srli_si128(Middle, 8));
+	}
+
+	/** Reduces a 256 bit product modulo the GCM polynomial. Linear, so several products can be summed before reducing once. */
+	static UE_AESGCM_AESNI_FUNCTION FORCEINLINE __m128i GFReduce(__m128i Low, __m128i High)
+	{
+		// Shift the product left by one bit to account for the reflected bit order
+		__m128i LowCarry = _mm_srli_epi32(Low, 31);
+		__m128i HighCarry = _mm_srli_epi32(High, 31);
+		Low = _mm_slli_epi32(Low, 1);
+		High = _mm_slli_epi32(High, 1);
+		const __m128i CrossCarry = _mm_srli_si128(LowCarry, 12);
+		HighCarry = _mm_slli_si128(HighCarry, 4);
+		LowCarry = _mm_slli_si128(LowCarry, 4);
+		Low = _mm_or_si128(Low, LowCarry);
+		High = _mm_or_si128(_mm_or_si128(High, HighCarry), CrossCarry);
+
+		// Reduce modulo x^128 + x^7 + x^2 + x + 1
+		__m128i Fold = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(Low, 31), _mm_slli_epi32(Low, 30)), _mm_slli_epi32(Low, 25));
+		const __m128i FoldHigh = _mm_srli_si128(Fold, 4);
+		Fold = _mm_slli_si128(Fold, 12);
+		Low = _mm_xor_si128(Low, Fold);
+
+		__m128i Shifted = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(Low, 1), _mm_srli_epi32(Low, 2)), _mm_srli_epi32(Low, 7));
+		Shifted = _mm_xor_si128(Shifted, FoldHigh);
+		Low = _mm_xor_si128(Low, Shifted);
+		return _mm_xor_si128(High, Low);
+	}
+
+	static UE_AESGCM_AESNI_FUNCTION FORCEINLINE __m128i GFMul(__m128i A, __m128i B)
+	{
+		__m128i Low, High;
+		GFMulUnreduced(A, B, Low, High);
+		return GFReduce(Low, High);
+	}
+
+	/** GHASH over the ciphertext and the length block, returned byte swapped */
+	UE_AESGCM_AESNI_FUNCTION __m128i GHash(const uint8* Data, int32 Count) const
+	{
+		const __m128i Mask = ByteSwapMask();
+		__m128i Hash = _mm_setzero_si128();
+
+		int32 Offset = 0;
+		for (; Offset + 4*BlockSizeInBytes <= Count; Offset += 4*BlockSizeInBytes)
+		{
+			// Hash = (Hash ^ C0)*H^4 ^ C1*H^3 ^ C2*H^2 ^ C3*H, with a single reduction
+			const __m128i* Blocks = reinterpret_cast<const __m128i*>(Data + Offset);
+			__m128i Low, High, TermLow, TermHigh;
+			GFMulUnreduced(_mm_xor_si128(Hash, _mm_shuffle_epi8(_mm_loadu_si128(Blocks + 0), Mask)), HashKeyPowers[3], Low, High);
+			GFMulUnreduced(_mm_shuffle_epi8(_mm_loadu_si128(Blocks + 1), Mask), HashKeyPowers[2], TermLow, TermHigh);
+			Low = _mm_xor_si128(Low, TermLow);
+			High = _mm_xor_si128(High, TermHigh);
+			GFMulUnreduced(_mm_shuffle_epi8(_mm_loadu_si128(Blocks + 2), Mask), HashKeyPowers[1], TermLow, TermHigh);
+			Low = _mm_xor_si128(Low, TermLow);
+			High = _mm_xor_si128(High, TermHigh);
+			GFMulUnreduced(_mm_shuffle_epi8(_mm_loadu_si128(Blocks + 3), Mask), HashKeyPowers[0], TermLow, TermHigh);
+			Low = _mm_xor_si128(Low, TermLow);
+			High = _mm_xor_si128(High, TermHigh);
+			Hash = GFReduce(Low, High);
+		}
+
+		for (; Offset < Count; Offset += BlockSizeInBytes)
+		{
+			__m128i Block;
+			if (Offset + BlockSizeInBytes <= Count)
+			{
+				Block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + Offset));
+			}
+			else
+			{
+				uint8 Padded[16] = {};
+				FMemory::Memcpy(Padded, Data + Offset, Count - Offset);
+				Block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Padded));
+			}
+			Hash = GFMul(_mm_xor_si128(Hash, _mm_shuffle_epi8(Block, Mask)), HashKeyPowers[0]);
+		}
+
+		// len(A) || len(C) in bits, byte swapped
+		const __m128i LengthBlock = _mm_set_epi64x(0, int64(Count)*8);
+		return GFMul(_mm_xor_si128(Hash, LengthBlock), HashKeyPowers[0]);
+	}
+
+	/** Tag = E(K, IV || 1) ^ GHASH */
+	static UE_AESGCM_AESNI_FUNCTION void WriteTag(const FRoundKeyRegisters& Keys, __m128i Counter0, __m128i Hash, uint8* OutTag)
+	{
+		const __m128i TagMask = EncryptBlock(Keys, MakeCounterBlock(Counter0, 1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(OutTag), _mm_xor_si128(_mm_shuffle_epi8(Hash, ByteSwapMask()), TagMask));
+	}
+
+	/** Expanded AES-256 key, 15 round keys */
+	uint8 RoundKeys[15][16];
+
+	/** H, H^2, H^3 and H^4, byte swapped, for aggregated GHASH */
+	__m128i HashKeyPowers[4];
+#endif
+
+	/** Bitsliced key schedule for CPUs without AES-NI */
+	UE::Handler::AESGCM::Private::FBitslicedAES256 PortableAES;
+
+	/** H as two big endian halves, for the bitsliced implementation */
+	uint64 PortableHashKey[2];
+
+	bool bUseAESNI = false;
+	bool bHasKey = false;
+};
@@ -0,0 +1,273 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "AESGCMBatchCipher.h"
+#include "EncryptionComponent.h"
+#include "Math/UnrealMathUtility.h"
+
+/**
+ * AES-256-GCM packet encryption, built for servers with many connections.
+ *
+ * The key schedule is expanded once in SetEncryptionData, packets are encrypted in place in the outgoing FBitWriter and decrypted
+ * into a scratch reader owned by the component, so nothing is allocated per packet once the scratch buffers have grown.
+ * Net drivers that collect a connection's outgoing packets for the tick can pass them to EncryptBatch, which runs all of them
+ * through the cipher in one go.
+ *
+ * Packet layout: ciphertext (payload, termination bit, zero padding to a byte), 96 bit IV, 128 bit tag.
+ * The IV is the sending side (client or server), a per key random salt and a per packet counter, so the two directions
+ * never share an IV. The salt comes from the operating system's secure random number generator.
+ *
+ * Uses AES-NI and PCLMULQDQ where available and a constant time bitsliced implementation elsewhere (see FAESGCMBatchCipher).
+ * Keys are only refused if the cipher fails its known answer tests.
+ */
+class FAESGCMBatchHandlerComponent : public FEncryptionComponent
+{
+public:
+	FAESGCMBatchHandlerComponent()
+		: FEncryptionComponent(FName(TEXT("AESGCMBatchHandlerComponent")))
+	{
+	}
+
+	virtual void SetEncryptionData(const FEncryptionData& EncryptionData) override
+	{
+		if (!FAESGCMBatchCipher::IsSupported())
+		{
+			Cipher.Reset();
+			UE_LOG(PacketHandlerLog, Error, TEXT("FAESGCMBatchHandlerComponent::SetEncryptionData. AES-GCM failed its known answer tests, ignoring key."));
+			return;
+		}
+
+		if (!Cipher.SetKey(EncryptionData.Key))
+		{
+			UE_LOG(PacketHandlerLog, Log, TEXT("FAESGCMBatchHandlerComponent::SetEncryptionData. NewKey is not %d bytes long, ignoring."), FAESGCMBatchCipher::KeySizeInBytes);
+			return;
+		}
+
+		if (!RegenerateIVSalt())
+		{
+			Cipher.Reset();
+			UE_LOG(PacketHandlerLog, Error, TEXT("FAESGCMBatchHandlerComponent::SetEncryptionData. Failed to generate a random IV salt, ignoring key."));
+		}
+	}
+
+	virtual void EnableEncryption() override
+	{
+		if (!Cipher.HasKey())
+		{
+			UE_LOG(PacketHandlerLog, Warning, TEXT("FAESGCMBatchHandlerComponent::EnableEncryption. No valid key has been set, encryption not enabled."));
+			return;
+		}
+
+		bEncryptionEnabled = true;
+	}
+
+	virtual void DisableEncryption() override
+	{
+		bEncryptionEnabled = false;
+	}
+
+	virtual bool IsEncryptionEnabled() const override
+	{
+		return bEncryptionEnabled;
+	}
+
+	virtual void Initialize() override
+	{
+		SetActive(true);
+		SetState(UE::Handler::Component::State::Initialized);
+		Initialized();
+	}
+
+	virtual bool IsValid() const override
+	{
+		return true;
+	}
+
+	virtual void Incoming(FIncomingPacketRef PacketRef) override
+	{
+		FBitReader& Packet = PacketRef.Packet;
+		if (!bEncryptionEnabled || Packet.IsError())
+		{
+			return;
+		}
+
+		const int64 PacketBits = Packet.GetBitsLeft();
+		if (PacketBits == 0)
+		{
+			return;
+		}
+
+		constexpr int32 FooterBytes = FAESGCMBatchCipher::IVSizeInBytes + FAESGCMBatchCipher::TagSizeInBytes;
+		if ((PacketBits % 8) != 0 || (PacketBits / 8) <= FooterBytes)
+		{
+			UE_LOG(PacketHandlerLog, Log, TEXT("FAESGCMBatchHandlerComponent::Incoming: Malformed packet of %lld bits."), PacketBits);
+			Packet.SetError();
+			return;
+		}
+
+		// ResetData reuses the scratch allocation, and the cipher only touches the packet if the tag matches
+		DecryptScratch.ResetData(Packet, PacketBits);
+		uint8* Data = DecryptScratch.GetData();
+		const int32 PayloadBytes = static_cast<int32>(PacketBits / 8) - FooterBytes;
+		const FAESGCMPacketRef DecryptRef{Data, PayloadBytes, Data + PayloadBytes, Data + PayloadBytes + FAESGCMBatchCipher::IVSizeInBytes};
+
+		const uint8 LastByte = Cipher.Decrypt(DecryptRef) ? Data[PayloadBytes - 1] : 0;
+		if (LastByte == 0)
+		{
+			UE_LOG(PacketHandlerLog, Log, TEXT("FAESGCMBatchHandlerComponent::Incoming: Failed to authenticate or decrypt packet."));
+			Packet.SetError();
+			return;
+		}
+
+		// Strip the termination bit and padding
+		const int64 PayloadBits = int64(PayloadBytes - 1)*8 + FMath::FloorLog2(LastByte);
+		Packet.ResetData(DecryptScratch, PayloadBits);
+	}
+
+	virtual void Outgoing(FBitWriter& Packet, FOutPacketTraits& Traits) override
+	{
+		if (bEncryptionEnabled)
+		{
+			FBitWriter* Packets[] = { &Packet };
+			EncryptBatch(Packets);
+		}
+	}
+
+	virtual void IncomingConnectionless(FIncomingPacketRef PacketRef) override
+	{
+	}
+
+	virtual void OutgoingConnectionless(const TSharedPtr<const FInternetAddr>& Address, FBitWriter& Packet, FOutPacketTraits& Traits) override
+	{
+	}
+
+	/**
+	 * Frames and encrypts several outgoing packets of this connection with a single pass through the cipher.
+	 * Produces exactly what calling Outgoing for each packet in turn would. Empty and overflowed packets are left untouched.
+	 */
+	void EncryptBatch(TArrayView<FBitWriter* const> Packets)
+	{
+		if (!bEncryptionEnabled)
+		{
+			return;
+		}
+
+		BatchPacketRefs.Reset();
+		for (FBitWriter* Packet : Packets)
+		{
+			if (Packet->GetNumBits() == 0 || Packet->IsError())
+			{
+				continue;
+			}
+
+			// Termination bit, so the receiver can recover the exact bit count
+			Packet->WriteBit(1);
+			Packet->WriteAlign();
+			const int32 PayloadBytes = static_cast<int32>(Packet->GetNumBytes());
+
+			uint8 IV[FAESGCMBatchCipher::IVSizeInBytes];
+			if (!MakeNextIV(IV))
+			{
+				UE_LOG(PacketHandlerLog, Error, TEXT("FAESGCMBatchHandlerComponent::EncryptBatch: Failed to generate a new IV salt, dropping packet."));
+				Packet->SetError();
+				continue;
+			}
+
+			uint8 TagPlaceholder[FAESGCMBatchCipher::TagSizeInBytes] = {};
+			Packet->Serialize(IV, FAESGCMBatchCipher::IVSizeInBytes);
+			Packet->Serialize(TagPlaceholder, FAESGCMBatchCipher::TagSizeInBytes);
+
+			if (Packet->IsError())
+			{
+				UE_LOG(PacketHandlerLog, Error, TEXT("FAESGCMBatchHandlerComponent::EncryptBatch: Packet overflowed when adding the IV and tag."));
+				continue;
+			}
+
+			uint8* Data = Packet->GetData();
+			BatchPacketRefs.Add(FAESGCMPacketRef{Data, PayloadBytes, Data + PayloadBytes, Data + PayloadBytes + FAESGCMBatchCipher::IVSizeInBytes});
+		}
+
+		Cipher.EncryptPackets(BatchPacketRefs);
+	}
+
+	virtual int32 GetReservedPacketBits() const override
+	{
+		// IV and tag, plus the termination bit and up to 7 bits of padding
+		return (FAESGCMBatchCipher::IVSizeInBytes + FAESGCMBatchCipher::TagSizeInBytes)*8 + 8;
+	}
+
+	virtual void CountBytes(FArchive& Ar) const override
+	{
+		FEncryptionComponent::CountBytes(Ar);
+
+		const SIZE_T SizeOfThis = sizeof(*this) - sizeof(FEncryptionComponent);
+		Ar.CountBytes(SizeOfThis, SizeOfThis);
+
+		BatchPacketRefs.CountBytes(Ar);
+	}
+
+private:
+	bool RegenerateIVSalt()
+	{
+		if (!UE::Handler::AESGCM::Private::GetSecureRandomBytes(IVSalt))
+		{
+			return false;
+		}
+
+		IVCounter = 0;
+		return true;
+	}
+
+	/**
+	 * IV = sender (1 byte), salt (7 bytes), big endian counter (4 bytes)
+	 *
+	 * @return	False if the counter ran out and no new salt could be generated, in which case the packet must not be sent
+	 */
+	bool MakeNextIV(uint8 (&OutIV)[FAESGCMBatchCipher::IVSizeInBytes])
+	{
+		// An IV must never repeat, so the salt is replaced before the counter wraps around
+		if (IVCounter == MAX_uint32 && !RegenerateIVSalt())
+		{
+			return false;
+		}
+
+		++IVCounter;
+		OutIV[0] = (Handler != nullptr && Handler->Mode == UE::Handler::Mode::Server) ? 1 : 0;
+		FMemory::Memcpy(OutIV + 1, IVSalt, sizeof(IVSalt));
+		OutIV[8] = uint8(IVCounter >> 24);
+		OutIV[9] = uint8(IVCounter >> 16);
+		OutIV[10] = uint8(IVCounter >> 8);
+		OutIV[11] = uint8(IVCounter);
+		return true;
+	}
+
+	/** Expanded key, shared by all packets of the connection */
+	FAESGCMBatchCipher Cipher;
+
+	/** Receives the incoming packet so that it can be decrypted in place */
+	FBitReader DecryptScratch;
+
+	/** Packets passed to the cipher by EncryptBatch, kept to reuse the allocation */
+	TArray<FAESGCMPacketRef> BatchPacketRefs;
+
+	/** Random part of the IV, regenerated with every key */
+	uint8 IVSalt[7] = {};
+
+	/** Number of packets sent with the current salt */
+	uint32 IVCounter = 0;
+
+	bool bEncryptionEnabled = false;
+};
+
+/**
+ * The public interface to this module
+ */
+class FAESGCMBatchHandlerComponentModuleInterface : public FPacketHandlerComponentModuleInterface
+{
+public:
+	virtual TSharedPtr<HandlerComponent> CreateComponentInstance(FString& Options) override
+	{
+		return MakeShared<FAESGCMBatchHandlerComponent>();
+	}
+};
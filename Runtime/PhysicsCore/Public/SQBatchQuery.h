@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Algo/Sort.h"
+#include "Chaos/Framework/Parallel.h"
+#include "Chaos/Sphere.h"
+#include "SQVisitor.h"
+
+namespace ChaosInterface
+{
+	/**
+	 * The blocking hit of every query in a batch, in structure-of-arrays form and in the order the queries were given.
+	 * Entries for queries without a blocking hit are left at their defaults (no actor, INDEX_NONE face).
+	 */
+	template <typename THitType>
+	struct TSQBatchHits
+	{
+		using FActorType = decltype(THitType::Actor);
+
+		int32 Num() const { return bHasBlockingHit.Num(); }
+
+		void SetNum(const int32 NumQueries)
+		{
+			bHasBlockingHit.Reset();
+			bHasBlockingHit.SetNumZeroed(NumQueries);
+			Distances.Reset();
+			Distances.SetNumZeroed(NumQueries);
+			Positions.Reset();
+			Positions.SetNumZeroed(NumQueries);
+			Normals.Reset();
+			Normals.SetNumZeroed(NumQueries);
+			FaceIndices.Reset();
+			FaceIndices.Init(INDEX_NONE, NumQueries);
+			Actors.Reset();
+			Actors.SetNumZeroed(NumQueries);
+			Shapes.Reset();
+			Shapes.SetNumZeroed(NumQueries);
+		}
+
+		/** Copy the blocking hit of HitBuffer, if any. Safe to call concurrently for different query indices. */
+		void SetFromHitBuffer(const int32 QueryIndex, const FSQHitBuffer<THitType>& HitBuffer)
+		{
+			if (const THitType* Hit = HitBuffer.GetBlock())
+			{
+				bHasBlockingHit[QueryIndex] = true;
+				Distances[QueryIndex] = Hit->Distance;
+				Positions[QueryIndex] = Hit->WorldPosition;
+				Normals[QueryIndex] = Hit->WorldNormal;
+				FaceIndices[QueryIndex] = Hit->FaceIndex;
+				Actors[QueryIndex] = Hit->Actor;
+				Shapes[QueryIndex] = Hit->Shape;
+			}
+		}
+
+		// bool rather than a bit array so that workers can write neighbouring entries concurrently
+		TArray<bool> bHasBlockingHit;
+		TArray<float> Distances;
+		TArray<FVector> Positions;
+		TArray<FVector> Normals;
+		TArray<int32> FaceIndices;
+		TArray<FActorType> Actors;
+		TArray<const Chaos::FPerShapeData*> Shapes;
+	};
+
+	namespace Private
+	{
+		// Spread the low 10 bits of X so that there are two zero bits between each of them
+		inline uint32 SpreadMortonBits(uint32 X)
+		{
+			X &= 0x3FF;
+			X = (X | (X << 16)) & 0x030000FF;
+			X = (X | (X << 8)) & 0x0300F00F;
+			X = (X | (X << 4)) & 0x030C30C3;
+			X = (X | (X << 2)) & 0x09249249;
+			return X;
+		}
+	}
+
+	/**
+	 * Order the queries along a Morton curve through the midpoints of their segments, so that consecutive queries (and
+	 * so the queries handled by one worker) touch the same parts of the acceleration structure.
+	 */
+	inline void SortQueriesByLocality(TConstArrayView<FVector> Starts, TConstArrayView<FVector> Dirs, TConstArrayView<float> DeltaMagnitudes, TArray<int32>& OutOrder)
+	{
+		const int32 NumQueries = Starts.Num();
+		TArray<FVector> Midpoints;
+		Midpoints.SetNumUninitialized(NumQueries);
+		FBox Bounds(ForceInit);
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			Midpoints[QueryIndex] = Starts[QueryIndex] + Dirs[QueryIndex] * (0.5 * DeltaMagnitudes[QueryIndex]);
+			Bounds += Midpoints[QueryIndex];
+		}
+
+		const FVector Scale = FVector(1023.0) / Bounds.GetSize().ComponentMax(FVector(UE_SMALL_NUMBER));
+		TArray<TPair<uint32, int32>> Keys;
+		Keys.SetNumUninitialized(NumQueries);
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			const FVector Cell = (Midpoints[QueryIndex] - Bounds.Min) * Scale;
+			const uint32 Code = Private::SpreadMortonBits(uint32(Cell.X)) | (Private::SpreadMortonBits(uint32(Cell.Y)) << 1) | (Private::SpreadMortonBits(uint32(Cell.Z)) << 2);
+			Keys[QueryIndex] = TPair<uint32, int32>(Code, QueryIndex);
+		}
+		Algo::Sort(Keys);
+
+		OutOrder.SetNumUninitialized(NumQueries);
+		for (int32 OrderIndex = 0; OrderIndex < NumQueries; ++OrderIndex)
+		{
+			OutOrder[OrderIndex] = Keys[OrderIndex].Value;
+		}
+	}
+
+	/** Number of consecutive (locality sorted) queries handled by one worker task in the batch helpers */
+	inline constexpr int32 SQBatchQueriesPerTask = 32;
+}
+
+/**
+ * Run a batch of single-hit raycasts against one acceleration structure and write the blocking hits to OutHits.
+ *
+ * The queries are sorted by spatial locality and split across workers in runs of consecutive queries, so each worker
+ * keeps revisiting the same tree nodes and leaves. Each query uses the same visitor and filtering as a single raycast.
+ * QueryCallback is shared by all queries and must be safe to call from several threads unless bAllowParallel is false.
+ */
+template <typename TRaycastHit, typename TPayload>
+void RaycastBatchHelper(const Chaos::ISpatialAcceleration<TPayload, Chaos::FReal, 3>& SpatialAcceleration, TConstArrayView<FVector> Starts, TConstArrayView<FVector> Dirs, TConstArrayView<float> DeltaMagnitudes, ChaosInterface::TSQBatchHits<TRaycastHit>& OutHits, EHitFlags OutputFlags, const ChaosInterface::FQueryFilterData& QueryFilterData, ICollisionQueryFilterCallbackBase& QueryCallback, const bool bAllowParallel = true)
+{
+	using namespace Chaos;
+	using namespace ChaosInterface;
+
+	check((Starts.Num() == Dirs.Num()) && (Starts.Num() == DeltaMagnitudes.Num()));
+
+	TArray<int32> Order;
+	SortQueriesByLocality(Starts, Dirs, DeltaMagnitudes, Order);
+	OutHits.SetNum(Starts.Num());
+
+	constexpr bool bGTData = std::is_same<TRaycastHit, FRaycastHit>::value;
+	PhysicsParallelForRange(Order.Num(), [&](const int32 BeginIndex, const int32 EndIndex)
+	{
+		for (int32 OrderIndex = BeginIndex; OrderIndex < EndIndex; ++OrderIndex)
+		{
+			const int32 QueryIndex = Order[OrderIndex];
+			FSQSingleHitBuffer<TRaycastHit> HitBuffer;
+			TSQVisitor<TSphere<FReal, 3>, TPayload, TRaycastHit, bGTData> RaycastVisitor(Starts[QueryIndex], Dirs[QueryIndex], HitBuffer, OutputFlags, QueryFilterData, QueryCallback, FQueryDebugParams());
+
+			HitBuffer.IncFlushCount();
+			SpatialAcceleration.Raycast(Starts[QueryIndex], Dirs[QueryIndex], DeltaMagnitudes[QueryIndex], RaycastVisitor);
+			HitBuffer.DecFlushCount();
+
+			OutHits.SetFromHitBuffer(QueryIndex, HitBuffer);
+		}
+	}, SQBatchQueriesPerTask, !bAllowParallel);
+}
+
+/**
+ * Run a batch of single-hit sweeps of the same query geometry against one acceleration structure and write the
+ * blocking hits to OutHits. Scheduling and threading requirements are the same as RaycastBatchHelper.
+ */
+template <typename QueryGeomType, typename TSweepHit, typename TPayload>
+void SweepBatchHelper(const QueryGeomType& QueryGeom, const Chaos::ISpatialAcceleration<TPayload, Chaos::FReal, 3>& SpatialAcceleration, TConstArrayView<FTransform> StartTMs, TConstArrayView<FVector> Dirs, TConstArrayView<float> DeltaMagnitudes, ChaosInterface::TSQBatchHits<TSweepHit>& OutHits, EHitFlags OutputFlags, const ChaosInterface::FQueryFilterData& QueryFilterData, ICollisionQueryFilterCallbackBase& QueryCallback, const bool bAllowParallel = true)
+{
+	using namespace Chaos;
+	using namespace ChaosInterface;
+
+	check((StartTMs.Num() == Dirs.Num()) && (StartTMs.Num() == DeltaMagnitudes.Num()));
+
+	TArray<FVector> Starts;
+	Starts.SetNumUninitialized(StartTMs.Num());
+	for (int32 QueryIndex = 0; QueryIndex < StartTMs.Num(); ++QueryIndex)
+	{
+		Starts[QueryIndex] = StartTMs[QueryIndex].GetLocation();
+	}
+
+	TArray<int32> Order;
+	SortQueriesByLocality(Starts, Dirs, DeltaMagnitudes, Order);
+	OutHits.SetNum(StartTMs.Num());
+
+	PhysicsParallelForRange(Order.Num(), [&](const int32 BeginIndex, const int32 EndIndex)
+	{
+		for (int32 OrderIndex = BeginIndex; OrderIndex < EndIndex; ++OrderIndex)
+		{
+			const int32 QueryIndex = Order[OrderIndex];
+			FSQSingleHitBuffer<TSweepHit> HitBuffer;
+			SweepHelper(QueryGeom, SpatialAcceleration, StartTMs[QueryIndex], Dirs[QueryIndex], DeltaMagnitudes[QueryIndex], HitBuffer, OutputFlags, QueryFilterData, QueryCallback, FQueryDebugParams());
+			OutHits.SetFromHitBuffer(QueryIndex, HitBuffer);
+		}
+	}, SQBatchQueriesPerTask, !bAllowParallel);
+}
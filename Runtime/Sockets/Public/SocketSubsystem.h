@@ -349,6 +349,20 @@ public:
 	SOCKETS_API virtual TUniquePtr<FRecvMulti> CreateRecvMulti(int32 MaxNumPackets, int32 MaxPacketSize,
 													ERecvMultiFlags Flags=ERecvMultiFlags::None);
 
+	/**
+	 * Create a platform specific FSendMulti representation
+	 * Experimental: no platform has a batched implementation yet. @see FSendMulti
+	 *
+	 * @param MaxNumPackets			The maximum number of packets that can be queued per send
+	 * @param Flags					Flags for specifying how FSendMulti should be initialized
+	 * @return						Returns the platform specific FSendMulti instance
+	 */
+	virtual TUniquePtr<FSendMulti> CreateSendMulti(int32 MaxNumPackets, ESendMultiFlags Flags=ESendMultiFlags::None)
+	{
+		// If not implemented, returns the base version, which FSocket::SendMulti sends one packet at a time
+		return MakeUnique<FSendMulti>(MaxNumPackets, Flags);
+	}
+
 	/**
 	 * @return Whether the machine has a properly configured network device or not
 	 */
@@ -474,6 +488,15 @@ public:
 	 */
 	SOCKETS_API virtual bool IsSocketRecvMultiSupported() const;
 
+	/**
+	 * Returns true if FSocket::SendMulti has a batched implementation in this socket subsystem, rather than sending one packet per call
+	 * Experimental: currently false on all platforms. @see FSendMulti
+	 */
+	virtual bool IsSocketSendMultiSupported() const
+	{
+		return false;
+	}
+
 
 	/**
 	 * Returns true if FSocket::Wait is supported by this socket subsystem.
@@ -264,3 +264,127 @@ public:
 	 */
 	SOCKETS_API virtual void CountBytes(FArchive& Ar) const;
 };
+
+
+/**
+ * Flags for specifying how an FSendMulti instance should be initialized
+ * Experimental: no flags are defined until a platform implements a batched send.
+ */
+enum class ESendMultiFlags : uint32
+{
+	None						= 0x00000000
+};
+
+ENUM_CLASS_FLAGS(ESendMultiFlags);
+
+
+/**
+ * Stores the packets to be sent with FSocket::SendMulti, and platform specific state for sending them in as few calls as possible.
+ * Packet data and destination addresses are referenced rather than copied, and must stay valid until SendMulti returns.
+ * To optimize performance, use only one instance of this struct, for the lifetime of the socket.
+ *
+ * Experimental: no socket subsystem provides a batched implementation yet, so SendMulti currently sends one packet per SendTo call.
+ * The interface may change once one does.
+ */
+struct FSendMulti : public FNoncopyable, public FVirtualDestructor
+{
+public:
+	/**
+	 * Send data for each individual packet
+	 */
+	struct FSendData
+	{
+		/** Pointer to the packet data */
+		const uint8*				Data = nullptr;
+
+		/** The size of the packet data */
+		int32						Count = 0;
+
+		/** The destination address for the packet */
+		const FInternetAddr*		Destination = nullptr;
+	};
+
+	/** The maximum number of packets this FSendMulti instance can support */
+	const int32						MaxNumPackets;
+
+	/** The flags this FSendMulti instance was initialized with */
+	const ESendMultiFlags			InitFlags;
+
+	/**
+	 * Initialize an FSendMulti instance. Use ISocketSubsystem::CreateSendMulti to get the platform specific version.
+	 *
+	 * @param InMaxNumPackets		The maximum number of packets that can be queued
+	 * @param InInitFlags			Flags for specifying how FSendMulti should be initialized
+	 */
+	FSendMulti(int32 InMaxNumPackets, ESendMultiFlags InInitFlags=ESendMultiFlags::None)
+		: MaxNumPackets(InMaxNumPackets)
+		, InitFlags(InInitFlags)
+	{
+		Packets.Reserve(InMaxNumPackets);
+	}
+
+	/**
+	 * Queues a packet for sending
+	 *
+	 * @return		False if the maximum number of packets is already queued, in which case SendMulti should be called first
+	 */
+	bool AddPacket(const uint8* Data, int32 Count, const FInternetAddr& Destination)
+	{
+		if (Packets.Num() >= MaxNumPackets)
+		{
+			return false;
+		}
+
+		Packets.Add({Data, Count, &Destination});
+		return true;
+	}
+
+	/** Retrieves the current number of queued packets */
+	int32 GetNumPackets() const
+	{
+		return Packets.Num();
+	}
+
+	/** Retrieves the information for the specified queued packet */
+	const FSendData& GetPacket(int32 PacketIdx) const
+	{
+		return Packets[PacketIdx];
+	}
+
+	/** Retrieves the number of queued packets that the last SendMulti call sent, in queue order */
+	int32 GetNumPacketsSent() const
+	{
+		return NumPacketsSent;
+	}
+
+	/** Records the number of queued packets that were sent. Used by FSocket::SendMulti implementations */
+	void SetNumPacketsSent(int32 InNumPacketsSent)
+	{
+		NumPacketsSent = InNumPacketsSent;
+	}
+
+	/** Removes all queued packets, keeping the allocations */
+	void Reset()
+	{
+		Packets.Reset();
+		NumPacketsSent = 0;
+	}
+
+	/**
+	 * Calculates the total memory consumption of this FSendMulti instance, including platform-specific data
+	 *
+	 * @param Ar	The archive being used to count the memory consumption
+	 */
+	virtual void CountBytes(FArchive& Ar) const
+	{
+		Ar.CountBytes(sizeof(*this), sizeof(*this));
+		Packets.CountBytes(Ar);
+	}
+
+private:
+	/** The currently queued packets */
+	TArray<FSendData>				Packets;
+
+	/** The number of queued packets sent by the last SendMulti call */
+	int32							NumPacketsSent = 0;
+};
@@ -223,6 +223,33 @@ public:
 	 */
 	SOCKETS_API virtual bool RecvMulti(FRecvMulti& MultiData, ESocketReceiveFlags::Type Flags=ESocketReceiveFlags::None);
 
+	/**
+	 * Sends all packets queued in MultiData, using as few system calls as the platform allows (e.g. sendmmsg).
+	 * Use ISocketSubsystem::IsSocketSendMultiSupported to check if the current socket platform has a batched implementation,
+	 * otherwise this falls back to one SendTo call per packet.
+	 * Experimental: no platform has a batched implementation yet. @see FSendMulti
+	 * Packets are sent in queue order. On failure, MultiData.GetNumPacketsSent() tells how many packets were sent before the error.
+	 *
+	 * @param MultiData		The FSendMulti instance holding the queued packets and platform specific buffers for sending them.
+	 * @return				Whether or not all queued packets were sent
+	 */
+	virtual bool SendMulti(FSendMulti& MultiData)
+	{
+		int32 NumPacketsSent = 0;
+		for (; NumPacketsSent < MultiData.GetNumPackets(); ++NumPacketsSent)
+		{
+			const FSendMulti::FSendData& Packet = MultiData.GetPacket(NumPacketsSent);
+			int32 BytesSent = 0;
+			if (!SendTo(Packet.Data, Packet.Count, BytesSent, *Packet.Destination))
+			{
+				break;
+			}
+		}
+
+		MultiData.SetNumPacketsSent(NumPacketsSent);
+		return NumPacketsSent == MultiData.GetNumPackets();
+	}
+
 	/**
 	 * Blocks until the specified condition is met.
 	 *